@@ -0,0 +1,106 @@
+// AnimationLibrary.cpp
+#include "AnimationLibrary.hpp"
+#include "TextureManager.hpp"
+#include <iostream>
+
+size_t AnimationSet::frameCount() const {
+    return directed ? directions[static_cast<int>(Facing::Left)].size() : frames.size();
+}
+
+const sf::Texture* AnimationSet::frame(Facing facing, size_t index) const {
+    const std::vector<std::shared_ptr<sf::Texture>>& facingFrames = directions[static_cast<int>(facing)];
+    return index < facingFrames.size() ? facingFrames[index].get() : nullptr;
+}
+
+const sf::Texture* AnimationSet::frame(size_t index) const {
+    return index < frames.size() ? frames[index].get() : nullptr;
+}
+
+void AnimationSet::setUp(sf::Sprite& sprite) const {
+    const sf::Texture* first = directed ? frame(Facing::Left, 0) : frame(0);
+    if (first) {
+        sprite.setTexture(*first, true);
+    }
+    if (textureRect.width > 0 && textureRect.height > 0) {
+        sprite.setTextureRect(textureRect);
+    }
+    sprite.setOrigin(origin);
+    sprite.setScale(scale);
+}
+
+AnimationLibrary& AnimationLibrary::getInstance() {
+    static AnimationLibrary instance;
+    return instance;
+}
+
+AnimationLibrary::AnimationLibrary() {
+    loadSkeleton();
+    loadTank();
+    loadBullet();
+    loadExplosion();
+}
+
+const AnimationSet& AnimationLibrary::get(Archetype archetype) const {
+    return sets[static_cast<int>(archetype)];
+}
+
+std::vector<std::shared_ptr<sf::Texture>> AnimationLibrary::loadFrames(const std::string& prefix, int count) {
+    std::vector<std::shared_ptr<sf::Texture>> frames;
+    for (int i = 1; i <= count; ++i) {
+        std::string path = prefix + std::to_string(i) + ".png";
+        auto texture = TextureManager::getInstance().getTexture(path);
+        if (texture) {
+            frames.push_back(texture);
+        } else {
+            std::cerr << "Animation frame not loaded: " << path << std::endl;
+        }
+    }
+    return frames;
+}
+
+void AnimationLibrary::loadSkeleton() {
+    AnimationSet& set = sets[static_cast<int>(Archetype::Skeleton)];
+    set.directed = true;
+    for (int f = 0; f < FacingQuantizer::COUNT; ++f) {
+        std::string name = FacingQuantizer::name(static_cast<Facing>(f));
+        set.directions[f] = loadFrames("../assets/enemies/skeletons/" + name + "/skeleton_" + name + "_", 8);
+    }
+    set.frameDuration = 0.1f;
+    set.textureRect = sf::IntRect(96, 96, 64, 64);
+    set.origin = sf::Vector2f(32.0f, 32.0f);
+}
+
+void AnimationLibrary::loadTank() {
+    AnimationSet& set = sets[static_cast<int>(Archetype::Tank)];
+    set.directed = true;
+    for (int f = 0; f < FacingQuantizer::COUNT; ++f) {
+        std::string path = std::string("../assets/enemies/tank/tank_") + FacingQuantizer::name(static_cast<Facing>(f)) + ".png";
+        auto texture = TextureManager::getInstance().getTexture(path);
+        if (texture) {
+            set.directions[f] = {texture};
+        } else {
+            std::cerr << "Tank texture not loaded: " << path << std::endl;
+        }
+    }
+    // Drawn 64x64, anchored at the bottom centre
+    set.origin = sf::Vector2f(32.0f, 64.0f);
+    if (const sf::Texture* left = set.frame(Facing::Left, 0)) {
+        set.scale = sf::Vector2f(64.0f / left->getSize().x, 64.0f / left->getSize().y);
+    }
+}
+
+void AnimationLibrary::loadBullet() {
+    AnimationSet& set = sets[static_cast<int>(Archetype::Bullet)];
+    set.frames = loadFrames("../assets/bullets/Moontowerbullet/b", 7);
+    set.frameDuration = 0.1f;
+    if (!set.frames.empty()) {
+        set.origin = sf::Vector2f(set.frames[0]->getSize().x / 2.0f, set.frames[0]->getSize().y / 2.0f);
+    }
+}
+
+void AnimationLibrary::loadExplosion() {
+    AnimationSet& set = sets[static_cast<int>(Archetype::Explosion)];
+    set.frames = loadFrames("../assets/explosions/Explosion_1/Explosion_", 10);
+    set.frameDuration = 0.1f;
+    set.origin = sf::Vector2f(64.0f, 64.0f);
+}
@@ -0,0 +1,62 @@
+#ifndef ANIMATIONLIBRARY_HPP
+#define ANIMATIONLIBRARY_HPP
+
+#include <SFML/Graphics.hpp>
+#include <memory>
+#include <string>
+#include <vector>
+#include "Facing.hpp"
+
+enum class Archetype {
+    Skeleton,
+    Tank,
+    Bullet,
+    Explosion,
+    Count
+};
+
+// Frames and sprite setup shared by every entity of one archetype. Built once
+// by AnimationLibrary and never changed, so entities keep a pointer to it
+// instead of copies of its textures.
+struct AnimationSet {
+    // Frames per facing, for directed animations
+    std::vector<std::shared_ptr<sf::Texture>> directions[FacingQuantizer::COUNT];
+    std::vector<std::shared_ptr<sf::Texture>> frames; // Undirected animations
+    bool directed = false;
+    float frameDuration = 0.1f;
+    sf::Vector2f origin;
+    sf::Vector2f scale = sf::Vector2f(1.0f, 1.0f);
+    sf::IntRect textureRect; // Empty for the whole texture
+
+    // Number of frames of one facing, or of the undirected animation
+    size_t frameCount() const;
+    // Frame of the given facing, or nullptr if it was not loaded
+    const sf::Texture* frame(Facing facing, size_t index) const;
+    const sf::Texture* frame(size_t index) const;
+    // Applies origin, scale and texture rect with the first frame
+    void setUp(sf::Sprite& sprite) const;
+};
+
+// Loads every archetype's frames on first use. Spawning then costs a pointer
+// lookup instead of building paths and querying TextureManager per frame.
+class AnimationLibrary {
+public:
+    static AnimationLibrary& getInstance();
+
+    const AnimationSet& get(Archetype archetype) const;
+
+private:
+    AnimationLibrary();
+    AnimationLibrary(const AnimationLibrary&) = delete;
+    AnimationLibrary& operator=(const AnimationLibrary&) = delete;
+
+    AnimationSet sets[static_cast<int>(Archetype::Count)];
+
+    static std::vector<std::shared_ptr<sf::Texture>> loadFrames(const std::string& prefix, int count);
+    void loadSkeleton();
+    void loadTank();
+    void loadBullet();
+    void loadExplosion();
+};
+
+#endif // ANIMATIONLIBRARY_HPP
@@ -1,5 +1,4 @@
 #include "Bullet.hpp"
-#include "TextureManager.hpp"
 #include <iostream>
 #include <cmath>
 
@@ -9,22 +8,10 @@ Bullet::Bullet(sf::Vector2f startPosition, sf::Vector2f targetPosition, float sp
    targetPosition(targetPosition),
    active(true),
    stoppingThreshold(5.0f), // stoppingThreshold might be removed if not used
+   animation(&AnimationLibrary::getInstance().get(Archetype::Bullet)),
    currentFrame(0),
    animationTime(0.0f) {
-    // Load each frame via TextureManager
-    for (int i = 1; i <= 7; ++i) {
-        std::string path = "../assets/bullets/Moontowerbullet/b" + std::to_string(i) + ".png";
-        auto texture = TextureManager::getInstance().getTexture(path);
-        if (texture) {
-            textures.push_back(texture);
-        } else {
-            std::cerr << "Failed to load bullet frame: " << path << std::endl;
-        }
-    }
-    if (!textures.empty()) {
-        sprite.setTexture(*textures[currentFrame]);
-        sprite.setOrigin(textures[currentFrame]->getSize().x / 2.0f, textures[currentFrame]->getSize().y / 2.0f);
-    }
+    animation->setUp(sprite);
     sprite.setPosition(position);
 
     // Calculate direction only if length is not zero to avoid division by zero
@@ -43,7 +30,7 @@ Bullet::Bullet(Bullet&& other) noexcept
       sprite(std::move(other.sprite)),
       active(other.active),
       stoppingThreshold(other.stoppingThreshold),
-      textures(std::move(other.textures)),
+      animation(other.animation),
       currentFrame(other.currentFrame),
       animationTime(other.animationTime) {
     other.active = false;
@@ -58,7 +45,7 @@ Bullet& Bullet::operator=(Bullet&& other) noexcept {
         sprite = std::move(other.sprite);
         active = other.active;
         stoppingThreshold = other.stoppingThreshold;
-        textures = std::move(other.textures);
+        animation = other.animation;
         currentFrame = other.currentFrame;
         animationTime = other.animationTime;
         other.active = false;
@@ -72,10 +59,10 @@ void Bullet::update(float deltaTime) {
         sprite.setPosition(position);
         // Animate the bullet
         animationTime += deltaTime;
-        if (animationTime >= frameDuration) {
+        if (animationTime >= animation->frameDuration && animation->frameCount() > 0) {
             animationTime = 0.0f;
-            currentFrame = (currentFrame + 1) % textures.size();
-            sprite.setTexture(*textures[currentFrame]); // Update sprite texture
+            currentFrame = (currentFrame + 1) % animation->frameCount();
+            sprite.setTexture(*animation->frame(currentFrame)); // Update sprite texture
         }
         // Removed the stoppingThreshold logic
     }
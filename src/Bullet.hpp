@@ -2,8 +2,7 @@
 #define BULLET_HPP
 
 #include <SFML/Graphics.hpp>
-#include <vector>
-#include <memory>
+#include "AnimationLibrary.hpp"
 
 class Bullet {
 public:
@@ -24,10 +23,9 @@ private:
     sf::Sprite sprite;
     bool active;
     float stoppingThreshold = 5.0f;
-    std::vector<std::shared_ptr<sf::Texture>> textures; // Separate textures for each frame
+    const AnimationSet* animation; // Shared by every bullet
     size_t currentFrame;
     float animationTime;
-    const float frameDuration = 0.1f; // Adjust as needed
 };
 
 #endif // BULLET_HPP
\ No newline at end of file
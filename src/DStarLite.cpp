@@ -0,0 +1,324 @@
+// DStarLite.cpp
+#include "DStarLite.hpp"
+#include "GridConnectivity.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+
+static const float UNREACHABLE = std::numeric_limits<float>::infinity();
+
+constexpr float DStarLite::DEFAULT_WALL_COST_PER_HEALTH;
+
+DStarLite::DStarLite()
+    : wallCostPerHealth(DEFAULT_WALL_COST_PER_HEALTH), lastStart(-1), lastExpansions(0) {}
+
+void DStarLite::setWallCostPerHealth(float cost) {
+    wallCostPerHealth = std::max(0.0f, cost);
+}
+
+float DStarLite::getWallCostPerHealth() const {
+    return wallCostPerHealth;
+}
+
+size_t DStarLite::getLastExpansions() const {
+    return lastExpansions;
+}
+
+// Extra cost of stepping onto index on top of the move itself
+float DStarLite::tileCost(const TileGrid& grid, int index) const {
+    if (goal[index] || !grid.isBlocked(index)) {
+        return 0.0f;
+    }
+    if (grid.getType(index) != TileType::Wall) {
+        return UNREACHABLE;
+    }
+    return static_cast<float>(std::max(0, grid.getHealth(index))) * wallCostPerHealth;
+}
+
+// Same rules as FlowField::stepCost, with the wall cost taken from enterCost
+float DStarLite::stepCost(const TileGrid& grid, int from, int to) const {
+    if (grid.isBlocked(from) && grid.getType(from) != TileType::Wall) {
+        return UNREACHABLE;
+    }
+    float cost = 1.0f + enterCost[to];
+    const int fromRow = grid.rowOf(from);
+    const int fromCol = grid.colOf(from);
+    const int toRow = grid.rowOf(to);
+    const int toCol = grid.colOf(to);
+    if (fromRow != toRow && fromCol != toCol) {
+        if (grid.isBlocked(grid.index(fromRow, toCol)) || grid.isBlocked(grid.index(toRow, fromCol))) {
+            return UNREACHABLE;
+        }
+        cost += DIAGONAL_STEP_COST - 1.0f;
+    }
+    return cost;
+}
+
+// Octile distance; every step costs at least its length, so it never overestimates
+float DStarLite::heuristic(const TileGrid& grid, int from, int to) const {
+    if (from < 0) {
+        return 0.0f;
+    }
+    const int dRow = std::abs(grid.rowOf(from) - grid.rowOf(to));
+    const int dCol = std::abs(grid.colOf(from) - grid.colOf(to));
+    return static_cast<float>(dRow + dCol) + (DIAGONAL_STEP_COST - 2.0f) * static_cast<float>(std::min(dRow, dCol));
+}
+
+DStarLite::Key DStarLite::calculateKey(const TileGrid& grid, int node, int start) const {
+    const float best = std::min(g[node], rhs[node]);
+    return Key{best + heuristic(grid, start, node), best};
+}
+
+// Lowest step cost plus g over the neighbors of node
+float DStarLite::bestSuccessor(const TileGrid& grid, int node, int* successor) const {
+    float best = UNREACHABLE;
+    int bestNode = -1;
+    forEachNeighbor<MapConnectivity>(grid, node, [&](int neighbor, int) {
+        if (g[neighbor] == UNREACHABLE) {
+            return;
+        }
+        const float candidate = stepCost(grid, node, neighbor) + g[neighbor];
+        if (candidate < best) {
+            best = candidate;
+            bestNode = neighbor;
+        }
+    });
+    if (successor) {
+        *successor = bestNode;
+    }
+    return best;
+}
+
+void DStarLite::updateVertex(const TileGrid& grid, int node, int start) {
+    const bool queued = heapIndex[node] >= 0;
+    if (g[node] != rhs[node]) {
+        if (queued) {
+            update(node, calculateKey(grid, node, start));
+        } else {
+            push(node, calculateKey(grid, node, start));
+        }
+    } else if (queued) {
+        remove(node);
+    }
+}
+
+void DStarLite::build(const TileGrid& grid, const std::vector<int>& goalTiles) {
+    const size_t nodeCount = static_cast<size_t>(grid.size());
+    g.assign(nodeCount, UNREACHABLE);
+    rhs.assign(nodeCount, UNREACHABLE);
+    goal.assign(nodeCount, 0);
+    heapIndex.assign(nodeCount, -1);
+    heap.clear();
+    lastStart = -1;
+    lastExpansions = 0;
+
+    for (int tile : goalTiles) {
+        goal[tile] = 1;
+    }
+    enterCost.resize(nodeCount);
+    for (int index = 0; index < grid.size(); ++index) {
+        enterCost[index] = tileCost(grid, index);
+    }
+    for (int tile : goalTiles) {
+        if (rhs[tile] != 0.0f) {
+            rhs[tile] = 0.0f;
+            push(tile, calculateKey(grid, tile, lastStart));
+        }
+    }
+}
+
+void DStarLite::applyChanges(const TileGrid& grid, const std::vector<int>& changedTiles) {
+    if (g.size() != static_cast<size_t>(grid.size())) {
+        return; // Not built for this grid yet
+    }
+    for (int tile : changedTiles) {
+        enterCost[tile] = tileCost(grid, tile);
+        // Edges out of the tile, into it, and diagonals that pass its corner all
+        // start at the tile or one of its neighbors
+        auto refresh = [&](int node) {
+            if (!goal[node]) {
+                rhs[node] = bestSuccessor(grid, node, nullptr);
+                updateVertex(grid, node, lastStart);
+            }
+        };
+        refresh(tile);
+        forEachNeighbor<MapConnectivity>(grid, tile, [&](int neighbor, int) { refresh(neighbor); });
+    }
+}
+
+// Expands until target is consistent and nothing queued sorts before it;
+// with target = start that is the usual D* Lite stopping rule. A target of
+// -1 empties the queue, leaving every g exact.
+void DStarLite::computeShortestPath(const TileGrid& grid, int start, int target) {
+    while (!heap.empty() &&
+           (target < 0 || heap[0].key < calculateKey(grid, target, start) || rhs[target] != g[target])) {
+        const int node = heap[0].node;
+        const Key oldKey = heap[0].key;
+        const Key newKey = calculateKey(grid, node, start);
+        ++lastExpansions;
+        if (oldKey < newKey) {
+            update(node, newKey);
+        } else if (g[node] > rhs[node]) {
+            // Cost went down: settle it and offer it to the predecessors
+            g[node] = rhs[node];
+            remove(node);
+            forEachNeighbor<MapConnectivity>(grid, node, [&](int predecessor, int) {
+                if (goal[predecessor]) {
+                    return;
+                }
+                const float candidate = stepCost(grid, predecessor, node) + g[node];
+                if (candidate < rhs[predecessor]) {
+                    rhs[predecessor] = candidate;
+                    updateVertex(grid, predecessor, start);
+                }
+            });
+        } else {
+            // Cost went up: predecessors that relied on it look for another route
+            const float oldG = g[node];
+            g[node] = UNREACHABLE;
+            forEachNeighbor<MapConnectivity>(grid, node, [&](int predecessor, int) {
+                if (goal[predecessor] || rhs[predecessor] != stepCost(grid, predecessor, node) + oldG) {
+                    return;
+                }
+                rhs[predecessor] = bestSuccessor(grid, predecessor, nullptr);
+                updateVertex(grid, predecessor, start);
+            });
+            updateVertex(grid, node, start);
+        }
+    }
+}
+
+// Queued keys hold the heuristic toward the start they were computed for.
+// Instead of a km term that drifts in float with every move, recompute them
+// for the new start and restore the heap order in one pass.
+void DStarLite::rekey(const TileGrid& grid, int start) {
+    for (HeapEntry& entry : heap) {
+        entry.key = calculateKey(grid, entry.node, start);
+    }
+    for (int slot = static_cast<int>(heap.size()) / 2 - 1; slot >= 0; --slot) {
+        siftDown(slot);
+    }
+}
+
+bool DStarLite::isSettled(int node) const {
+    return heapIndex[node] < 0 && g[node] == rhs[node];
+}
+
+// Follows the cheapest successor from start. Returns -1 once it reaches a
+// goal over settled nodes only, otherwise the node where it had to stop:
+// one still queued, or a dead end or loop in the current g values.
+int DStarLite::tracePath(const TileGrid& grid, int start, std::vector<int>& path) const {
+    path.clear();
+    path.push_back(start);
+    int current = start;
+    while (!goal[current]) {
+        int next = -1;
+        bestSuccessor(grid, current, &next);
+        if (!isSettled(current) || next < 0 || path.size() > g.size()) {
+            return current;
+        }
+        path.push_back(next);
+        current = next;
+    }
+    return -1;
+}
+
+bool DStarLite::findPath(const TileGrid& grid, int start, std::vector<int>& path) {
+    path.clear();
+    lastExpansions = 0;
+    if (g.size() != static_cast<size_t>(grid.size())) {
+        return false;
+    }
+    if (start != lastStart) {
+        rekey(grid, start);
+        lastStart = start;
+    }
+    computeShortestPath(grid, start, start);
+    if (rhs[start] == UNREACHABLE) {
+        return false;
+    }
+    // The stopping rule settles start, but nodes further along the route can
+    // still be queued with keys tied with start's. Settle each one the walk
+    // runs into and walk again; should the settled values ever lead nowhere,
+    // finish the search outright, which makes every g exact.
+    for (int stuck = tracePath(grid, start, path); stuck >= 0; stuck = tracePath(grid, start, path)) {
+        if (heap.empty()) {
+            path.clear();
+            return false;
+        }
+        computeShortestPath(grid, start, isSettled(stuck) ? -1 : stuck);
+    }
+    return true;
+}
+
+void DStarLite::push(int node, Key key) {
+    heap.push_back(HeapEntry{key, node});
+    heapIndex[node] = static_cast<int>(heap.size()) - 1;
+    siftUp(heapIndex[node]);
+}
+
+void DStarLite::remove(int node) {
+    const int slot = heapIndex[node];
+    heapIndex[node] = -1;
+    const int lastSlot = static_cast<int>(heap.size()) - 1;
+    if (slot != lastSlot) {
+        const int moved = heap[lastSlot].node;
+        heap[slot] = heap[lastSlot];
+        heapIndex[moved] = slot;
+        heap.pop_back();
+        siftUp(slot);
+        if (heapIndex[moved] == slot) {
+            siftDown(slot);
+        }
+    } else {
+        heap.pop_back();
+    }
+}
+
+void DStarLite::update(int node, Key key) {
+    const int slot = heapIndex[node];
+    const bool lower = key < heap[slot].key;
+    heap[slot].key = key;
+    if (lower) {
+        siftUp(slot);
+    } else {
+        siftDown(slot);
+    }
+}
+
+void DStarLite::siftUp(int slot) {
+    HeapEntry entry = heap[slot];
+    while (slot > 0) {
+        const int parentSlot = (slot - 1) / 2;
+        if (!(entry.key < heap[parentSlot].key)) {
+            break;
+        }
+        heap[slot] = heap[parentSlot];
+        heapIndex[heap[slot].node] = slot;
+        slot = parentSlot;
+    }
+    heap[slot] = entry;
+    heapIndex[entry.node] = slot;
+}
+
+void DStarLite::siftDown(int slot) {
+    const int count = static_cast<int>(heap.size());
+    HeapEntry entry = heap[slot];
+    while (true) {
+        int child = 2 * slot + 1;
+        if (child >= count) {
+            break;
+        }
+        if (child + 1 < count && heap[child + 1].key < heap[child].key) {
+            ++child;
+        }
+        if (!(heap[child].key < entry.key)) {
+            break;
+        }
+        heap[slot] = heap[child];
+        heapIndex[heap[slot].node] = slot;
+        slot = child;
+    }
+    heap[slot] = entry;
+    heapIndex[entry.node] = slot;
+}
@@ -0,0 +1,85 @@
+#ifndef DSTARLITE_HPP
+#define DSTARLITE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "TileGrid.hpp"
+
+// D* Lite toward a set of goal tiles (e.g. the town hall). The search runs
+// backward from the goals and keeps its g/rhs values and open list between
+// queries, so when tiles change only the nodes made inconsistent by the new
+// edge costs are repaired, and a query from a new start continues the existing
+// tree instead of starting over.
+//
+// Walls are traversable at a cost proportional to their remaining health
+// (wallCostPerHealth per point), so a unit that can breach walls heads for
+// the cheapest breach rather than the nearest wall. Other blocked tiles are
+// impassable unless they are goals. Moves are eight-way without corner
+// cutting, as in GridAStar.
+class DStarLite {
+public:
+    // 100-health walls cost as much as FlowField::WALL_COST
+    static constexpr float DEFAULT_WALL_COST_PER_HEALTH = 0.2f;
+
+    DStarLite();
+
+    // Changing the cost per health point takes effect on the next build()
+    void setWallCostPerHealth(float cost);
+    float getWallCostPerHealth() const;
+
+    // Discards the search tree and starts over toward goalTiles
+    void build(const TileGrid& grid, const std::vector<int>& goalTiles);
+    // Updates the edge costs around the given tiles (block status, type or
+    // wall health changed); the tree is repaired lazily by the next findPath
+    void applyChanges(const TileGrid& grid, const std::vector<int>& changedTiles);
+
+    // Cheapest route from start to a goal, walls included. Returns false and
+    // leaves path empty if no goal can be reached from start.
+    bool findPath(const TileGrid& grid, int start, std::vector<int>& path);
+
+    // Nodes expanded by the last findPath
+    size_t getLastExpansions() const;
+
+private:
+    struct Key {
+        float primary;
+        float secondary;
+        bool operator<(const Key& other) const {
+            return primary < other.primary || (primary == other.primary && secondary < other.secondary);
+        }
+    };
+    struct HeapEntry {
+        Key key;
+        int node;
+    };
+
+    float wallCostPerHealth;
+    std::vector<float> g;
+    std::vector<float> rhs;
+    std::vector<float> enterCost; // Cost of stepping onto a tile; infinite if impassable
+    std::vector<std::uint8_t> goal;
+    std::vector<int> heapIndex; // Slot in heap, or -1
+    std::vector<HeapEntry> heap;
+    int lastStart;
+    size_t lastExpansions;
+
+    float tileCost(const TileGrid& grid, int index) const;
+    float stepCost(const TileGrid& grid, int from, int to) const;
+    float heuristic(const TileGrid& grid, int from, int to) const;
+    Key calculateKey(const TileGrid& grid, int node, int start) const;
+    float bestSuccessor(const TileGrid& grid, int node, int* successor) const;
+    void updateVertex(const TileGrid& grid, int node, int start);
+    void computeShortestPath(const TileGrid& grid, int start, int target);
+    void rekey(const TileGrid& grid, int start);
+    bool isSettled(int node) const;
+    int tracePath(const TileGrid& grid, int start, std::vector<int>& path) const;
+
+    void push(int node, Key key);
+    void remove(int node);
+    void update(int node, Key key);
+    void siftUp(int slot);
+    void siftDown(int slot);
+};
+
+#endif // DSTARLITE_HPP
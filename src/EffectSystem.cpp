@@ -0,0 +1,60 @@
+// EffectSystem.cpp
+#include "EffectSystem.hpp"
+
+EffectSystem::EffectSystem(int capacity)
+    : explosion(AnimationLibrary::getInstance().get(Archetype::Explosion)), capacity(capacity) {
+    explosion.setUp(explosionSprite);
+    posX.reserve(capacity);
+    posY.reserve(capacity);
+    frameTime.reserve(capacity);
+    frame.reserve(capacity);
+}
+
+void EffectSystem::spawnExplosion(float x, float y) {
+    if (size() >= capacity) {
+        return;
+    }
+    posX.push_back(x);
+    posY.push_back(y);
+    frameTime.push_back(0.0f);
+    frame.push_back(0);
+}
+
+void EffectSystem::update(float deltaTime) {
+    const size_t frameCount = explosion.frameCount();
+    int index = 0;
+    while (index < size()) {
+        frameTime[index] += deltaTime;
+        if (frameTime[index] >= explosion.frameDuration) {
+            frameTime[index] = 0.0f;
+            frame[index]++;
+        }
+        if (frame[index] >= frameCount) {
+            removeAt(index); // Stop after the last frame
+        } else {
+            ++index;
+        }
+    }
+}
+
+void EffectSystem::draw(sf::RenderWindow& window) {
+    for (int index = 0; index < size(); ++index) {
+        if (const sf::Texture* texture = explosion.frame(frame[index])) {
+            explosionSprite.setTexture(*texture);
+            explosionSprite.setPosition(posX[index], posY[index]);
+            window.draw(explosionSprite);
+        }
+    }
+}
+
+void EffectSystem::removeAt(int index) {
+    const int last = size() - 1;
+    posX[index] = posX[last];
+    posY[index] = posY[last];
+    frameTime[index] = frameTime[last];
+    frame[index] = frame[last];
+    posX.pop_back();
+    posY.pop_back();
+    frameTime.pop_back();
+    frame.pop_back();
+}
@@ -0,0 +1,39 @@
+#ifndef EFFECTSYSTEM_HPP
+#define EFFECTSYSTEM_HPP
+
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <vector>
+#include "AnimationLibrary.hpp"
+
+// One-shot visual effects that outlive the entity that caused them, such as
+// the explosion a tank leaves when it dies. The tank's unit slot is freed at
+// once and the explosion plays here. Effects are kept in a fixed-capacity
+// dense pool; a finished effect is swapped out with the last one.
+class EffectSystem {
+public:
+    static const int DEFAULT_CAPACITY = 256;
+
+    explicit EffectSystem(int capacity = DEFAULT_CAPACITY);
+
+    // Dropped if the pool is full
+    void spawnExplosion(float x, float y);
+    void update(float deltaTime);
+    void draw(sf::RenderWindow& window);
+
+    int size() const { return static_cast<int>(posX.size()); }
+
+private:
+    const AnimationSet& explosion;
+    sf::Sprite explosionSprite;
+    int capacity;
+
+    std::vector<float> posX;
+    std::vector<float> posY;
+    std::vector<float> frameTime; // Time on the current frame
+    std::vector<std::uint8_t> frame;
+
+    void removeAt(int index);
+};
+
+#endif // EFFECTSYSTEM_HPP
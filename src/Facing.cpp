@@ -0,0 +1,49 @@
+// Facing.cpp
+#include "Facing.hpp"
+#include <cmath>
+
+// tan(22.5 degrees): below it a heading counts as straight along the axis
+static const float OCTANT_SLOPE = 0.41421356f;
+static const std::uint8_t STILL = 0xFF;
+
+// Indexed by left | up << 1 | horizontal << 2 | vertical << 3; both axis bits
+// are only set for a zero velocity
+static const std::uint8_t OCTANTS[16] = {
+    static_cast<std::uint8_t>(Facing::DownRight), static_cast<std::uint8_t>(Facing::DownLeft),
+    static_cast<std::uint8_t>(Facing::UpRight), static_cast<std::uint8_t>(Facing::UpLeft),
+    static_cast<std::uint8_t>(Facing::Right), static_cast<std::uint8_t>(Facing::Left),
+    static_cast<std::uint8_t>(Facing::Right), static_cast<std::uint8_t>(Facing::Left),
+    static_cast<std::uint8_t>(Facing::Down), static_cast<std::uint8_t>(Facing::Down),
+    static_cast<std::uint8_t>(Facing::Up), static_cast<std::uint8_t>(Facing::Up),
+    STILL, STILL, STILL, STILL
+};
+
+static inline std::uint8_t quantize(float dx, float dy, std::uint8_t previous) {
+    const float ax = std::fabs(dx);
+    const float ay = std::fabs(dy);
+    const unsigned index = static_cast<unsigned>(dx < 0.0f)
+                         | static_cast<unsigned>(dy < 0.0f) << 1
+                         | static_cast<unsigned>(ay <= ax * OCTANT_SLOPE) << 2
+                         | static_cast<unsigned>(ax <= ay * OCTANT_SLOPE) << 3;
+    const std::uint8_t octant = OCTANTS[index];
+    const std::uint8_t keep = static_cast<std::uint8_t>(-static_cast<int>(octant == STILL));
+    return static_cast<std::uint8_t>((previous & keep) | (octant & ~keep));
+}
+
+Facing FacingQuantizer::fromVelocity(float dx, float dy, Facing previous) {
+    return static_cast<Facing>(quantize(dx, dy, static_cast<std::uint8_t>(previous)));
+}
+
+void FacingQuantizer::update(const float* velX, const float* velY, Facing* facing, int count) {
+    std::uint8_t* out = reinterpret_cast<std::uint8_t*>(facing);
+    for (int i = 0; i < count; ++i) {
+        out[i] = quantize(velX[i], velY[i], out[i]);
+    }
+}
+
+const char* FacingQuantizer::name(Facing facing) {
+    static const char* const NAMES[COUNT] = {
+        "right", "down_right", "down", "down_left", "left", "up_left", "up", "up_right"
+    };
+    return NAMES[static_cast<int>(facing)];
+}
@@ -0,0 +1,34 @@
+#ifndef FACING_HPP
+#define FACING_HPP
+
+#include <cstdint>
+
+// One of the eight directions a unit sprite can face, in screen space (y
+// points down), clockwise from right
+enum class Facing : std::uint8_t {
+    Right,
+    DownRight,
+    Down,
+    DownLeft,
+    Left,
+    UpLeft,
+    Up,
+    UpRight
+};
+
+// Turns velocities into facings without branching: the signs of the
+// components and whether the heading lies within 22.5 degrees of an axis
+// form a four bit index into a table of octants. A unit standing still
+// keeps its previous facing.
+class FacingQuantizer {
+public:
+    static const int COUNT = 8;
+
+    static Facing fromVelocity(float dx, float dy, Facing previous);
+    // Updates facing[i] from (velX[i], velY[i]) for count units
+    static void update(const float* velX, const float* velY, Facing* facing, int count);
+    // Asset name of the facing ("up_left", ...)
+    static const char* name(Facing facing);
+};
+
+#endif // FACING_HPP
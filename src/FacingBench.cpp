@@ -0,0 +1,169 @@
+// FacingBench.cpp
+// Headless microbenchmark for picking a unit's sprite frame from its
+// velocity. Compares the string-keyed lookup the units used to do (build a
+// direction name, find it in a std::map of frame vectors) with the batched
+// octant quantization of FacingQuantizer indexing a fixed array of frames.
+// Reports units/sec for both as JSON (or a table with --table).
+// Build and run with `make facing-bench`. Options:
+//   --units N     units per frame (default 20000)
+//   --frames N    frames to time (default 500)
+//   --seed S      velocity seed (default 1234)
+//   --table       human readable output instead of JSON
+#include "Facing.hpp"
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+static const int FRAMES_PER_FACING = 8;
+
+// The frame "textures" are just distinct addresses
+static int frameStorage[FacingQuantizer::COUNT][FRAMES_PER_FACING];
+
+struct Velocities {
+    std::vector<float> x;
+    std::vector<float> y;
+};
+
+// Mostly diagonal headings, with some exactly on an axis and some standing
+// still, like a wave walking a smoothed path
+static Velocities makeVelocities(int units, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> component(-100.0f, 100.0f);
+    std::uniform_int_distribution<int> kind(0, 9);
+    Velocities velocities;
+    for (int i = 0; i < units; ++i) {
+        float x = component(rng);
+        float y = component(rng);
+        const int k = kind(rng);
+        if (k == 0) {
+            x = 0.0f;
+        } else if (k == 1) {
+            y = 0.0f;
+        } else if (k == 2) {
+            x = y = 0.0f;
+        }
+        velocities.x.push_back(x);
+        velocities.y.push_back(y);
+    }
+    return velocities;
+}
+
+// The direction key as the units used to build it: straight only on an exact axis
+static std::string directionKey(float dx, float dy) {
+    std::string direction;
+    if (dx == 0 && dy < 0) direction = "up";
+    else if (dx == 0 && dy > 0) direction = "down";
+    else if (dy == 0 && dx < 0) direction = "left";
+    else if (dy == 0 && dx > 0) direction = "right";
+    else if (dx > 0 && dy < 0) direction = "up_right";
+    else if (dx < 0 && dy < 0) direction = "up_left";
+    else if (dx > 0 && dy > 0) direction = "down_right";
+    else if (dx < 0 && dy > 0) direction = "down_left";
+    else direction = "left";
+    return direction;
+}
+
+static double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+static double runStringKeyed(const Velocities& velocities, int frames, unsigned long& checksum) {
+    std::map<std::string, std::vector<const int*>> directionTextures;
+    for (int f = 0; f < FacingQuantizer::COUNT; ++f) {
+        std::vector<const int*>& textures = directionTextures[FacingQuantizer::name(static_cast<Facing>(f))];
+        for (int i = 0; i < FRAMES_PER_FACING; ++i) {
+            textures.push_back(&frameStorage[f][i]);
+        }
+    }
+    const int units = static_cast<int>(velocities.x.size());
+    const auto start = std::chrono::steady_clock::now();
+    for (int frame = 0; frame < frames; ++frame) {
+        const int animationFrame = frame % FRAMES_PER_FACING;
+        for (int i = 0; i < units; ++i) {
+            auto it = directionTextures.find(directionKey(velocities.x[i], velocities.y[i]));
+            if (it != directionTextures.end()) {
+                checksum += reinterpret_cast<std::uintptr_t>(it->second[animationFrame]);
+            }
+        }
+    }
+    return secondsSince(start);
+}
+
+static double runQuantized(const Velocities& velocities, int frames, unsigned long& checksum) {
+    const int* directions[FacingQuantizer::COUNT][FRAMES_PER_FACING];
+    for (int f = 0; f < FacingQuantizer::COUNT; ++f) {
+        for (int i = 0; i < FRAMES_PER_FACING; ++i) {
+            directions[f][i] = &frameStorage[f][i];
+        }
+    }
+    const int units = static_cast<int>(velocities.x.size());
+    std::vector<Facing> facing(units, Facing::Left);
+    const auto start = std::chrono::steady_clock::now();
+    for (int frame = 0; frame < frames; ++frame) {
+        const int animationFrame = frame % FRAMES_PER_FACING;
+        FacingQuantizer::update(velocities.x.data(), velocities.y.data(), facing.data(), units);
+        for (int i = 0; i < units; ++i) {
+            checksum += reinterpret_cast<std::uintptr_t>(directions[static_cast<int>(facing[i])][animationFrame]);
+        }
+    }
+    return secondsSince(start);
+}
+
+static void printUsage() {
+    std::fprintf(stderr, "usage: facingbench [--units N] [--frames N] [--seed S] [--table]\n");
+}
+
+int main(int argc, char** argv) {
+    int units = 20000;
+    int frames = 500;
+    unsigned seed = 1234u;
+    bool table = false;
+    for (int i = 1; i < argc; ++i) {
+        const std::string option = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (option == "--table") {
+            table = true;
+        } else if (option == "--units" && hasValue) {
+            units = std::atoi(argv[++i]);
+        } else if (option == "--frames" && hasValue) {
+            frames = std::atoi(argv[++i]);
+        } else if (option == "--seed" && hasValue) {
+            seed = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+        } else {
+            printUsage();
+            return 1;
+        }
+    }
+    if (units <= 0 || frames <= 0) {
+        std::fprintf(stderr, "Units and frames must be positive.\n");
+        return 1;
+    }
+
+    const Velocities velocities = makeVelocities(units, seed);
+    unsigned long checksum = 0;
+    const double stringSeconds = runStringKeyed(velocities, frames, checksum);
+    const double quantizedSeconds = runQuantized(velocities, frames, checksum);
+    const double updates = static_cast<double>(units) * frames;
+    const double stringRate = updates / stringSeconds;
+    const double quantizedRate = updates / quantizedSeconds;
+
+    if (table) {
+        std::printf("%-10s %12s %14s\n", "lookup", "ns/unit", "units/s");
+        std::printf("%-10s %12.2f %14.0f\n", "string", 1e9 / stringRate, stringRate);
+        std::printf("%-10s %12.2f %14.0f\n", "octant", 1e9 / quantizedRate, quantizedRate);
+        std::printf("speedup %.1fx (checksum %lu)\n", quantizedRate / stringRate, checksum);
+    } else {
+        std::printf("{\n  \"benchmark\": \"facing\",\n  \"format\": 1,\n  \"seed\": %u,\n  \"units\": %d,\n"
+                    "  \"frames\": %d,\n  \"results\": [\n"
+                    "    {\"lookup\": \"string\", \"units_per_sec\": %.1f},\n"
+                    "    {\"lookup\": \"octant\", \"units_per_sec\": %.1f}\n  ],\n"
+                    "  \"speedup\": %.2f,\n  \"checksum\": %lu\n}\n",
+                    seed, units, frames, stringRate, quantizedRate, quantizedRate / stringRate, checksum);
+    }
+    return 0;
+}
@@ -0,0 +1,228 @@
+// FlowField.cpp
+#include "FlowField.hpp"
+#include "GridAStar.hpp"
+#include "GridConnectivity.hpp"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+
+static const float UNREACHABLE = std::numeric_limits<float>::infinity();
+
+constexpr float FlowField::WALL_COST;
+
+FlowField::FlowField() {}
+
+bool FlowField::isReachable(int index) const {
+    return distance[index] != UNREACHABLE;
+}
+
+float FlowField::getDistance(int index) const {
+    return distance[index];
+}
+
+bool FlowField::isGoal(int index) const {
+    return goal[index] != 0;
+}
+
+int FlowField::getNextStep(int index) const {
+    return next[index];
+}
+
+// Cost for a unit on `from` to step onto the neighboring tile `to`
+float FlowField::stepCost(const TileGrid& grid, int from, int to) const {
+    if (grid.isBlocked(from) && grid.getType(from) != TileType::Wall) {
+        return UNREACHABLE;
+    }
+    float cost = 1.0f;
+    if (!goal[to] && grid.isBlocked(to)) {
+        if (grid.getType(to) != TileType::Wall) {
+            return UNREACHABLE;
+        }
+        cost += WALL_COST;
+    }
+    const int fromRow = grid.rowOf(from);
+    const int fromCol = grid.colOf(from);
+    const int toRow = grid.rowOf(to);
+    const int toCol = grid.colOf(to);
+    if (fromRow != toRow && fromCol != toCol) {
+        // Same corner rule as GridAStar: both orthogonal tiles must be open
+        if (grid.isBlocked(grid.index(fromRow, toCol)) || grid.isBlocked(grid.index(toRow, fromCol))) {
+            return UNREACHABLE;
+        }
+        cost += DIAGONAL_STEP_COST - 1.0f;
+    }
+    return cost;
+}
+
+// The search runs from the goals outward, so its step from `from` to `to` is
+// a unit stepping from `to` onto `from`. Goals stay at distance zero.
+struct FlowField::BackwardStepCost {
+    const FlowField& field;
+
+    float operator()(const TileGrid& grid, int from, int to, int, int) const {
+        if (field.goal[to]) {
+            return -1.0f;
+        }
+        const float cost = field.stepCost(grid, to, from);
+        return cost == UNREACHABLE ? -1.0f : cost;
+    }
+    bool canLeave(const TileGrid&, int) const { return true; }
+};
+
+void FlowField::pushOpen(float dist, int index) {
+    open.emplace_back(dist, index);
+    std::push_heap(open.begin(), open.end(), std::greater<std::pair<float, int>>());
+}
+
+void FlowField::propagate(const TileGrid& grid) {
+    while (!open.empty()) {
+        std::pop_heap(open.begin(), open.end(), std::greater<std::pair<float, int>>());
+        const float dist = open.back().first;
+        const int current = open.back().second;
+        open.pop_back();
+        if (dist > distance[current]) {
+            continue; // Stale entry
+        }
+        forEachNeighbor<MapConnectivity>(grid, current, [&](int neighbor, int) {
+            if (goal[neighbor]) {
+                return;
+            }
+            const float candidate = dist + stepCost(grid, neighbor, current);
+            if (candidate < distance[neighbor]) {
+                distance[neighbor] = candidate;
+                next[neighbor] = current;
+                pushOpen(candidate, neighbor);
+            }
+        });
+    }
+}
+
+void FlowField::build(const TileGrid& grid, const std::vector<int>& goalTiles) {
+    const int count = grid.size();
+    distance.assign(count, UNREACHABLE);
+    next.assign(count, -1);
+    goal.assign(count, 0);
+    invalid.assign(count, 0);
+    open.clear();
+    for (int goalTile : goalTiles) {
+        goal[goalTile] = 1;
+    }
+    // Dijkstra from every goal at once; the search parent is the next step
+    const BackwardStepCost cost{*this};
+    startGridSearch(grid, search, goalTiles, cost, ZeroHeuristic());
+    runGridSearch<MapConnectivity>(grid, search, cost, ZeroHeuristic(), TileGoal{-1}, static_cast<size_t>(-1));
+    for (int tile = 0; tile < count; ++tile) {
+        if (search.isReached(tile)) {
+            distance[tile] = search.getCost(tile);
+            next[tile] = search.getParent(tile);
+        }
+    }
+}
+
+// A tile is consistent if its stored step is still allowed and still accounts
+// for its distance. Unreachable tiles have nothing to invalidate.
+bool FlowField::isConsistent(const TileGrid& grid, int index) const {
+    if (goal[index] || (next[index] == -1 && distance[index] == UNREACHABLE)) {
+        return true;
+    }
+    if (next[index] == -1) {
+        return false;
+    }
+    const float cost = stepCost(grid, index, next[index]);
+    return cost != UNREACHABLE && std::fabs(distance[next[index]] + cost - distance[index]) < 1e-3f;
+}
+
+// Lowers a tile's distance to the best offered by its neighbors, queueing it if improved
+void FlowField::relaxFromNeighbors(const TileGrid& grid, int index) {
+    if (goal[index]) {
+        return;
+    }
+    float best = distance[index];
+    int bestNext = next[index];
+    forEachNeighbor<MapConnectivity>(grid, index, [&](int neighbor, int) {
+        if (distance[neighbor] == UNREACHABLE) {
+            return;
+        }
+        const float candidate = distance[neighbor] + stepCost(grid, index, neighbor);
+        if (candidate < best) {
+            best = candidate;
+            bestNext = neighbor;
+        }
+    });
+    if (best < distance[index]) {
+        distance[index] = best;
+        next[index] = bestNext;
+        pushOpen(best, index);
+    }
+}
+
+void FlowField::applyChanges(const TileGrid& grid, const std::vector<int>& changedTiles) {
+    invalidTiles.clear();
+    auto markInvalid = [&](int index) {
+        if (!invalid[index] && !goal[index]) {
+            invalid[index] = 1;
+            invalidTiles.push_back(index);
+        }
+    };
+
+    // Tiles around a change whose step is no longer valid or no longer as cheap
+    for (int changed : changedTiles) {
+        if (!isConsistent(grid, changed)) {
+            markInvalid(changed);
+        }
+        forEachNeighbor<MapConnectivity>(grid, changed, [&](int neighbor, int) {
+            if (!isConsistent(grid, neighbor)) {
+                markInvalid(neighbor);
+            }
+        });
+    }
+    // ...and every tile whose route runs through one of them
+    for (size_t i = 0; i < invalidTiles.size(); ++i) {
+        const int current = invalidTiles[i];
+        forEachNeighbor<MapConnectivity>(grid, current, [&](int neighbor, int) {
+            if (next[neighbor] == current) {
+                markInvalid(neighbor);
+            }
+        });
+    }
+    for (int index : invalidTiles) {
+        distance[index] = UNREACHABLE;
+        next[index] = -1;
+    }
+
+    // Re-seed the invalidated region from its intact border, plus the changed
+    // tiles' surroundings in case a change opened a shorter route
+    open.clear();
+    for (int index : invalidTiles) {
+        relaxFromNeighbors(grid, index);
+    }
+    for (int changed : changedTiles) {
+        relaxFromNeighbors(grid, changed);
+        forEachNeighbor<MapConnectivity>(grid, changed, [&](int neighbor, int) {
+            relaxFromNeighbors(grid, neighbor);
+        });
+    }
+    for (int index : invalidTiles) {
+        invalid[index] = 0;
+    }
+    propagate(grid);
+}
+
+bool FlowField::tracePath(const TileGrid& grid, int start, int stopBeforeWallTiles, std::vector<int>& path) const {
+    path.clear();
+    if (!isReachable(start)) {
+        return false;
+    }
+    path.push_back(start);
+    int current = start;
+    while (!goal[current] && next[current] != -1) {
+        current = next[current];
+        path.push_back(current);
+        if (grid.isBlocked(current)) {
+            break; // Goal building or the wall to breach
+        }
+    }
+    stopShortOfBlocked(grid, path, stopBeforeWallTiles);
+    return true;
+}
@@ -0,0 +1,57 @@
+#ifndef FLOWFIELD_HPP
+#define FLOWFIELD_HPP
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include "GridSearch.hpp"
+#include "TileGrid.hpp"
+
+// Dijkstra distance field from a set of goal tiles (e.g. the town hall) over
+// the whole grid. Every tile stores its distance and the neighbor one step
+// closer to a goal, so any number of units can head for the goal by following
+// the gradient instead of searching. Walls are traversable at WALL_COST so
+// units in a walled-off area still get a route to the cheapest breach; other
+// blocked tiles (buildings, towers, water) are impassable unless they are goals.
+class FlowField {
+public:
+    static constexpr float WALL_COST = 20.0f;
+
+    FlowField();
+
+    // Recomputes the whole field
+    void build(const TileGrid& grid, const std::vector<int>& goalTiles);
+    // Repairs only the part of the field affected by the given changed tiles
+    void applyChanges(const TileGrid& grid, const std::vector<int>& changedTiles);
+
+    bool isReachable(int index) const;
+    float getDistance(int index) const;
+    bool isGoal(int index) const;
+    // Neighbor one step closer to a goal, or -1 at a goal or unreachable tile
+    int getNextStep(int index) const;
+
+    // Follows the gradient from start until a goal or a wall, stopping
+    // stopBeforeWallTiles short of it (see stopShortOfBlocked). Returns false
+    // and leaves path empty if start cannot reach a goal.
+    bool tracePath(const TileGrid& grid, int start, int stopBeforeWallTiles, std::vector<int>& path) const;
+
+private:
+    std::vector<float> distance;
+    std::vector<int> next;
+    std::vector<std::uint8_t> goal;
+    std::vector<std::uint8_t> invalid; // Scratch for applyChanges
+    std::vector<int> invalidTiles;
+    std::vector<std::pair<float, int>> open; // Min-heap of (distance, tile)
+    GridSearchScratch search; // For build
+
+    // stepCost as a runGridSearch policy, searched backward from the goals
+    struct BackwardStepCost;
+
+    float stepCost(const TileGrid& grid, int from, int to) const;
+    bool isConsistent(const TileGrid& grid, int index) const;
+    void relaxFromNeighbors(const TileGrid& grid, int index);
+    void pushOpen(float dist, int index);
+    void propagate(const TileGrid& grid);
+};
+
+#endif // FLOWFIELD_HPP
@@ -7,44 +7,37 @@ int tanksAtTownHall = 0;
 int skeletonsAtTownHall = 0;
 
 // Constructor that captures the current state of all tiles
-GameState::GameState(const std::vector<std::vector<std::shared_ptr<Tile>>>& tiles) {
-    tileStates.resize(tiles.size());
-    for (size_t row = 0; row < tiles.size(); ++row) {
-        tileStates[row].resize(tiles[row].size());
-        for (size_t col = 0; col < tiles[row].size(); ++col) {
-            const auto& tile = tiles[row][col];
-            TileState tileState;
-            tileState.row = tile->getRow();
-            tileState.col = tile->getCol();
-            tileState.type = tile->getType();
-            tileState.texturePath = tile->getTexturePath();
-            tileState.grassIndex = tile->getGrassTileIndex();
-            if (tile->getBuilding()) {
-                tileState.buildingId = tile->getBuilding()->getId();
-                tileState.buildingTexturePath = tile->getBuilding()->getTexturePath();
-            } else {
-                tileState.buildingId = -1;
-            }
-            if (tile->hasTrap()) {
-                tileState.hasTrap = true;
-                tileState.trapTexturePath = tile->getTrap()->getTexturePath();
-            } else {
-                tileState.hasTrap = false;
-            }
-            if (tile->getTower()) {
-                tileState.hasTower = true;
-                tileState.towerId = tile->getTower()->getId();
-                tileState.towerTexturePath = tile->getTower()->getTexturePath();
-            } else {
-                tileState.hasTower = false;
-            }
-            if (tile->isWall()) {
-                tileState.hasWall = true;
-            } else {
-                tileState.hasWall = false;
-            }
-            tileStates[row][col] = tileState;
+GameState::GameState(const TileStore& tiles) {
+    const TileGrid& grid = tiles.grid;
+    tileStates.resize(grid.size());
+    for (int index = 0; index < grid.size(); ++index) {
+        const TileOccupants& occupant = tiles.occupants[index];
+        TileState& tileState = tileStates[index];
+        tileState.row = grid.rowOf(index);
+        tileState.col = grid.colOf(index);
+        tileState.type = grid.getType(index);
+        tileState.texturePath = tiles.render[index].texturePath;
+        tileState.grassIndex = grid.getGrassTileIndex(index);
+        if (occupant.building) {
+            tileState.buildingId = occupant.building->getId();
+            tileState.buildingTexturePath = occupant.building->getTexturePath();
+        } else {
+            tileState.buildingId = -1;
         }
+        if (occupant.trap) {
+            tileState.hasTrap = true;
+            tileState.trapTexturePath = occupant.trap->getTexturePath();
+        } else {
+            tileState.hasTrap = false;
+        }
+        if (occupant.tower) {
+            tileState.hasTower = true;
+            tileState.towerId = occupant.tower->getId();
+            tileState.towerTexturePath = occupant.tower->getTexturePath();
+        } else {
+            tileState.hasTower = false;
+        }
+        tileState.hasWall = grid.getType(index) == TileType::Wall;
     }
 }
 
@@ -52,6 +45,6 @@ GameState::GameState(const std::vector<std::vector<std::shared_ptr<Tile>>>& tile
 GameState::GameState(const GameState& other) : tileStates(other.tileStates) {}
 
 // Getter for tile states
-const std::vector<std::vector<TileState>>& GameState::getTileStates() const {
+const std::vector<TileState>& GameState::getTileStates() const {
     return tileStates;
 }
\ No newline at end of file
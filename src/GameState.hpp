@@ -38,16 +38,16 @@ struct TileState {
 class GameState {
 public:
     // Constructs a GameState by capturing the current tile properties
-    GameState(const std::vector<std::vector<std::shared_ptr<Tile>>>& tiles);
+    GameState(const TileStore& tiles);
     
     // Copy constructor
     GameState(const GameState& other);
     
-    // Retrieves the stored tile states
-    const std::vector<std::vector<TileState>>& getTileStates() const;
+    // Retrieves the stored tile states, row-major like TileGrid
+    const std::vector<TileState>& getTileStates() const;
     
 private:
-    std::vector<std::vector<TileState>> tileStates;
+    std::vector<TileState> tileStates;
 };
 
 #endif // GAMESTATE_HPP
\ No newline at end of file
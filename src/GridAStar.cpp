@@ -0,0 +1,64 @@
+// GridAStar.cpp
+#include "GridAStar.hpp"
+#include "GridConnectivity.hpp"
+#include <algorithm>
+
+GridAStar::GridAStar() : searchStart(-1), searchGoal(-1) {}
+
+size_t GridAStar::getLastExpansions() const {
+    return scratch.getExpansions();
+}
+
+bool GridAStar::findPath(const TileGrid& grid, int start, int goal, std::vector<int>& path) {
+    beginSearch(grid, start, goal);
+    Status result = resumeSearch(grid, static_cast<size_t>(-1));
+    getSearchPath(path);
+    return result == Status::Found;
+}
+
+void GridAStar::beginSearch(const TileGrid& grid, int start, int goal) {
+    searchStart = start;
+    searchGoal = goal;
+    startGridSearch(grid, scratch, start, stepCost(), heuristic(grid));
+}
+
+GridAStar::Status GridAStar::resumeSearch(const TileGrid& grid, size_t maxExpansions) {
+    switch (runGridSearch<MapConnectivity>(grid, scratch, stepCost(), heuristic(grid), TileGoal{searchGoal}, maxExpansions)) {
+        case GridSearchScratch::Status::Searching:
+            return Status::Searching;
+        case GridSearchScratch::Status::Found:
+            return Status::Found;
+        default:
+            return Status::Unreachable;
+    }
+}
+
+void GridAStar::getSearchPath(std::vector<int>& path) const {
+    const bool found = scratch.getStatus() == GridSearchScratch::Status::Found;
+    scratch.tracePath(found ? scratch.getFound() : scratch.getClosest(), path);
+}
+
+void stopShortOfBlocked(const TileGrid& grid, std::vector<int>& path, int stopBeforeWallTiles) {
+    if (stopBeforeWallTiles > 0 && path.size() > 1 && grid.isBlocked(path.back())) {
+        size_t drop = std::min(static_cast<size_t>(stopBeforeWallTiles), path.size() - 1);
+        path.resize(path.size() - drop);
+    }
+}
+
+int blockedNeighborTowards(const TileGrid& grid, int from, int goal) {
+    int best = -1;
+    int bestDistance = 0;
+    forEachNeighbor<MapConnectivity>(grid, from, [&](int neighbor, int) {
+        if (!grid.isBlocked(neighbor)) {
+            return;
+        }
+        int dRow = grid.rowOf(neighbor) - grid.rowOf(goal);
+        int dCol = grid.colOf(neighbor) - grid.colOf(goal);
+        int distance = dRow * dRow + dCol * dCol;
+        if (best == -1 || distance < bestDistance) {
+            best = neighbor;
+            bestDistance = distance;
+        }
+    });
+    return best;
+}
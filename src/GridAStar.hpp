@@ -0,0 +1,61 @@
+#ifndef GRIDASTAR_HPP
+#define GRIDASTAR_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "GridSearch.hpp"
+#include "TileGrid.hpp"
+
+// A* over a TileGrid with eight-way movement, octile heuristic and an indexed
+// binary heap: runGridSearch (GridSearch.hpp) instantiated with the shared
+// movement rules. Per-node scratch is kept across queries and invalidated by
+// bumping a generation stamp, so a query allocates nothing once the arrays
+// have grown to the grid size.
+class GridAStar {
+public:
+    GridAStar();
+
+    // Finds a path from start to goal over unblocked tiles. The goal itself may
+    // be blocked (e.g. the town hall). On success the tile indices start..goal
+    // are written to path and true is returned. If the goal is unreachable, path
+    // leads to the reachable tile closest to the goal and false is returned.
+    bool findPath(const TileGrid& grid, int start, int goal, std::vector<int>& path);
+
+    // The same search split across calls, for callers that cap work per frame.
+    // The grid must not change between beginSearch and the final resumeSearch.
+    enum class Status {
+        Searching,
+        Found,
+        Unreachable
+    };
+    void beginSearch(const TileGrid& grid, int start, int goal);
+    // Expands up to maxExpansions more nodes
+    Status resumeSearch(const TileGrid& grid, size_t maxExpansions);
+    // Path of a finished search, as findPath would have written it
+    void getSearchPath(std::vector<int>& path) const;
+
+    // Number of nodes closed by the last (or current) query
+    size_t getLastExpansions() const;
+
+private:
+    GridSearchScratch scratch;
+    int searchStart;
+    int searchGoal;
+
+    MapStepCost stepCost() const { return MapStepCost{searchStart, searchGoal}; }
+    OctileHeuristic heuristic(const TileGrid& grid) const {
+        return OctileHeuristic{grid.rowOf(searchGoal), grid.colOf(searchGoal)};
+    }
+};
+
+// If path ends on a blocked tile, drops it and the free tiles before it so the
+// path stops stopBeforeWallTiles short of it (0 keeps the blocked tile). The
+// first tile is always kept.
+void stopShortOfBlocked(const TileGrid& grid, std::vector<int>& path, int stopBeforeWallTiles);
+
+// Blocked neighbor of from that lies closest to goal, or -1 if none. Used to
+// aim at the wall in front of the closest reachable tile when goal is sealed off.
+int blockedNeighborTowards(const TileGrid& grid, int from, int goal);
+
+#endif // GRIDASTAR_HPP
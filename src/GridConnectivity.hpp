@@ -0,0 +1,63 @@
+#ifndef GRIDCONNECTIVITY_HPP
+#define GRIDCONNECTIVITY_HPP
+
+#include "TileGrid.hpp"
+
+// Compile-time neighbor policies for TileGrid. Neighbors are derived from
+// coordinates, so tiles store no edge lists.
+struct FourWayConnectivity {
+    static constexpr int count = 4;
+    static constexpr int dRow[count] = {0, 1, 0, -1};
+    static constexpr int dCol[count] = {1, 0, -1, 0};
+
+    static constexpr bool isStep(int dRow, int dCol) {
+        return (dRow < 0 ? -dRow : dRow) + (dCol < 0 ? -dCol : dCol) == 1;
+    }
+};
+
+struct EightWayConnectivity {
+    static constexpr int count = 8;
+    static constexpr int dRow[count] = {-1, 1, 0, 0, -1, -1, 1, 1};
+    static constexpr int dCol[count] = {0, 0, -1, 1, -1, 1, -1, 1};
+
+    static constexpr bool isStep(int dRow, int dCol) {
+        return (dRow | dCol) != 0 && dRow >= -1 && dRow <= 1 && dCol >= -1 && dCol <= 1;
+    }
+};
+
+// Connectivity units move with on the map
+using MapConnectivity = EightWayConnectivity;
+
+// Cost of a diagonal step when a straight step costs 1
+constexpr float DIAGONAL_STEP_COST = 1.41421356f;
+
+// Calls visit(neighborIndex, direction) for every in-bounds neighbor of index
+template <typename Connectivity, typename Visitor>
+inline void forEachNeighbor(const TileGrid& grid, int index, Visitor&& visit) {
+    const unsigned rows = static_cast<unsigned>(grid.getRows());
+    const unsigned cols = static_cast<unsigned>(grid.getCols());
+    const int row = grid.rowOf(index);
+    const int col = grid.colOf(index);
+    for (int direction = 0; direction < Connectivity::count; ++direction) {
+        const int newRow = row + Connectivity::dRow[direction];
+        const int newCol = col + Connectivity::dCol[direction];
+        // One unsigned compare per axis covers both the < 0 and >= size cases
+        if (static_cast<unsigned>(newRow) < rows && static_cast<unsigned>(newCol) < cols) {
+            visit(grid.index(newRow, newCol), direction);
+        }
+    }
+}
+
+// Index of the tile at (row + dRow, col + dCol), or -1 if that offset is not a
+// single step under Connectivity or falls outside the grid
+template <typename Connectivity>
+inline int neighborIndex(const TileGrid& grid, int index, int dRow, int dCol) {
+    const int newRow = grid.rowOf(index) + dRow;
+    const int newCol = grid.colOf(index) + dCol;
+    if (!Connectivity::isStep(dRow, dCol) || !grid.inBounds(newRow, newCol)) {
+        return -1;
+    }
+    return grid.index(newRow, newCol);
+}
+
+#endif // GRIDCONNECTIVITY_HPP
@@ -0,0 +1,350 @@
+#ifndef GRIDSEARCH_HPP
+#define GRIDSEARCH_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <vector>
+#include "GridConnectivity.hpp"
+#include "TileGrid.hpp"
+
+// Header-only best-first search over a TileGrid. runGridSearch is specialized
+// at compile time on four policies, so every instantiation is one tight loop
+// with no indirect calls:
+//
+//   Connectivity  neighbor offsets (GridConnectivity.hpp)
+//   Cost          float operator()(grid, from, to, dRow, dCol): step cost, or a
+//                 negative value if the step is not allowed;
+//                 bool canLeave(grid, tile): whether a reached tile is expanded
+//   Heuristic     float operator()(grid, tile): admissible estimate to the goal;
+//                 static constexpr bool isZero
+//   Goal          bool operator()(tile): stop when such a tile is expanded
+//
+// The open list is an indexed binary heap ordered by f, then h. All per-node
+// state lives in a GridSearchScratch that any instantiation can reuse, and a
+// search can be run in slices by bounding the expansions. With ZeroHeuristic,
+// a goal that never matches and several start tiles it is a multi-source
+// Dijkstra, which is how FlowField builds its distance field.
+
+class GridSearchScratch {
+public:
+    enum class Status {
+        Searching,
+        Found,
+        Exhausted // Open list ran dry without reaching a goal
+    };
+
+    GridSearchScratch()
+        : generation(0), status(Status::Exhausted), found(-1), closest(-1),
+          closestH(0.0f), expansions(0) {}
+
+    // Resets the per-node state in O(1) by bumping a generation stamp
+    void prepare(int nodeCount) {
+        if (static_cast<int>(stamp.size()) < nodeCount) {
+            g.resize(nodeCount);
+            parent.resize(nodeCount);
+            heapIndex.resize(nodeCount);
+            stamp.resize(nodeCount, 0);
+        }
+        heap.clear();
+        ++generation;
+        if (generation == 0) {
+            // Stamp counter wrapped; old stamps could alias the new generation
+            std::fill(stamp.begin(), stamp.end(), 0);
+            generation = 1;
+        }
+        status = Status::Searching;
+        found = -1;
+        closest = -1;
+        expansions = 0;
+    }
+
+    bool isReached(int node) const { return stamp[node] == generation; }
+    // Cost of the best route found to node so far; infinity if not reached
+    float getCost(int node) const {
+        return isReached(node) ? g[node] : std::numeric_limits<float>::infinity();
+    }
+    int getParent(int node) const { return parent[node]; }
+
+    Status getStatus() const { return status; }
+    int getFound() const { return found; }     // Goal tile that ended the search
+    int getClosest() const { return closest; } // Expanded tile with the lowest heuristic
+    size_t getExpansions() const { return expansions; }
+
+    // Tiles from the search's start to node
+    void tracePath(int node, std::vector<int>& path) const {
+        path.clear();
+        for (int current = node; current != -1; current = parent[current]) {
+            path.push_back(current);
+        }
+        std::reverse(path.begin(), path.end());
+    }
+
+private:
+    template <typename Connectivity, typename Cost, typename Heuristic, typename Goal>
+    friend Status runGridSearch(const TileGrid&, GridSearchScratch&, const Cost&, const Heuristic&, const Goal&, size_t);
+    template <typename Cost, typename Heuristic>
+    friend void startGridSearch(const TileGrid&, GridSearchScratch&, int, const Cost&, const Heuristic&);
+    template <typename Cost, typename Heuristic>
+    friend void startGridSearch(const TileGrid&, GridSearchScratch&, const std::vector<int>&, const Cost&, const Heuristic&);
+
+    struct HeapEntry {
+        float f;
+        float h;
+        int node;
+    };
+
+    std::vector<float> g;
+    std::vector<int> parent;
+    std::vector<int> heapIndex; // Slot in heap, or -1 once closed
+    std::vector<std::uint32_t> stamp;
+    std::vector<HeapEntry> heap;
+    std::uint32_t generation;
+    Status status;
+    int found;
+    int closest;
+    float closestH;
+    size_t expansions;
+
+    void reach(int node, float cost, int from) {
+        stamp[node] = generation;
+        g[node] = cost;
+        parent[node] = from;
+    }
+
+    // Lowest f first, ties broken toward the goal (lowest h)
+    static bool heapLess(const HeapEntry& a, const HeapEntry& b) {
+        return a.f < b.f || (a.f == b.f && a.h < b.h);
+    }
+
+    void push(int node, float f, float h) {
+        heap.push_back(HeapEntry{f, h, node});
+        heapIndex[node] = static_cast<int>(heap.size()) - 1;
+        siftUp(static_cast<int>(heap.size()) - 1);
+    }
+
+    HeapEntry pop() {
+        HeapEntry top = heap[0];
+        heapIndex[top.node] = -1;
+        heap[0] = heap.back();
+        heap.pop_back();
+        if (!heap.empty()) {
+            heapIndex[heap[0].node] = 0;
+            siftDown(0);
+        }
+        return top;
+    }
+
+    void siftUp(int slot) {
+        HeapEntry entry = heap[slot];
+        while (slot > 0) {
+            const int parentSlot = (slot - 1) / 2;
+            if (!heapLess(entry, heap[parentSlot])) {
+                break;
+            }
+            heap[slot] = heap[parentSlot];
+            heapIndex[heap[slot].node] = slot;
+            slot = parentSlot;
+        }
+        heap[slot] = entry;
+        heapIndex[entry.node] = slot;
+    }
+
+    void siftDown(int slot) {
+        HeapEntry entry = heap[slot];
+        const int count = static_cast<int>(heap.size());
+        while (true) {
+            int child = 2 * slot + 1;
+            if (child >= count) {
+                break;
+            }
+            if (child + 1 < count && heapLess(heap[child + 1], heap[child])) {
+                ++child;
+            }
+            if (!heapLess(heap[child], entry)) {
+                break;
+            }
+            heap[slot] = heap[child];
+            heapIndex[heap[slot].node] = slot;
+            slot = child;
+        }
+        heap[slot] = entry;
+        heapIndex[entry.node] = slot;
+    }
+};
+
+// Blocked tiles are impassable except the goal (which may be a building), and
+// only the source may be left while blocked. Diagonal steps may not cut a
+// blocked corner. These are the movement rules every unit search shares.
+struct MapStepCost {
+    int source;
+    int goal; // -1 if none
+
+    float operator()(const TileGrid& grid, int from, int to, int dRow, int dCol) const {
+        if (to != goal && grid.isBlocked(to)) {
+            return -1.0f;
+        }
+        if (dRow != 0 && dCol != 0) {
+            const int row = grid.rowOf(from);
+            const int col = grid.colOf(from);
+            if (grid.isBlocked(grid.index(row + dRow, col)) || grid.isBlocked(grid.index(row, col + dCol))) {
+                return -1.0f;
+            }
+            return DIAGONAL_STEP_COST;
+        }
+        return 1.0f;
+    }
+    bool canLeave(const TileGrid& grid, int tile) const {
+        return tile == source || !grid.isBlocked(tile);
+    }
+};
+
+// MapStepCost confined to the rectangle [rowBegin, rowEnd) x [colBegin, colEnd)
+struct RegionStepCost {
+    MapStepCost rules;
+    int rowBegin;
+    int colBegin;
+    int rowEnd;
+    int colEnd;
+
+    float operator()(const TileGrid& grid, int from, int to, int dRow, int dCol) const {
+        const int row = grid.rowOf(to);
+        const int col = grid.colOf(to);
+        if (row < rowBegin || row >= rowEnd || col < colBegin || col >= colEnd) {
+            return -1.0f;
+        }
+        return rules(grid, from, to, dRow, dCol);
+    }
+    bool canLeave(const TileGrid& grid, int tile) const {
+        return rules.canLeave(grid, tile);
+    }
+};
+
+struct ZeroHeuristic {
+    static constexpr bool isZero = true;
+
+    float operator()(const TileGrid&, int) const { return 0.0f; }
+};
+
+// Exact cost to the goal on an open eight-way grid
+struct OctileHeuristic {
+    static constexpr bool isZero = false;
+    int goalRow;
+    int goalCol;
+
+    float operator()(const TileGrid& grid, int tile) const {
+        const int dRow = std::abs(grid.rowOf(tile) - goalRow);
+        const int dCol = std::abs(grid.colOf(tile) - goalCol);
+        return static_cast<float>(dRow + dCol) + (DIAGONAL_STEP_COST - 2.0f) * static_cast<float>(std::min(dRow, dCol));
+    }
+};
+
+struct TileGoal {
+    int tile; // -1 searches until the open list is exhausted
+
+    bool operator()(int node) const { return node == tile; }
+};
+
+// Opens a search from start; run it with runGridSearch
+template <typename Cost, typename Heuristic>
+void startGridSearch(const TileGrid& grid, GridSearchScratch& scratch, int start,
+                     const Cost&, const Heuristic& heuristic) {
+    scratch.prepare(grid.size());
+    scratch.reach(start, 0.0f, -1);
+    const float h = heuristic(grid, start);
+    scratch.push(start, h, h);
+    scratch.closest = start;
+    scratch.closestH = h;
+}
+
+// Opens a search from every tile in starts at cost zero
+template <typename Cost, typename Heuristic>
+void startGridSearch(const TileGrid& grid, GridSearchScratch& scratch, const std::vector<int>& starts,
+                     const Cost&, const Heuristic& heuristic) {
+    scratch.prepare(grid.size());
+    scratch.closestH = std::numeric_limits<float>::infinity();
+    for (int start : starts) {
+        if (scratch.isReached(start)) {
+            continue;
+        }
+        scratch.reach(start, 0.0f, -1);
+        const float h = heuristic(grid, start);
+        scratch.push(start, h, h);
+        if (h < scratch.closestH) {
+            scratch.closest = start;
+            scratch.closestH = h;
+        }
+    }
+}
+
+// Expands up to maxExpansions nodes of the search opened by startGridSearch.
+// Pass the same policies on every call of one search.
+template <typename Connectivity, typename Cost, typename Heuristic, typename Goal>
+GridSearchScratch::Status runGridSearch(const TileGrid& grid, GridSearchScratch& scratch, const Cost& cost,
+                                        const Heuristic& heuristic, const Goal& isGoal, size_t maxExpansions) {
+    using Status = GridSearchScratch::Status;
+    const unsigned rows = static_cast<unsigned>(grid.getRows());
+    const unsigned cols = static_cast<unsigned>(grid.getCols());
+
+    for (size_t expanded = 0; scratch.status == Status::Searching && expanded < maxExpansions; ++expanded) {
+        if (scratch.heap.empty()) {
+            scratch.status = Status::Exhausted;
+            break;
+        }
+        const GridSearchScratch::HeapEntry top = scratch.pop();
+        const int current = top.node;
+        if (!Heuristic::isZero && top.h < scratch.closestH) {
+            scratch.closest = current;
+            scratch.closestH = top.h;
+        }
+        ++scratch.expansions;
+
+        if (isGoal(current)) {
+            scratch.status = Status::Found;
+            scratch.found = current;
+            break;
+        }
+        if (!cost.canLeave(grid, current)) {
+            continue;
+        }
+
+        const int row = grid.rowOf(current);
+        const int col = grid.colOf(current);
+        const float base = scratch.g[current];
+        for (int direction = 0; direction < Connectivity::count; ++direction) {
+            const int dRow = Connectivity::dRow[direction];
+            const int dCol = Connectivity::dCol[direction];
+            const int newRow = row + dRow;
+            const int newCol = col + dCol;
+            // One unsigned compare per axis covers both the < 0 and >= size cases
+            if (static_cast<unsigned>(newRow) >= rows || static_cast<unsigned>(newCol) >= cols) {
+                continue;
+            }
+            const int next = grid.index(newRow, newCol);
+            const float step = cost(grid, current, next, dRow, dCol);
+            if (step < 0.0f) {
+                continue;
+            }
+            const float total = base + step;
+            if (scratch.isReached(next)) {
+                const int slot = scratch.heapIndex[next];
+                if (slot < 0 || total >= scratch.g[next]) {
+                    continue; // Closed, or not an improvement
+                }
+                scratch.g[next] = total;
+                scratch.parent[next] = current;
+                scratch.heap[slot].f = total + scratch.heap[slot].h;
+                scratch.siftUp(slot);
+            } else {
+                const float h = heuristic(grid, next);
+                scratch.reach(next, total, current);
+                scratch.push(next, total + h, h);
+            }
+        }
+    }
+    return scratch.status;
+}
+
+#endif // GRIDSEARCH_HPP
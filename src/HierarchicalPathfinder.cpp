@@ -0,0 +1,515 @@
+// HierarchicalPathfinder.cpp
+#include "HierarchicalPathfinder.hpp"
+#include "GridConnectivity.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+#include <limits>
+
+static const float UNREACHABLE = std::numeric_limits<float>::infinity();
+
+// Border runs at least this wide get an entrance at each end instead of one in the middle
+static const int WIDE_ENTRANCE = 6;
+
+static float octileDistance(int dRow, int dCol) {
+    dRow = std::abs(dRow);
+    dCol = std::abs(dCol);
+    return static_cast<float>(dRow + dCol) + (DIAGONAL_STEP_COST - 2.0f) * static_cast<float>(std::min(dRow, dCol));
+}
+
+// Turns a run of open border positions [begin, end) into entrances
+static void addEntrances(int begin, int end, const std::function<void(int)>& add) {
+    if (end - begin < WIDE_ENTRANCE) {
+        add((begin + end - 1) / 2);
+    } else {
+        add(begin);
+        add(end - 1);
+    }
+}
+
+HierarchicalPathfinder::HierarchicalPathfinder(int clusterSize)
+    : clusterSize(std::max(clusterSize, 2)), clusterRows(0), clusterCols(0),
+      lastRebuiltClusters(0), lastExpansions(0), graphDirty(true), abstractGeneration(0) {}
+
+int HierarchicalPathfinder::getClusterSize() const {
+    return clusterSize;
+}
+
+int HierarchicalPathfinder::getClusterCount() const {
+    return static_cast<int>(clusters.size());
+}
+
+size_t HierarchicalPathfinder::getAbstractNodeCount() const {
+    size_t count = 0;
+    for (const auto& cluster : clusters) {
+        count += cluster.nodeTiles.size();
+    }
+    return count;
+}
+
+int HierarchicalPathfinder::getLastRebuiltClusters() const {
+    return lastRebuiltClusters;
+}
+
+size_t HierarchicalPathfinder::getLastExpansions() const {
+    return lastExpansions;
+}
+
+int HierarchicalPathfinder::clusterOf(const TileGrid& grid, int index) const {
+    return (grid.rowOf(index) / clusterSize) * clusterCols + grid.colOf(index) / clusterSize;
+}
+
+void HierarchicalPathfinder::scanRightBorder(const TileGrid& grid, int cluster, std::vector<Entrance>& entrances) const {
+    entrances.clear();
+    const Cluster& c = clusters[cluster];
+    if (c.colEnd >= grid.getCols()) {
+        return;
+    }
+    auto add = [&](int row) {
+        entrances.push_back(Entrance{grid.index(row, c.colEnd - 1), grid.index(row, c.colEnd)});
+    };
+    int runBegin = -1;
+    for (int row = c.rowBegin; row < c.rowEnd; ++row) {
+        bool open = !grid.isBlocked(grid.index(row, c.colEnd - 1)) && !grid.isBlocked(grid.index(row, c.colEnd));
+        if (open && runBegin < 0) {
+            runBegin = row;
+        } else if (!open && runBegin >= 0) {
+            addEntrances(runBegin, row, add);
+            runBegin = -1;
+        }
+    }
+    if (runBegin >= 0) {
+        addEntrances(runBegin, c.rowEnd, add);
+    }
+}
+
+void HierarchicalPathfinder::scanBottomBorder(const TileGrid& grid, int cluster, std::vector<Entrance>& entrances) const {
+    entrances.clear();
+    const Cluster& c = clusters[cluster];
+    if (c.rowEnd >= grid.getRows()) {
+        return;
+    }
+    auto add = [&](int col) {
+        entrances.push_back(Entrance{grid.index(c.rowEnd - 1, col), grid.index(c.rowEnd, col)});
+    };
+    int runBegin = -1;
+    for (int col = c.colBegin; col < c.colEnd; ++col) {
+        bool open = !grid.isBlocked(grid.index(c.rowEnd - 1, col)) && !grid.isBlocked(grid.index(c.rowEnd, col));
+        if (open && runBegin < 0) {
+            runBegin = col;
+        } else if (!open && runBegin >= 0) {
+            addEntrances(runBegin, col, add);
+            runBegin = -1;
+        }
+    }
+    if (runBegin >= 0) {
+        addEntrances(runBegin, c.colEnd, add);
+    }
+}
+
+// Collects the cluster's entrance tiles from its four borders and walks
+// between every pair of them
+void HierarchicalPathfinder::buildClusterNodes(const TileGrid& grid, int cluster) {
+    Cluster& c = clusters[cluster];
+    c.nodeTiles.clear();
+    const int clusterRow = cluster / clusterCols;
+    const int clusterCol = cluster % clusterCols;
+    for (const auto& entrance : rightBorders[cluster]) {
+        c.nodeTiles.push_back(entrance.first);
+    }
+    for (const auto& entrance : bottomBorders[cluster]) {
+        c.nodeTiles.push_back(entrance.first);
+    }
+    if (clusterCol > 0) {
+        for (const auto& entrance : rightBorders[cluster - 1]) {
+            c.nodeTiles.push_back(entrance.second);
+        }
+    }
+    if (clusterRow > 0) {
+        for (const auto& entrance : bottomBorders[cluster - clusterCols]) {
+            c.nodeTiles.push_back(entrance.second);
+        }
+    }
+    // A corner tile can be an entrance on two borders
+    std::sort(c.nodeTiles.begin(), c.nodeTiles.end());
+    c.nodeTiles.erase(std::unique(c.nodeTiles.begin(), c.nodeTiles.end()), c.nodeTiles.end());
+
+    const size_t count = c.nodeTiles.size();
+    c.costs.assign(count * count, UNREACHABLE);
+    for (size_t i = 0; i < count; ++i) {
+        searchCluster(grid, c, c.nodeTiles[i], -1, -1);
+        for (size_t j = 0; j < count; ++j) {
+            c.costs[i * count + j] = localSearch.getCost(c.nodeTiles[j]);
+        }
+    }
+    graphDirty = true;
+}
+
+void HierarchicalPathfinder::build(const TileGrid& grid) {
+    clusterRows = (grid.getRows() + clusterSize - 1) / clusterSize;
+    clusterCols = (grid.getCols() + clusterSize - 1) / clusterSize;
+    const int count = clusterRows * clusterCols;
+    clusters.assign(count, Cluster());
+    rightBorders.assign(count, std::vector<Entrance>());
+    bottomBorders.assign(count, std::vector<Entrance>());
+    tileToNode.assign(grid.size(), -1);
+    nodeTile.clear();
+
+    for (int cluster = 0; cluster < count; ++cluster) {
+        Cluster& c = clusters[cluster];
+        c.rowBegin = (cluster / clusterCols) * clusterSize;
+        c.colBegin = (cluster % clusterCols) * clusterSize;
+        c.rowEnd = std::min(c.rowBegin + clusterSize, grid.getRows());
+        c.colEnd = std::min(c.colBegin + clusterSize, grid.getCols());
+    }
+    for (int cluster = 0; cluster < count; ++cluster) {
+        scanRightBorder(grid, cluster, rightBorders[cluster]);
+        scanBottomBorder(grid, cluster, bottomBorders[cluster]);
+    }
+    for (int cluster = 0; cluster < count; ++cluster) {
+        buildClusterNodes(grid, cluster);
+    }
+    lastRebuiltClusters = count;
+    graphDirty = true;
+}
+
+void HierarchicalPathfinder::applyChanges(const TileGrid& grid, const std::vector<int>& changedTiles) {
+    if (static_cast<int>(tileToNode.size()) != grid.size()) {
+        build(grid);
+        return;
+    }
+
+    std::vector<std::uint8_t> rebuild(clusters.size(), 0);
+    std::vector<int> touched;
+    for (int changed : changedTiles) {
+        const int cluster = clusterOf(grid, changed);
+        if (!rebuild[cluster]) {
+            rebuild[cluster] = 1;
+            touched.push_back(cluster);
+        }
+    }
+
+    // Rescan the touched clusters' borders; a neighbor only needs its costs
+    // redone if the border it shares with a touched cluster changed
+    std::vector<Entrance> scanned;
+    auto sameEntrances = [](const std::vector<Entrance>& a, const std::vector<Entrance>& b) {
+        return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin(), [](const Entrance& x, const Entrance& y) {
+            return x.first == y.first && x.second == y.second;
+        });
+    };
+    auto rescanRight = [&](int cluster, int other) {
+        scanRightBorder(grid, cluster, scanned);
+        if (!sameEntrances(scanned, rightBorders[cluster])) {
+            rightBorders[cluster].swap(scanned);
+            rebuild[cluster] = 1;
+            rebuild[other] = 1;
+        }
+    };
+    auto rescanBottom = [&](int cluster, int other) {
+        scanBottomBorder(grid, cluster, scanned);
+        if (!sameEntrances(scanned, bottomBorders[cluster])) {
+            bottomBorders[cluster].swap(scanned);
+            rebuild[cluster] = 1;
+            rebuild[other] = 1;
+        }
+    };
+    for (int cluster : touched) {
+        const int clusterRow = cluster / clusterCols;
+        const int clusterCol = cluster % clusterCols;
+        if (clusterCol + 1 < clusterCols) {
+            rescanRight(cluster, cluster + 1);
+        }
+        if (clusterRow + 1 < clusterRows) {
+            rescanBottom(cluster, cluster + clusterCols);
+        }
+        if (clusterCol > 0) {
+            rescanRight(cluster - 1, cluster);
+        }
+        if (clusterRow > 0) {
+            rescanBottom(cluster - clusterCols, cluster);
+        }
+    }
+
+    lastRebuiltClusters = 0;
+    for (size_t cluster = 0; cluster < clusters.size(); ++cluster) {
+        if (rebuild[cluster]) {
+            buildClusterNodes(grid, static_cast<int>(cluster));
+            ++lastRebuiltClusters;
+        }
+    }
+}
+
+// Flattens the per-cluster nodes into one graph and links entrance pairs
+void HierarchicalPathfinder::rebuildGraph() {
+    for (int tile : nodeTile) {
+        tileToNode[tile] = -1;
+    }
+    nodeTile.clear();
+    nodeCluster.clear();
+    clusterFirstNode.assign(clusters.size() + 1, 0);
+    for (size_t cluster = 0; cluster < clusters.size(); ++cluster) {
+        clusterFirstNode[cluster] = static_cast<int>(nodeTile.size());
+        for (int tile : clusters[cluster].nodeTiles) {
+            tileToNode[tile] = static_cast<int>(nodeTile.size());
+            nodeTile.push_back(tile);
+            nodeCluster.push_back(static_cast<int>(cluster));
+        }
+    }
+    clusterFirstNode[clusters.size()] = static_cast<int>(nodeTile.size());
+
+    interEdges.resize(nodeTile.size());
+    for (auto& edges : interEdges) {
+        edges.clear();
+    }
+    auto link = [&](const std::vector<Entrance>& entrances) {
+        for (const auto& entrance : entrances) {
+            const int a = tileToNode[entrance.first];
+            const int b = tileToNode[entrance.second];
+            interEdges[a].emplace_back(b, 1.0f);
+            interEdges[b].emplace_back(a, 1.0f);
+        }
+    };
+    for (size_t cluster = 0; cluster < clusters.size(); ++cluster) {
+        link(rightBorders[cluster]);
+        link(bottomBorders[cluster]);
+    }
+    graphDirty = false;
+}
+
+// Dijkstra from source over the cluster's open tiles, stopping once target (if
+// any) is settled. goal may be entered even when blocked but is not expanded
+// unless it is the source.
+void HierarchicalPathfinder::searchCluster(const TileGrid& grid, const Cluster& cluster, int source, int target, int goal) {
+    const RegionStepCost cost{MapStepCost{source, goal}, cluster.rowBegin, cluster.colBegin, cluster.rowEnd, cluster.colEnd};
+    startGridSearch(grid, localSearch, source, cost, ZeroHeuristic());
+    runGridSearch<MapConnectivity>(grid, localSearch, cost, ZeroHeuristic(), TileGoal{target}, static_cast<size_t>(-1));
+    lastExpansions += localSearch.getExpansions();
+}
+
+// Appends the tiles after `from` up to and including `to`
+bool HierarchicalPathfinder::refineHop(const TileGrid& grid, int from, int to, int goal, std::vector<int>& path) {
+    if (from == to) {
+        return true;
+    }
+    const int cluster = clusterOf(grid, from);
+    if (cluster != clusterOf(grid, to)) {
+        path.push_back(to); // Entrance pair: adjacent tiles across a border
+        return true;
+    }
+    const Cluster& c = clusters[cluster];
+    searchCluster(grid, c, from, to, goal);
+    if (localSearch.getCost(to) == UNREACHABLE) {
+        return false;
+    }
+    const size_t begin = path.size();
+    for (int current = to; current != from; current = localSearch.getParent(current)) {
+        path.push_back(current);
+    }
+    std::reverse(path.begin() + begin, path.end());
+    return true;
+}
+
+// Ways into the goal: the goal itself within its own cluster, plus every open
+// neighbor in an adjacent cluster, so a blocked goal on a cluster edge can
+// still be reached from the other side
+void HierarchicalPathfinder::collectApproaches(const TileGrid& grid, int goal) {
+    approaches.clear();
+    approaches.push_back(Approach{clusterOf(grid, goal), goal, 0.0f});
+    const int row = grid.rowOf(goal);
+    const int col = grid.colOf(goal);
+    forEachNeighbor<MapConnectivity>(grid, goal, [&](int neighbor, int direction) {
+        const int cluster = clusterOf(grid, neighbor);
+        if (cluster == approaches[0].cluster || grid.isBlocked(neighbor)) {
+            return;
+        }
+        const int dRow = MapConnectivity::dRow[direction];
+        const int dCol = MapConnectivity::dCol[direction];
+        float cost = 1.0f;
+        if (dRow != 0 && dCol != 0) {
+            if (grid.isBlocked(grid.index(row + dRow, col)) || grid.isBlocked(grid.index(row, col + dCol))) {
+                return;
+            }
+            cost = DIAGONAL_STEP_COST;
+        }
+        approaches.push_back(Approach{cluster, neighbor, cost});
+    });
+}
+
+bool HierarchicalPathfinder::findPath(const TileGrid& grid, int start, int goal, std::vector<int>& path) {
+    path.clear();
+    if (clusters.empty()) {
+        build(grid);
+    }
+    if (graphDirty) {
+        rebuildGraph();
+    }
+    lastExpansions = 0;
+    if (start == goal) {
+        path.push_back(start);
+        return true;
+    }
+
+    const int startCluster = clusterOf(grid, start);
+    if (startCluster == clusterOf(grid, goal)) {
+        // Try staying inside the cluster before going through the abstract graph
+        path.push_back(start);
+        if (refineHop(grid, start, goal, goal, path)) {
+            return true;
+        }
+        path.clear();
+    }
+
+    const int nodeCount = static_cast<int>(nodeTile.size());
+    const int startNode = nodeCount;
+    const int goalNode = nodeCount + 1;
+    if (static_cast<int>(abstractStamp.size()) < nodeCount + 2) {
+        abstractG.resize(nodeCount + 2);
+        abstractParent.resize(nodeCount + 2);
+        abstractStamp.resize(nodeCount + 2, 0);
+    }
+    if (static_cast<int>(goalLinkCost.size()) < nodeCount) {
+        goalLinkCost.resize(nodeCount, UNREACHABLE);
+        goalLinkTile.resize(nodeCount, -1);
+    }
+    collectApproaches(grid, goal);
+
+    // Start to its cluster's entrances, or straight to a goal approach in the same cluster
+    const Cluster& startC = clusters[startCluster];
+    searchCluster(grid, startC, start, -1, goal);
+    startCosts.resize(startC.nodeTiles.size());
+    for (size_t i = 0; i < startCosts.size(); ++i) {
+        startCosts[i] = localSearch.getCost(startC.nodeTiles[i]);
+    }
+    float directCost = UNREACHABLE;
+    int directTile = -1;
+    for (const auto& approach : approaches) {
+        if (approach.cluster == startCluster) {
+            const float cost = localSearch.getCost(approach.tile) + approach.cost;
+            if (cost < directCost) {
+                directCost = cost;
+                directTile = approach.tile;
+            }
+        }
+    }
+
+    // Entrances of the goal-side clusters to the goal
+    goalLinkedNodes.clear();
+    for (const auto& approach : approaches) {
+        const Cluster& c = clusters[approach.cluster];
+        searchCluster(grid, c, approach.tile, -1, goal);
+        const int first = clusterFirstNode[approach.cluster];
+        for (size_t i = 0; i < c.nodeTiles.size(); ++i) {
+            const int node = first + static_cast<int>(i);
+            const float cost = localSearch.getCost(c.nodeTiles[i]) + approach.cost;
+            if (cost < goalLinkCost[node]) {
+                if (goalLinkCost[node] == UNREACHABLE) {
+                    goalLinkedNodes.push_back(node);
+                }
+                goalLinkCost[node] = cost;
+                goalLinkTile[node] = approach.tile;
+            }
+        }
+    }
+
+    // A* over entrances plus two virtual nodes for start and goal
+    if (++abstractGeneration == 0) {
+        std::fill(abstractStamp.begin(), abstractStamp.end(), 0);
+        abstractGeneration = 1;
+    }
+    const int goalRow = grid.rowOf(goal);
+    const int goalCol = grid.colOf(goal);
+    auto heuristic = [&](int node) {
+        if (node == goalNode) {
+            return 0.0f;
+        }
+        const int tile = node == startNode ? start : nodeTile[node];
+        return octileDistance(grid.rowOf(tile) - goalRow, grid.colOf(tile) - goalCol);
+    };
+    const auto greater = std::greater<std::pair<float, int>>();
+    abstractOpen.clear();
+    auto relax = [&](int from, int to, float cost) {
+        if (cost == UNREACHABLE) {
+            return;
+        }
+        const float g = abstractG[from] + cost;
+        if (abstractStamp[to] != abstractGeneration || g < abstractG[to]) {
+            abstractStamp[to] = abstractGeneration;
+            abstractG[to] = g;
+            abstractParent[to] = from;
+            abstractOpen.emplace_back(g + heuristic(to), to);
+            std::push_heap(abstractOpen.begin(), abstractOpen.end(), greater);
+        }
+    };
+
+    abstractStamp[startNode] = abstractGeneration;
+    abstractG[startNode] = 0.0f;
+    abstractParent[startNode] = -1;
+    abstractOpen.emplace_back(heuristic(startNode), startNode);
+    bool found = false;
+    while (!abstractOpen.empty()) {
+        std::pop_heap(abstractOpen.begin(), abstractOpen.end(), greater);
+        const float f = abstractOpen.back().first;
+        const int current = abstractOpen.back().second;
+        abstractOpen.pop_back();
+        if (f > abstractG[current] + heuristic(current) + 1e-4f) {
+            continue; // Stale entry
+        }
+        ++lastExpansions;
+        if (current == goalNode) {
+            found = true;
+            break;
+        }
+        if (current == startNode) {
+            for (size_t i = 0; i < startCosts.size(); ++i) {
+                relax(current, clusterFirstNode[startCluster] + static_cast<int>(i), startCosts[i]);
+            }
+            relax(current, goalNode, directCost);
+            continue;
+        }
+        const int cluster = nodeCluster[current];
+        const int first = clusterFirstNode[cluster];
+        const int count = clusterFirstNode[cluster + 1] - first;
+        const int local = current - first;
+        const std::vector<float>& costs = clusters[cluster].costs;
+        for (int j = 0; j < count; ++j) {
+            if (j != local) {
+                relax(current, first + j, costs[local * count + j]);
+            }
+        }
+        for (const auto& edge : interEdges[current]) {
+            relax(current, edge.first, edge.second);
+        }
+        relax(current, goalNode, goalLinkCost[current]);
+    }
+
+    // Abstract route as tiles: start, entrances, the approach tile, goal
+    std::vector<int>& waypoints = waypointScratch;
+    waypoints.clear();
+    if (found) {
+        const int last = abstractParent[goalNode];
+        waypoints.push_back(goal);
+        waypoints.push_back(last == startNode ? directTile : goalLinkTile[last]);
+        for (int node = last; node != startNode; node = abstractParent[node]) {
+            waypoints.push_back(nodeTile[node]);
+        }
+        waypoints.push_back(start);
+        std::reverse(waypoints.begin(), waypoints.end());
+    }
+    for (int node : goalLinkedNodes) {
+        goalLinkCost[node] = UNREACHABLE;
+    }
+    if (!found) {
+        return false;
+    }
+
+    // Refine each hop inside its cluster
+    path.clear();
+    path.push_back(start);
+    for (size_t i = 1; i < waypoints.size(); ++i) {
+        if (!refineHop(grid, waypoints[i - 1], waypoints[i], goal, path)) {
+            path.clear();
+            return false;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,104 @@
+#ifndef HIERARCHICALPATHFINDER_HPP
+#define HIERARCHICALPATHFINDER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include "GridSearch.hpp"
+#include "TileGrid.hpp"
+
+// HPA*-style pathfinder for large maps. The grid is cut into square clusters;
+// open stretches along each cluster border become entrances, and the cost of
+// walking between a cluster's entrance tiles is precomputed. A query connects
+// start and goal to their clusters' entrances, searches the small abstract
+// graph, then refines each hop with a search confined to one cluster. Tile
+// changes only rebuild the clusters they touch.
+class HierarchicalPathfinder {
+public:
+    explicit HierarchicalPathfinder(int clusterSize = 16);
+
+    void build(const TileGrid& grid);
+    // Rebuilds the clusters containing the changed tiles (and refreshes the
+    // intra-cluster costs of neighbors whose shared border changed)
+    void applyChanges(const TileGrid& grid, const std::vector<int>& changedTiles);
+
+    // Same contract as GridAStar::findPath when the goal is reachable: writes
+    // tile indices start..goal and returns true. The goal may be blocked.
+    // Returns false with an empty path if no route exists.
+    bool findPath(const TileGrid& grid, int start, int goal, std::vector<int>& path);
+
+    int getClusterSize() const;
+    int getClusterCount() const;
+    size_t getAbstractNodeCount() const;
+    // Clusters rebuilt by the last applyChanges call
+    int getLastRebuiltClusters() const;
+    // Tiles and abstract nodes expanded by the last findPath
+    size_t getLastExpansions() const;
+
+private:
+    struct Entrance {
+        int first;  // Tile on the left/top side of the border
+        int second; // Tile on the right/bottom side
+    };
+
+    struct Cluster {
+        int rowBegin;
+        int colBegin;
+        int rowEnd; // Exclusive
+        int colEnd; // Exclusive
+        std::vector<int> nodeTiles;  // Entrance tiles inside this cluster
+        std::vector<float> costs;    // nodeTiles.size()^2 walking costs within the cluster
+    };
+
+    // Tile from which the query goal is entered, with the cost of that last step
+    struct Approach {
+        int cluster;
+        int tile;
+        float cost;
+    };
+
+    int clusterSize;
+    int clusterRows;
+    int clusterCols;
+    std::vector<Cluster> clusters;
+    std::vector<std::vector<Entrance>> rightBorders;  // Border with the cluster to the right
+    std::vector<std::vector<Entrance>> bottomBorders; // Border with the cluster below
+    int lastRebuiltClusters;
+    size_t lastExpansions;
+
+    // Flattened abstract graph, rebuilt lazily after cluster changes
+    bool graphDirty;
+    std::vector<int> nodeTile;
+    std::vector<int> nodeCluster;
+    std::vector<int> clusterFirstNode;
+    std::vector<int> tileToNode;
+    std::vector<std::vector<std::pair<int, float>>> interEdges;
+
+    // Scratch for searches confined to one cluster
+    GridSearchScratch localSearch;
+
+    // Scratch for the abstract search
+    std::vector<float> abstractG;
+    std::vector<int> abstractParent;
+    std::vector<std::uint32_t> abstractStamp;
+    std::uint32_t abstractGeneration;
+    std::vector<std::pair<float, int>> abstractOpen;
+    std::vector<Approach> approaches;
+    std::vector<float> startCosts;
+    std::vector<float> goalLinkCost; // Per node, UNREACHABLE unless linked to the current goal
+    std::vector<int> goalLinkTile;
+    std::vector<int> goalLinkedNodes;
+    std::vector<int> waypointScratch;
+
+    int clusterOf(const TileGrid& grid, int index) const;
+    void scanRightBorder(const TileGrid& grid, int cluster, std::vector<Entrance>& entrances) const;
+    void scanBottomBorder(const TileGrid& grid, int cluster, std::vector<Entrance>& entrances) const;
+    void buildClusterNodes(const TileGrid& grid, int cluster);
+    void rebuildGraph();
+    void searchCluster(const TileGrid& grid, const Cluster& cluster, int source, int target, int goal);
+    void collectApproaches(const TileGrid& grid, int goal);
+    bool refineHop(const TileGrid& grid, int from, int to, int goal, std::vector<int>& path);
+};
+
+#endif // HIERARCHICALPATHFINDER_HPP
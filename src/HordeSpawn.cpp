@@ -0,0 +1,94 @@
+// HordeSpawn.cpp
+#include "HordeSpawn.hpp"
+#include <algorithm>
+#include <iostream>
+
+HordeSpawn::HordeSpawn(const Map& map, UnitManager& units)
+    : units(units), active(false), reportTime(0.0f), reportFrames(0), totalMilliseconds(0.0f), worstMilliseconds(0.0f) {
+    presetTiles = map.getSpawnTiles();
+}
+
+void HordeSpawn::handleEvent(const sf::Event& event, Map& map) {
+    if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::H) {
+        spawnBatch(map);
+    }
+}
+
+bool HordeSpawn::isActive() const {
+    return active;
+}
+
+void HordeSpawn::spawnBatch(Map& map) {
+    const int alive = units.getUnits().size();
+    const int batch = std::min(BATCH_SIZE, MAX_UNITS - alive);
+    if (batch <= 0) {
+        std::cerr << "Horde already at " << alive << " units, the maximum is " << MAX_UNITS << ".\n";
+        return;
+    }
+
+    // One skeleton and one tank route per spawn tile, shared by the batch
+    struct Origin {
+        sf::Vector2f tile;
+        SharedPath skeletonPath;
+        SharedPath tankPath;
+        int tankWall;
+    };
+    std::vector<Origin> origins;
+    for (const TileCoordinates& spawnLocation : presetTiles) {
+        const Tile tile = map.getTile(spawnLocation.row, spawnLocation.col);
+        if (!tile || tile.getBuilding() || !map.hasPathToGoal(tile)) {
+            continue;
+        }
+        Origin origin;
+        origin.tile = IsometricUtils::tileToScreen(spawnLocation.row, spawnLocation.col);
+        Tile wall;
+        origin.skeletonPath = map.followSiegePath(tile, 0, wall);
+        if (origin.skeletonPath.empty()) {
+            origin.skeletonPath = map.followFlowField(tile, 0);
+        }
+        wall = Tile();
+        origin.tankPath = map.followSiegePath(tile, 2, wall);
+        if (origin.tankPath.empty()) {
+            origin.tankPath = map.followBreachPath(tile, 2, wall);
+        }
+        origin.tankWall = wall ? wall.getIndex() : -1;
+        origins.push_back(origin);
+    }
+    if (origins.empty()) {
+        std::cerr << "No spawn tile can reach the town hall, horde not spawned.\n";
+        return;
+    }
+
+    units.setLevelOfDetail(true);
+    active = true;
+    for (int i = 0; i < batch; ++i) {
+        const Origin& origin = origins[i % origins.size()];
+        if (i % TANK_EVERY == TANK_EVERY - 1) {
+            units.spawnTank(origin.tile.x, origin.tile.y + Tile::TILE_HEIGHT, origin.tankPath, origin.tankWall);
+        } else {
+            units.spawnSkeleton(origin.tile.x + Tile::TILE_WIDTH / 2.0f, origin.tile.y + Tile::TILE_HEIGHT, origin.skeletonPath);
+        }
+    }
+    std::cout << "Horde: spawned " << batch << " units from " << origins.size() << " spawn tiles, "
+              << units.getUnits().size() << " on the map.\n";
+}
+
+void HordeSpawn::recordFrame(float deltaTime, float frameMilliseconds) {
+    if (!active) {
+        return;
+    }
+    reportTime += deltaTime;
+    reportFrames++;
+    totalMilliseconds += frameMilliseconds;
+    worstMilliseconds = std::max(worstMilliseconds, frameMilliseconds);
+    if (reportTime < 1.0f) {
+        return;
+    }
+    std::cout << "Horde: " << units.getUnits().size() << " units, " << units.getCoarseCount() << " coarse, frame "
+              << totalMilliseconds / reportFrames << " ms average, " << worstMilliseconds << " ms worst"
+              << (worstMilliseconds > 16.0f ? " (over 16 ms)" : "") << ".\n";
+    reportTime = 0.0f;
+    reportFrames = 0;
+    totalMilliseconds = 0.0f;
+    worstMilliseconds = 0.0f;
+}
@@ -0,0 +1,38 @@
+#ifndef HORDESPAWN_HPP
+#define HORDESPAWN_HPP
+
+#include <SFML/Graphics.hpp>
+#include <vector>
+#include "Map.hpp"
+#include "IsometricUtils.hpp"
+#include "UnitManager.hpp"
+
+// Stress mode: every press of H drops another batch of skeletons and tanks on
+// the map's spawn tiles (the presets SkeletonSpawn and TankSpawn use) and
+// turns on simulation level of detail. While a horde is out the frame cost is
+// logged once a second, to see how many units fit in a 16 ms frame.
+class HordeSpawn {
+public:
+    static const int BATCH_SIZE = 10000;
+    static const int MAX_UNITS = 100000;
+    static const int TANK_EVERY = 10; // One unit in ten is a tank
+
+    HordeSpawn(const Map& map, UnitManager& units);
+    void handleEvent(const sf::Event& event, Map& map);
+    // Once per frame with the time spent updating and drawing it
+    void recordFrame(float deltaTime, float frameMilliseconds);
+    bool isActive() const;
+
+private:
+    UnitManager& units;
+    std::vector<TileCoordinates> presetTiles;
+    bool active;
+    float reportTime;
+    int reportFrames;
+    float totalMilliseconds;
+    float worstMilliseconds;
+
+    void spawnBatch(Map& map);
+};
+
+#endif // HORDESPAWN_HPP
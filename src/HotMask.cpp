@@ -0,0 +1,72 @@
+// HotMask.cpp
+#include "HotMask.hpp"
+#include "IsometricUtils.hpp"
+#include "PathSmoothing.hpp"
+#include "Tile.hpp"
+#include <algorithm>
+#include <cmath>
+
+void HotMask::reset(int size) {
+    hot.assign(size, 0);
+}
+
+int HotMask::size() const {
+    return static_cast<int>(hot.size());
+}
+
+// Only the tiles around centre are tested. Inverting tileToScreen, a screen
+// offset (dx, dy) is dx / W + dy / H columns and dy / H - dx / W rows for a
+// W x H tile, and by Cauchy-Schwarz neither exceeds d * sqrt(1/W^2 + 1/H^2)
+// for an offset of length d (0.035 d for 64 x 32). One more row and column
+// covers screenToTile flooring the centre's coordinates (and adding its row).
+void HotMask::stamp(const TileGrid& grid, const std::vector<sf::Vector2f>& positions, sf::Vector2f centre, float radius) {
+    const TileCoordinates origin = IsometricUtils::screenToTile(centre.x, centre.y, grid.getRows(), grid.getCols());
+    const float width = static_cast<float>(Tile::TILE_WIDTH);
+    const float height = static_cast<float>(Tile::TILE_HEIGHT);
+    const float tilesPerPixel = std::sqrt(1.0f / (width * width) + 1.0f / (height * height));
+    const int reach = static_cast<int>(std::ceil(radius * tilesPerPixel)) + 1;
+    const float radiusSquared = radius * radius;
+    for (int row = std::max(0, origin.row - reach); row <= std::min(grid.getRows() - 1, origin.row + reach); ++row) {
+        for (int col = std::max(0, origin.col - reach); col <= std::min(grid.getCols() - 1, origin.col + reach); ++col) {
+            const int tile = grid.index(row, col);
+            const sf::Vector2f offset = positions[tile] - centre;
+            if (offset.x * offset.x + offset.y * offset.y <= radiusSquared) {
+                hot[tile] = 1;
+            }
+        }
+    }
+}
+
+bool HotMask::isHot(int tile) const {
+    return tile < 0 || tile >= static_cast<int>(hot.size()) || hot[tile] != 0;
+}
+
+bool HotMask::isSegmentCold(const TileGrid& grid, int from, int to) const {
+    if (isHot(from) || isHot(to)) {
+        return false;
+    }
+    SegmentWalker walker;
+    walker.reset(grid, from, to);
+    for (int tile = walker.advance(1.0f); tile >= 0; tile = walker.advance(1.0f)) {
+        if (isHot(tile)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+float HotMask::coldWalkTime(const TileGrid& grid, const std::vector<sf::Vector2f>& positions, const SharedPath& path,
+                            std::uint32_t waypoint, int from, sf::Vector2f position, float speed, float limit) const {
+    float time = 0.0f;
+    for (; waypoint < path.size() && time < limit; ++waypoint) {
+        const int tile = path[waypoint];
+        if (grid.getType(tile) == TileType::Wall || !isSegmentCold(grid, from, tile)) {
+            break;
+        }
+        const sf::Vector2f offset = positions[tile] - position;
+        time += std::sqrt(offset.x * offset.x + offset.y * offset.y) / speed;
+        position = positions[tile];
+        from = tile;
+    }
+    return std::min(time, limit);
+}
@@ -0,0 +1,40 @@
+#ifndef HOTMASK_HPP
+#define HOTMASK_HPP
+
+#include <SFML/System/Vector2.hpp>
+#include <cstdint>
+#include <vector>
+#include "PathArena.hpp"
+#include "TileGrid.hpp"
+
+// Per-tile flags for SimulationLod: a tile is hot when its position is close
+// enough to a tower, a trap or the town hall that a unit on it needs the full
+// simulation. Tiles outside the grid count as hot. No SFML beyond the vector
+// type, so navtests can build one from a bare TileGrid.
+class HotMask {
+public:
+    // Clears the mask for a grid of size tiles
+    void reset(int size);
+    int size() const;
+
+    // Marks every tile in positions (indexed by TileGrid index) that lies
+    // within radius of centre
+    void stamp(const TileGrid& grid, const std::vector<sf::Vector2f>& positions, sf::Vector2f centre, float radius);
+
+    bool isHot(int tile) const;
+    // True if no tile the straight segment between the centres of from and
+    // to crosses is hot, both ends included. A smoothed path segment can run
+    // across many tiles between its waypoints, any of them near a tower.
+    bool isSegmentCold(const TileGrid& grid, int from, int to) const;
+    // Seconds a unit at position, on the segment from tile from to
+    // path[waypoint], can walk at speed before it needs the full simulation:
+    // arrival at the last waypoint before a segment that is not cold or ends
+    // on a wall. Gives up at limit.
+    float coldWalkTime(const TileGrid& grid, const std::vector<sf::Vector2f>& positions, const SharedPath& path,
+                       std::uint32_t waypoint, int from, sf::Vector2f position, float speed, float limit) const;
+
+private:
+    std::vector<std::uint8_t> hot; // Indexed by TileGrid index
+};
+
+#endif // HOTMASK_HPP
@@ -0,0 +1,331 @@
+// JumpPointSearch.cpp
+#include "JumpPointSearch.hpp"
+#include "GridConnectivity.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+
+// Straight directions, in the order of straightJump
+static const int STRAIGHT_D_ROW[4] = {0, 0, 1, -1};
+static const int STRAIGHT_D_COL[4] = {1, -1, 0, 0};
+
+static int straightDirection(int dRow, int dCol) {
+    if (dRow == 0) {
+        return dCol > 0 ? 0 : 1;
+    }
+    return dRow > 0 ? 2 : 3;
+}
+
+static int sign(int value) {
+    return (value > 0) - (value < 0);
+}
+
+static float octileDistance(int dRow, int dCol) {
+    dRow = std::abs(dRow);
+    dCol = std::abs(dCol);
+    return static_cast<float>(dRow + dCol) + (DIAGONAL_STEP_COST - 2.0f) * static_cast<float>(std::min(dRow, dCol));
+}
+
+// A tile reached by a straight move is a jump point if a tile beside it is open
+// while the tile behind that one is not; with no corner cutting that side tile
+// can only be reached well through here
+template <typename Walkable>
+static bool hasForcedNeighbor(int row, int col, int dRow, int dCol, Walkable&& walkable) {
+    if (dRow == 0) {
+        return (walkable(row - 1, col) && !walkable(row - 1, col - dCol)) ||
+               (walkable(row + 1, col) && !walkable(row + 1, col - dCol));
+    }
+    return (walkable(row, col - 1) && !walkable(row - dRow, col - 1)) ||
+           (walkable(row, col + 1) && !walkable(row - dRow, col + 1));
+}
+
+JumpPointSearch::JumpPointSearch() : generation(0), lastExpansions(0), goal(-1) {}
+
+size_t JumpPointSearch::getLastExpansions() const {
+    return lastExpansions;
+}
+
+// Fills the jump distances along one row (right/left) or column (down/up),
+// scanning backwards so each tile extends the run of the tile after it
+void JumpPointSearch::rebuildRow(const TileGrid& grid, int row) {
+    auto open = [&](int r, int c) { return grid.inBounds(r, c) && !grid.isBlocked(grid.index(r, c)); };
+    const int cols = grid.getCols();
+    for (int direction = 0; direction < 2; ++direction) {
+        const int dCol = STRAIGHT_D_COL[direction];
+        std::vector<int>& table = straightJump[direction];
+        int after = -1; // Entry of the tile after this one; off the grid counts as blocked
+        for (int step = 0; step < cols; ++step) {
+            const int col = dCol > 0 ? cols - 1 - step : step;
+            int entry;
+            if (!open(row, col)) {
+                entry = -1;
+            } else if (hasForcedNeighbor(row, col, 0, dCol, open)) {
+                entry = 0;
+            } else {
+                entry = after >= 0 ? after + 1 : after - 1;
+            }
+            table[grid.index(row, col)] = entry;
+            after = entry;
+        }
+    }
+}
+
+void JumpPointSearch::rebuildColumn(const TileGrid& grid, int col) {
+    auto open = [&](int r, int c) { return grid.inBounds(r, c) && !grid.isBlocked(grid.index(r, c)); };
+    const int rows = grid.getRows();
+    for (int direction = 2; direction < 4; ++direction) {
+        const int dRow = STRAIGHT_D_ROW[direction];
+        std::vector<int>& table = straightJump[direction];
+        int after = -1;
+        for (int step = 0; step < rows; ++step) {
+            const int row = dRow > 0 ? rows - 1 - step : step;
+            int entry;
+            if (!open(row, col)) {
+                entry = -1;
+            } else if (hasForcedNeighbor(row, col, dRow, 0, open)) {
+                entry = 0;
+            } else {
+                entry = after >= 0 ? after + 1 : after - 1;
+            }
+            table[grid.index(row, col)] = entry;
+            after = entry;
+        }
+    }
+}
+
+void JumpPointSearch::build(const TileGrid& grid) {
+    for (auto& table : straightJump) {
+        table.assign(grid.size(), -1);
+    }
+    for (int row = 0; row < grid.getRows(); ++row) {
+        rebuildRow(grid, row);
+    }
+    for (int col = 0; col < grid.getCols(); ++col) {
+        rebuildColumn(grid, col);
+    }
+}
+
+// A tile's block status feeds the forced-neighbor test of the rows and
+// columns next to it, so those are recomputed along with its own
+void JumpPointSearch::applyChanges(const TileGrid& grid, const std::vector<int>& changedTiles) {
+    if (static_cast<int>(straightJump[0].size()) != grid.size()) {
+        build(grid);
+        return;
+    }
+    std::vector<int> rows;
+    std::vector<int> cols;
+    for (int changed : changedTiles) {
+        for (int offset = -1; offset <= 1; ++offset) {
+            rows.push_back(grid.rowOf(changed) + offset);
+            cols.push_back(grid.colOf(changed) + offset);
+        }
+    }
+    std::sort(rows.begin(), rows.end());
+    rows.erase(std::unique(rows.begin(), rows.end()), rows.end());
+    std::sort(cols.begin(), cols.end());
+    cols.erase(std::unique(cols.begin(), cols.end()), cols.end());
+    for (int row : rows) {
+        if (row >= 0 && row < grid.getRows()) {
+            rebuildRow(grid, row);
+        }
+    }
+    for (int col : cols) {
+        if (col >= 0 && col < grid.getCols()) {
+            rebuildColumn(grid, col);
+        }
+    }
+}
+
+bool JumpPointSearch::isWalkable(const TileGrid& grid, int row, int col) const {
+    if (!grid.inBounds(row, col)) {
+        return false;
+    }
+    const int index = grid.index(row, col);
+    return index == goal || !grid.isBlocked(index);
+}
+
+// Jump point reached by moving straight from (row, col) inclusive, or -1
+int JumpPointSearch::jumpStraight(const TileGrid& grid, int row, int col, int dRow, int dCol) const {
+    const int goalRow = grid.rowOf(goal);
+    const int goalCol = grid.colOf(goal);
+    const bool nearGoal = dRow == 0 ? std::abs(row - goalRow) <= 1 : std::abs(col - goalCol) <= 1;
+    if (!nearGoal) {
+        // The goal cannot affect this run, so the precomputed distance holds
+        if (!grid.inBounds(row, col)) {
+            return -1;
+        }
+        const int entry = straightJump[straightDirection(dRow, dCol)][grid.index(row, col)];
+        return entry >= 0 ? grid.index(row + entry * dRow, col + entry * dCol) : -1;
+    }
+    auto walkable = [&](int r, int c) { return isWalkable(grid, r, c); };
+    while (walkable(row, col)) {
+        const int index = grid.index(row, col);
+        if (index == goal || hasForcedNeighbor(row, col, dRow, dCol, walkable)) {
+            return index;
+        }
+        row += dRow;
+        col += dCol;
+    }
+    return -1;
+}
+
+// Jump point reached by moving diagonally from (row, col) inclusive, or -1.
+// A diagonal tile is a jump point when a straight scan from it finds one.
+int JumpPointSearch::jumpDiagonal(const TileGrid& grid, int row, int col, int dRow, int dCol) const {
+    while (isWalkable(grid, row, col)) {
+        const int index = grid.index(row, col);
+        if (index == goal ||
+            jumpStraight(grid, row, col + dCol, 0, dCol) >= 0 ||
+            jumpStraight(grid, row + dRow, col, dRow, 0) >= 0) {
+            return index;
+        }
+        // No cutting corners
+        if (!isWalkable(grid, row, col + dCol) || !isWalkable(grid, row + dRow, col)) {
+            return -1;
+        }
+        row += dRow;
+        col += dCol;
+    }
+    return -1;
+}
+
+bool JumpPointSearch::findPath(const TileGrid& grid, int start, int goalTile, std::vector<int>& path) {
+    path.clear();
+    lastExpansions = 0;
+    if (static_cast<int>(straightJump[0].size()) != grid.size()) {
+        build(grid);
+    }
+    if (static_cast<int>(stamp.size()) < grid.size()) {
+        g.resize(grid.size());
+        parent.resize(grid.size());
+        stamp.resize(grid.size(), 0);
+        closed.resize(grid.size(), 0);
+    }
+    if (++generation == 0) {
+        std::fill(stamp.begin(), stamp.end(), 0);
+        std::fill(closed.begin(), closed.end(), 0);
+        generation = 1;
+    }
+    goal = goalTile;
+    const int goalRow = grid.rowOf(goal);
+    const int goalCol = grid.colOf(goal);
+    const auto greater = std::greater<std::pair<float, int>>();
+
+    open.clear();
+    stamp[start] = generation;
+    g[start] = 0.0f;
+    parent[start] = -1;
+    open.emplace_back(octileDistance(grid.rowOf(start) - goalRow, grid.colOf(start) - goalCol), start);
+
+    bool found = false;
+    while (!open.empty()) {
+        std::pop_heap(open.begin(), open.end(), greater);
+        const int current = open.back().second;
+        open.pop_back();
+        if (closed[current] == generation) {
+            continue; // Stale entry
+        }
+        closed[current] = generation;
+        ++lastExpansions;
+        if (current == goal) {
+            found = true;
+            break;
+        }
+
+        const int row = grid.rowOf(current);
+        const int col = grid.colOf(current);
+        auto walkable = [&](int dRow, int dCol) { return isWalkable(grid, row + dRow, col + dCol); };
+        auto visit = [&](int dRow, int dCol) {
+            const int next = dRow != 0 && dCol != 0
+                ? jumpDiagonal(grid, row + dRow, col + dCol, dRow, dCol)
+                : jumpStraight(grid, row + dRow, col + dCol, dRow, dCol);
+            if (next < 0 || closed[next] == generation) {
+                return;
+            }
+            const int nextRow = grid.rowOf(next);
+            const int nextCol = grid.colOf(next);
+            const float cost = g[current] + octileDistance(nextRow - row, nextCol - col);
+            if (stamp[next] != generation || cost < g[next]) {
+                stamp[next] = generation;
+                g[next] = cost;
+                parent[next] = current;
+                open.emplace_back(cost + octileDistance(nextRow - goalRow, nextCol - goalCol), next);
+                std::push_heap(open.begin(), open.end(), greater);
+            }
+        };
+
+        if (parent[current] == -1) {
+            for (int direction = 0; direction < EightWayConnectivity::count; ++direction) {
+                const int dRow = EightWayConnectivity::dRow[direction];
+                const int dCol = EightWayConnectivity::dCol[direction];
+                if (dRow == 0 || dCol == 0 || (walkable(dRow, 0) && walkable(0, dCol))) {
+                    visit(dRow, dCol);
+                }
+            }
+            continue;
+        }
+
+        // Pruned neighbors: only directions a path arriving from parent could need
+        const int dRow = sign(row - grid.rowOf(parent[current]));
+        const int dCol = sign(col - grid.colOf(parent[current]));
+        if (dRow != 0 && dCol != 0) {
+            const bool rowOpen = walkable(dRow, 0);
+            const bool colOpen = walkable(0, dCol);
+            if (rowOpen) {
+                visit(dRow, 0);
+            }
+            if (colOpen) {
+                visit(0, dCol);
+            }
+            if (rowOpen && colOpen) {
+                visit(dRow, dCol);
+            }
+        } else {
+            // Sides perpendicular to the direction of travel
+            const int sideRow = dCol;
+            const int sideCol = dRow;
+            const bool aheadOpen = walkable(dRow, dCol);
+            const bool leftOpen = walkable(sideRow, sideCol);
+            const bool rightOpen = walkable(-sideRow, -sideCol);
+            if (aheadOpen) {
+                visit(dRow, dCol);
+                if (leftOpen) {
+                    visit(dRow + sideRow, dCol + sideCol);
+                }
+                if (rightOpen) {
+                    visit(dRow - sideRow, dCol - sideCol);
+                }
+            }
+            if (leftOpen) {
+                visit(sideRow, sideCol);
+            }
+            if (rightOpen) {
+                visit(-sideRow, -sideCol);
+            }
+        }
+    }
+    if (!found) {
+        return false;
+    }
+
+    // Jump points back to start, then fill in the straight/diagonal runs between them
+    for (int current = goal; current != -1; current = parent[current]) {
+        path.push_back(current);
+    }
+    std::reverse(path.begin(), path.end());
+    jumpPoints.swap(path);
+    path.clear();
+    path.push_back(jumpPoints[0]);
+    for (size_t i = 1; i < jumpPoints.size(); ++i) {
+        int row = grid.rowOf(jumpPoints[i - 1]);
+        int col = grid.colOf(jumpPoints[i - 1]);
+        const int dRow = sign(grid.rowOf(jumpPoints[i]) - row);
+        const int dCol = sign(grid.colOf(jumpPoints[i]) - col);
+        while (grid.index(row, col) != jumpPoints[i]) {
+            row += dRow;
+            col += dCol;
+            path.push_back(grid.index(row, col));
+        }
+    }
+    return true;
+}
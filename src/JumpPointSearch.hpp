@@ -0,0 +1,52 @@
+#ifndef JUMPPOINTSEARCH_HPP
+#define JUMPPOINTSEARCH_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include "TileGrid.hpp"
+
+// Jump Point Search over a uniform-cost eight-way TileGrid, with the same
+// movement rules as GridAStar (no cutting corners, the goal may be blocked).
+// Only jump points are put on the open list, so long straight and diagonal
+// runs cost a scan instead of one expansion per tile. Straight scans read
+// precomputed jump distances (as in JPS+); a tile change only recomputes the
+// rows and columns next to it.
+class JumpPointSearch {
+public:
+    JumpPointSearch();
+
+    void build(const TileGrid& grid);
+    void applyChanges(const TileGrid& grid, const std::vector<int>& changedTiles);
+
+    // Writes tile indices start..goal and returns true, like GridAStar::findPath.
+    // Returns false with an empty path if the goal is unreachable.
+    bool findPath(const TileGrid& grid, int start, int goal, std::vector<int>& path);
+
+    // Jump points expanded by the last query
+    size_t getLastExpansions() const;
+
+private:
+    // Per straight direction (right, left, down, up) and tile: steps to the next
+    // jump point (>= 0), or -(steps + 1) to the blocked tile or edge ending the run
+    std::vector<int> straightJump[4];
+
+    std::vector<float> g;
+    std::vector<int> parent;
+    std::vector<std::uint32_t> stamp;  // g/parent valid when stamp == generation
+    std::vector<std::uint32_t> closed; // Expanded when closed == generation
+    std::vector<std::pair<float, int>> open; // Min-heap of (f, tile)
+    std::vector<int> jumpPoints;
+    std::uint32_t generation;
+    size_t lastExpansions;
+    int goal; // Goal of the running query
+
+    void rebuildRow(const TileGrid& grid, int row);
+    void rebuildColumn(const TileGrid& grid, int col);
+    bool isWalkable(const TileGrid& grid, int row, int col) const;
+    int jumpStraight(const TileGrid& grid, int row, int col, int dRow, int dCol) const;
+    int jumpDiagonal(const TileGrid& grid, int row, int col, int dRow, int dCol) const;
+};
+
+#endif // JUMPPOINTSEARCH_HPP
@@ -1,26 +1,38 @@
 // Map.cpp
 #include "Map.hpp"
 #include "IsometricUtils.hpp"
+#include "GridAStar.hpp"
+#include "GridConnectivity.hpp"
+#include "PathSmoothing.hpp"
 #include <iostream>
 #include <optional>
-#include <queue>
-#include <tuple>
-#include <set>
 #include <random>
 
 
 Map::Map(int rows, int cols, BulletManager& centralBulletManager)
- : rows(rows), cols(cols), nextBuildingId(1), nextTowerId(1), centralBulletManager(centralBulletManager) {
+ : rows(rows), cols(cols), nextBuildingId(1), nextTowerId(1), tiles(std::make_unique<TileStore>()), centralBulletManager(centralBulletManager),
+   pathSmoothing(true), pathRequestMode(PathRequestMode::Threaded) {
     initializeTiles();
+
+    // Enemies spawn on the map edge
+    for (int i = 0; i < rows; ++i) {
+        spawnTiles.push_back(TileCoordinates{i, 0});
+        spawnTiles.push_back(TileCoordinates{i, cols - 1});
+    }
+    for (int j = 0; j < cols; ++j) {
+        spawnTiles.push_back(TileCoordinates{0, j});
+        spawnTiles.push_back(TileCoordinates{rows - 1, j});
+    }
     
-    // Place the Town Hall at tile (14, 14)
-    // Ensure that (14,14) is within the map boundaries
-    bool townHallPlaced = addBuilding(14, 14, "../assets/buildings/townhall.png");
+    // Place the Town Hall in the middle of the map ((14, 14) on a 30x30 map)
+    TileCoordinates townHall = {rows / 2 - 1, cols / 2 - 1};
+    bool townHallPlaced = addBuilding(townHall.row, townHall.col, "../assets/buildings/townhall.png");
     if (townHallPlaced) {
-        std::cout << "Town hall visually placed at (14, 14).\n";
+        std::cout << "Town hall visually placed at (" << townHall.row << ", " << townHall.col << ").\n";
     } else {
-        std::cerr << "Failed to place town hall at (14, 14).\n";
+        std::cerr << "Failed to place town hall at (" << townHall.row << ", " << townHall.col << ").\n";
     }
+    setGoalTiles({townHall});
     
     saveState(); // Save the initial state
 }
@@ -33,47 +45,47 @@ void Map::initializeTiles() {
     // Suppose you have 18 different grass textures (0-17)
     std::uniform_int_distribution<> distr(0, 17);
     
-    // Resize the tiles vector
-    tiles.resize(rows, std::vector<std::shared_ptr<Tile>>(cols, nullptr));
+    // Allocate the flat tile store (all tiles start as grass)
+    tiles->resize(rows, cols);
     
     // Iterate over each tile position
     for (int row = 0; row < rows; ++row) {
         for (int col = 0; col < cols; ++col) {
+            Tile tile = getTile(row, col);
             // Initialize grass tiles with a random index
-            tiles[row][col] = std::make_shared<Tile>(row, col, TileType::Grass);
             int randomIndex = distr(eng); // Generate a random tile index
-            tiles[row][col]->setGrassTileIndex(randomIndex); // Assign the random index
+            tile.setGrassTileIndex(randomIndex); // Assign the random index
             
             // Set the tile’s isometric position
             sf::Vector2f isoPos = IsometricUtils::tileToScreen(row, col);
-            tiles[row][col]->setPosition(isoPos.x, isoPos.y);
-        }
-    }
-    
-    // Add edges between neighboring tiles
-    for (int row = 0; row < rows; ++row) {
-        for (int col = 0; col < cols; ++col) {
-            auto tile = tiles[row][col];
-            if (row > 0) {
-                tile->addEdge(tiles[row - 1][col]); // Up
-                if (col > 0) tile->addEdge(tiles[row - 1][col - 1]); // Up-Left
-                if (col < cols - 1) tile->addEdge(tiles[row - 1][col + 1]); // Up-Right
-            }
-            if (row < rows - 1) {
-                tile->addEdge(tiles[row + 1][col]); // Down
-                if (col > 0) tile->addEdge(tiles[row + 1][col - 1]); // Down-Left
-                if (col < cols - 1) tile->addEdge(tiles[row + 1][col + 1]); // Down-Right
-            }
-            if (col > 0) tile->addEdge(tiles[row][col - 1]); // Left
-            if (col < cols - 1) tile->addEdge(tiles[row][col + 1]); // Right
+            tile.setPosition(isoPos.x, isoPos.y);
         }
     }
+    // Adjacency is implicit in the grid (see GridConnectivity.hpp)
 }
 
-std::shared_ptr<Tile> Map::getTile(int row, int col) const {
+Tile Map::getTile(int row, int col) const {
     if (row < 0 || row >= rows || col < 0 || col >= cols)
-        return nullptr;
-    return tiles[row][col];
+        return Tile();
+    return Tile(tiles.get(), tiles->grid.index(row, col));
+}
+
+Tile Map::getTileAt(int index) const {
+    if (index < 0 || index >= tiles->grid.size())
+        return Tile();
+    return Tile(tiles.get(), index);
+}
+
+sf::Vector2f Map::getTilePosition(int index) const {
+    return tiles->positions[index];
+}
+
+const std::vector<sf::Vector2f>& Map::getTilePositions() const {
+    return tiles->positions;
+}
+
+const TileGrid& Map::getGrid() const {
+    return tiles->grid;
 }
 
 bool Map::addBuilding(int row, int col, const std::string& buildingTexture) {
@@ -82,14 +94,22 @@ bool Map::addBuilding(int row, int col, const std::string& buildingTexture) {
         std::cerr << "Invalid tile coordinates: (" << row << ", " << col << ").\n";
         return false;
     }
-    if (tile->getBuilding() != nullptr || tile->getTower() != nullptr) {
+    if (tile.getBuilding() != nullptr || tile.getTower() != nullptr) {
         std::cerr << "Tile already has a building or tower.\n";
         return false;
     }
-    if (tile->isBlocked()) {
+    if (tile.isBlocked()) {
         std::cerr << "Cannot place a building on a blocked tile.\n";
         return false;
     }
+    // Walls may close the town hall in, since units breach them (see
+    // getSiegePlanner and canBlockTile); anything else must leave the spawn
+    // tiles a way through
+    if (buildingTexture != "../assets/buildings/moontower.png" && buildingTexture != "../assets/walls/brick_wall.png" &&
+        !canBlockTile(row, col)) {
+        std::cerr << "A building at (" << row << ", " << col << ") would cut the spawn tiles off from the town hall.\n";
+        return false;
+    }
     sf::Vector2f isoPos = IsometricUtils::tileToScreen(row, col);
     if (buildingTexture == "../assets/buildings/moontower.png") {
         // Handle tower placement within MapScreen
@@ -99,13 +119,13 @@ bool Map::addBuilding(int row, int col, const std::string& buildingTexture) {
         // auto building = std::make_shared<Building>(nextBuildingId++, isoPos.x, isoPos.y, buildingTexture);
         // auto building = std::make_shared<Building>(nextBuildingId++, row, col, buildingTexture);
 
-        // tile->setBuilding(building);
+        // tile.setBuilding(building);
     } else {
         // auto building = std::make_shared<Building>(nextBuildingId++, isoPos.x, isoPos.y, buildingTexture);
         auto building = std::make_shared<Building>(nextBuildingId++, row, col, buildingTexture);
 
-        tile->setBuilding(building);
-        tile->setBlockStatus(true); // Block the tile after placing the building
+        tile.setBuilding(building);
+        tile.setBlockStatus(true); // Block the tile after placing the building
         if (buildingTexture == "../assets/buildings/townhall.png") {
             if (row < 0 || row >= rows || col < 0 || col >= cols) {
                 std::cerr << "Invalid tile coordinates for town hall placement.\n";
@@ -114,19 +134,19 @@ bool Map::addBuilding(int row, int col, const std::string& buildingTexture) {
             
             sf::Vector2f buildingPosition = IsometricUtils::tileToScreen(row, col);
             auto building = std::make_shared<Building>(nextBuildingId++, row, col, buildingTexture);
-            auto tile = getTile(row, col);
+            Tile tile = getTile(row, col);
                         
             if (tile) {
-                tile->setBuilding(building);
-                tile->setBlockStatus(true);
-                tile->setPosition(buildingPosition.x, buildingPosition.y);
+                tile.setBuilding(building);
+                tile.setBlockStatus(true);
+                tile.setPosition(buildingPosition.x, buildingPosition.y);
             }
         }
         if (buildingTexture == "../assets/walls/brick_wall.png") {
             // std::cout << "Wall placed at tile: (" << row << ", " << col << ").\n";
-            tile->setBuilding(building);
-            tile->setType(TileType::Wall);
-            tile->setHealth(100); // Set wall health
+            tile.setBuilding(building);
+            tile.setType(TileType::Wall);
+            tile.setHealth(100); // Set wall health
         }
          // TRAPS
         if (buildingTexture == "../assets/traps/BarrelBomb/barrel.png" || buildingTexture == "../assets/buildings/mushroom1.png") {
@@ -145,11 +165,12 @@ bool Map::addWall(int row, int col) {
         std::cerr << "Invalid tile coordinates: (" << row << ", " << col << ").\n";
         return false;
     }
-    if (tile->getBuilding() != nullptr) {
+    if (tile.getBuilding() != nullptr) {
         std::cerr << "Tile already has a building.\n";
         return false;
     }
-    tile->setType(TileType::Wall);
+    // No canBlockTile check: a wall never cuts the spawn tiles off
+    tile.setType(TileType::Wall);
     saveState();
     return true;
 }
@@ -160,22 +181,26 @@ bool Map::addTower(int row, int col, const std::string& selectedBuildingTexture)
         std::cerr << "Invalid tile coordinates: (" << row << ", " << col << ").\n";
         return false;
     }
-    if (tile->getBuilding() != nullptr) {
+    if (tile.getBuilding() != nullptr) {
         std::cerr << "Tile already has a building.\n";
         return false;
     }
-    if (tile->getTower() != nullptr) {
+    if (tile.getTower() != nullptr) {
         std::cerr << "Tile already has a tower.\n";
         return false;
     }
-    if (tile->isBlocked()) {
+    if (tile.isBlocked()) {
         std::cerr << "Cannot place a tower on a blocked tile.\n";
         return false;
     }
+    if (!canBlockTile(row, col)) {
+        std::cerr << "A tower at (" << row << ", " << col << ") would cut the spawn tiles off from the town hall.\n";
+        return false;
+    }
     sf::Vector2f newTowerPos = IsometricUtils::tileToScreen(row, col);
     std::shared_ptr<Tower> newTower = std::make_shared<Tower>(nextTowerId++, newTowerPos, 200.0f, 1.0f, centralBulletManager, selectedBuildingTexture);
     towers.push_back(newTower);
-    tile->setTower(newTower);
+    tile.setTower(newTower);
 
     std::cout << "Tower placed at tile: (" << row << ", " << col << "). Saving state...\n";
     saveState();
@@ -184,10 +209,8 @@ bool Map::addTower(int row, int col, const std::string& selectedBuildingTexture)
 }
 
 void Map::draw(sf::RenderWindow& window) const {
-    for (const auto& row : tiles) {
-        for (const auto& tile : row) {
-            tile->draw(window);
-        }
+    for (int index = 0; index < tiles->grid.size(); ++index) {
+        Tile(tiles.get(), index).draw(window);
     }
 }
 
@@ -209,11 +232,11 @@ void Map::saveToFile(const std::string& filename) {
     for (int row = 0; row < rows; ++row) {
         for (int col = 0; col < cols; ++col) {
             auto tile = getTile(row, col);
-            outFile << static_cast<int>(tile->getType()) << " "
-                    << tile->getTexturePath() << " "
-                    << tile->getGrassTileIndex() << " "; // Save grass tile index
+            outFile << static_cast<int>(tile.getType()) << " "
+                    << tile.getTexturePath() << " "
+                    << tile.getGrassTileIndex() << " "; // Save grass tile index
 
-            auto building = tile->getBuilding();
+            auto building = tile.getBuilding();
             if (building) {
                 outFile << building->getId() << " "
                         << building->getTexturePath() << "\n";
@@ -233,18 +256,19 @@ void Map::loadFromFile(const std::string& filename) {
         return;
     }
     inFile >> rows >> cols;
-    tiles.clear();
-    tiles.resize(rows, std::vector<std::shared_ptr<Tile>>(cols, nullptr));
+    tiles->resize(rows, cols);
     
     int tileType, buildingId, grassIndex;
     std::string texturePath;
     for (int row = 0; row < rows; ++row) {
         for (int col = 0; col < cols; ++col) {
             inFile >> tileType >> texturePath >> grassIndex >> buildingId;
-            auto tile = getTile(row, col);
-            tile->setTexturePath(texturePath);
-            tile->setType(static_cast<TileType>(tileType));
-            tile->setGrassTileIndex(grassIndex); // Load grass tile index
+            Tile tile = getTile(row, col);
+            sf::Vector2f tilePos = IsometricUtils::tileToScreen(row, col);
+            tile.setPosition(tilePos.x, tilePos.y);
+            tile.setTexturePath(texturePath);
+            tile.setType(static_cast<TileType>(tileType));
+            tile.setGrassTileIndex(grassIndex); // Load grass tile index
             
             if (buildingId != -1) {
                 inFile >> texturePath; // Read the building texture path
@@ -256,20 +280,21 @@ void Map::loadFromFile(const std::string& filename) {
                 auto building = std::make_shared<Building>(
                     buildingId, buildingPosition.x, buildingPosition.y, texturePath
                 );
-                tile->setBuilding(building);
+                tile.setBuilding(building);
             } else {
-                tile->setBuilding(nullptr);
+                tile.setBuilding(nullptr);
             }
         }
     }
     std::cout << "Map loaded successfully from " << filename << std::endl;
     inFile.close();
+    rebuildNavigation();
     saveState();
 }
 
 
 void Map::saveState() {
-    GameState currentState(tiles);
+    GameState currentState(*tiles);
     stateManager.saveState(currentState);
 }
 
@@ -302,9 +327,9 @@ void Map::redo() {
 //             auto tile = tiles[row][col];
 //             const auto& tileState = tileStates[row][col];
 //             if (tile) {
-//                 tile->setTexturePath(tileState.texturePath); // Set texture first
-//                 tile->setType(tileState.type); // Then set type
-//                 tile->setGrassTileIndex(tileState.grassIndex); // Restore grass index
+//                 tile.setTexturePath(tileState.texturePath); // Set texture first
+//                 tile.setType(tileState.type); // Then set type
+//                 tile.setGrassTileIndex(tileState.grassIndex); // Restore grass index
 //                 if (tileState.buildingId != -1) {
 //                     // Recreate Building object with stored data
 //                     sf::Vector2f isoPos = IsometricUtils::tileToScreen(row, col);
@@ -315,16 +340,16 @@ void Map::redo() {
 //                     auto building = std::make_shared<Building>(
 //                         tileState.buildingId, buildingPosition.x, buildingPosition.y, tileState.buildingTexturePath
 //                     );
-//                     tile->setBuilding(building);
+//                     tile.setBuilding(building);
 //                 } else {
-//                     tile->setBuilding(nullptr);
+//                     tile.setBuilding(nullptr);
 //                 }
 //             }
 //             // Debugging output to verify restoration
-//             std::cout << "Tile (" << tile->getRow() << ", " << tile->getCol() << ") Type: "
-//                       << static_cast<int>(tile->getType()) << ", Blocked: "
-//                       << tile->isBlocked() << ", GrassIndex: "
-//                       << tile->getGrassTileIndex() << "\n";
+//             std::cout << "Tile (" << tile.getRow() << ", " << tile.getCol() << ") Type: "
+//                       << static_cast<int>(tile.getType()) << ", Blocked: "
+//                       << tile.isBlocked() << ", GrassIndex: "
+//                       << tile.getGrassTileIndex() << "\n";
 //         }
 //     }
 // }
@@ -333,107 +358,81 @@ void Map::restoreGameState(const GameState& state) {
     const auto& tileStates = state.getTileStates();
     for (size_t row = 0; row < rows; ++row) {
         for (size_t col = 0; col < cols; ++col) {
-            auto tile = tiles[row][col];
-            const auto& tileState = tileStates[row][col];
+            Tile tile = getTile(row, col);
+            const auto& tileState = tileStates[tiles->grid.index(row, col)];
             if (tile) {
-                tile->setTexturePath(tileState.texturePath); // Set texture first
-                tile->setType(tileState.type); // Then set type
-                tile->setGrassTileIndex(tileState.grassIndex); // Restore grass index
+                tile.setTexturePath(tileState.texturePath); // Set texture first
+                tile.setType(tileState.type); // Then set type
+                tile.setGrassTileIndex(tileState.grassIndex); // Restore grass index
                 if (tileState.buildingId != -1) {
                     auto building = std::make_shared<Building>(
                         tileState.buildingId, row, col, tileState.buildingTexturePath
                     );
-                    tile->setBuilding(building);
+                    tile.setBuilding(building);
                 } else {
-                    tile->setBuilding(nullptr);
+                    tile.setBuilding(nullptr);
                 }
                 if (tileState.hasTrap) {
                     auto trap = std::make_shared<Trap>(tileState.trapTexturePath);
-                    tile->setTrap(trap);
+                    tile.setTrap(trap);
                 } else {
-                    tile->setTrap(nullptr);
+                    tile.setTrap(nullptr);
                 }
                 if (tileState.hasTower) {
                     // std::cout << "Tower placed at tile: (" << row << ", " << col << ").\n";
                     auto tower = std::make_shared<Tower>(
                         tileState.towerId, sf::Vector2f(), 200.0f, 1.0f, centralBulletManager, tileState.towerTexturePath
                     );
-                    tile->setTower(tower);
+                    tile.setTower(tower);
                 } else {
-                    tile->setTower(nullptr);
+                    tile.setTower(nullptr);
                 }
                 if (tileState.hasWall) {
-                    tile->setType(TileType::Wall);
-                    tile->setBlockStatus(true); // Block the tile after placing the building
-                    tile->setHealth(100); // Set wall health
+                    tile.setType(TileType::Wall);
+                    tile.setBlockStatus(true); // Block the tile after placing the building
+                    tile.setHealth(100); // Set wall health
                 }
             }
             // // Debugging output to verify restoration
-            // std::cout << "Tile (" << tile->getRow() << ", " << tile->getCol() << ") Type: "
-            //           << static_cast<int>(tile->getType()) << ", Blocked: "
-            //           << tile->isBlocked() << ", GrassIndex: "
-            //           << tile->getGrassTileIndex() << "\n";
+            // std::cout << "Tile (" << tile.getRow() << ", " << tile.getCol() << ") Type: "
+            //           << static_cast<int>(tile.getType()) << ", Blocked: "
+            //           << tile.isBlocked() << ", GrassIndex: "
+            //           << tile.getGrassTileIndex() << "\n";
         }
     }
 }
 
-std::vector<std::vector<std::shared_ptr<Tile>>> Map::getTiles() {
-    return tiles;
+std::vector<Tile> Map::getNeighbors(const Tile& tile) const {
+    const TileGrid& grid = tiles->grid;
+    std::vector<Tile> neighbors;
+    forEachNeighbor<FourWayConnectivity>(grid, tile.getIndex(), [&](int neighbor, int) {
+        if (!grid.isBlocked(neighbor)) {
+            neighbors.emplace_back(tiles.get(), neighbor);
+        }
+    });
+    return neighbors;
 }
 
-std::vector<std::shared_ptr<Tile>> Map::getNeighbors(std::shared_ptr<Tile>& tile) const {
-    std::cout << "get neigh\n";
-    std::vector<std::shared_ptr<Tile>> neighbors;
-    int row = tile->getRow();
-    int col = tile->getCol();
-    std::cout << "Tile coord: (" << tile->getPosition().x << ", " << tile->getPosition().y << ")\n";
-    std::cout << "Tile Position: (" << row << ", " << col << ")\n";
-    if (row > 0 && !this->tiles[row - 1][col]->isBlocked())
-        neighbors.push_back(this->tiles[row - 1][col]); // Up
-    if (row < static_cast<int>(tiles.size()) - 1 && !tiles[row + 1][col]->isBlocked())
-        neighbors.push_back(tiles[row + 1][col]); // Down
-    if (col > 0 && !tiles[row][col - 1]->isBlocked())
-        neighbors.push_back(tiles[row][col - 1]); // Left
-    if (col < static_cast<int>(tiles[row].size()) - 1 && !tiles[row][col + 1]->isBlocked())
-        neighbors.push_back(tiles[row][col + 1]); // Right
-    return neighbors;
+Tile Map::findNearestWall(int startRow, int startCol) const {
+    int distance = 0;
+    return findNearestWall(startRow, startCol, distance);
 }
 
-std::shared_ptr<Tile> Map::findNearestWall(int startRow, int startCol) const {
+Tile Map::findNearestWall(int startRow, int startCol, int& distance) const {
+    distance = -1;
     if (!getTile(startRow, startCol)) {
         std::cerr << "Invalid starting tile coordinates: (" << startRow << ", " << startCol << ").\n";
-        return nullptr;
+        return Tile();
     }
 
-    std::queue<std::tuple<int, int, int>> q; // row, col, distance
-    std::set<std::pair<int, int>> visited;
-    q.emplace(startRow, startCol, 0);
-    visited.emplace(startRow, startCol);
-
-    const std::vector<std::pair<int, int>> directions = {
-        {0, 1}, {1, 0}, {0, -1}, {-1, 0}
-    };
-
-    while (!q.empty()) {
-        auto [row, col, dist] = q.front();
-        q.pop();
-
-        auto tile = getTile(row, col);
-        if (tile && tile->isBlocked()) {
-            return tile;
-        }
-
-        for (const auto& [dRow, dCol] : directions) {
-            int newRow = row + dRow;
-            int newCol = col + dCol;
-            if (visited.find({newRow, newCol}) == visited.end() && getTile(newRow, newCol)) {
-                q.emplace(newRow, newCol, dist + 1);
-                visited.emplace(newRow, newCol);
-            }
-        }
+    syncNavigation();
+    const int start = tiles->grid.index(startRow, startCol);
+    const int wall = wallDistance.getNearestWall(start);
+    if (wall < 0) {
+        return Tile();
     }
-
-    return nullptr;
+    distance = wallDistance.getDistance(start);
+    return Tile(tiles.get(), wall);
 }
 
 // trap code
@@ -444,16 +443,16 @@ bool Map::addTrap(int row, int col, const std::string& trapTexture) {
         std::cerr << "Invalid tile coordinates: (" << row << ", " << col << ").\n";
         return false;
     }
-    if (tile->getBuilding() != nullptr) {
+    if (tile.getBuilding() != nullptr) {
         std::cerr << "Tile already has a building.\n";
         return false;
     }
-    if (tile->isBlocked()) {
+    if (tile.isBlocked()) {
         std::cerr << "Cannot place a trap on a blocked tile.\n";
         return false;
     }
     auto trap = std::make_shared<Trap>(trapTexture);
-    tile->setTrap(trap);
+    tile.setTrap(trap);
     saveState();
     // std::cout << "Trap placed at tile: (" << row << ", " << col << ").\n";
     // std::cout << "Trap texture: " << trapTexture << "\n";
@@ -465,6 +464,231 @@ std::vector<std::shared_ptr<Tower>> Map::getTowers() const {
     return towers;
 }
 
+void Map::setGoalTiles(const std::vector<TileCoordinates>& goals) {
+    goalTiles = goals;
+    rebuildNavigation();
+}
+
+const std::vector<TileCoordinates>& Map::getGoalTiles() const {
+    return goalTiles;
+}
+
+void Map::setSpawnTiles(const std::vector<TileCoordinates>& spawns) {
+    spawnTiles = spawns;
+    rebuildNavigation();
+}
+
+const std::vector<TileCoordinates>& Map::getSpawnTiles() const {
+    return spawnTiles;
+}
+
+bool Map::hasPathToGoal(const Tile& tile) const {
+    if (!tile) {
+        return false;
+    }
+    syncNavigation();
+    return reachability.reachesGoal(tiles->grid, tile.getIndex());
+}
+
+bool Map::canBlockTile(int row, int col) const {
+    Tile tile = getTile(row, col);
+    if (!tile || tile.isBlocked() || goalTiles.empty()) {
+        return true; // Nothing changes, or there is no goal to cut off yet
+    }
+    syncNavigation();
+    return !reachability.wouldSeal(tiles->grid, tile.getIndex());
+}
+
+Tile Map::getGoalTile() const {
+    if (goalTiles.empty()) {
+        return Tile();
+    }
+    return getTile(goalTiles.front().row, goalTiles.front().col);
+}
+
+bool Map::isGoalTile(const Tile& tile) const {
+    for (const auto& goal : goalTiles) {
+        if (tile.getRow() == goal.row && tile.getCol() == goal.col) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void Map::rebuildNavigation() const {
+    TileGrid& grid = tiles->grid;
+    std::vector<int> goals;
+    for (const auto& goal : goalTiles) {
+        if (grid.inBounds(goal.row, goal.col)) {
+            goals.push_back(grid.index(goal.row, goal.col));
+        }
+    }
+    std::vector<int> spawns;
+    for (const auto& spawn : spawnTiles) {
+        if (grid.inBounds(spawn.row, spawn.col)) {
+            spawns.push_back(grid.index(spawn.row, spawn.col));
+        }
+    }
+    flowField.build(grid, goals);
+    hierarchicalPathfinder.build(grid);
+    jumpPointSearch.build(grid);
+    pathCache.build(grid);
+    reachability.build(grid, goals, spawns);
+    siegePlanner.build(grid, spawns, goals);
+    wallDistance.build(grid);
+    breachPlanner.build(grid, goals);
+    grid.clearChanges();
+    grid.clearHealthChanges();
+}
+
+void Map::syncNavigation() const {
+    TileGrid& grid = tiles->grid;
+    if (!grid.getChanges().empty()) {
+        flowField.applyChanges(grid, grid.getChanges());
+        hierarchicalPathfinder.applyChanges(grid, grid.getChanges());
+        jumpPointSearch.applyChanges(grid, grid.getChanges());
+        pathCache.applyChanges(grid, grid.getChanges());
+        reachability.applyChanges(grid, grid.getChanges());
+        siegePlanner.applyChanges(grid, grid.getChanges());
+        wallDistance.applyChanges(grid, grid.getChanges());
+        breachPlanner.applyChanges(grid, grid.getChanges());
+        grid.clearChanges();
+    }
+    if (!grid.getHealthChanges().empty()) {
+        breachPlanner.applyChanges(grid, grid.getHealthChanges());
+        grid.clearHealthChanges();
+    }
+}
+
+const FlowField& Map::getFlowField() const {
+    syncNavigation();
+    return flowField;
+}
+
+DStarLite& Map::getBreachPlanner() const {
+    syncNavigation();
+    return breachPlanner;
+}
+
+HierarchicalPathfinder& Map::getHierarchicalPathfinder() const {
+    syncNavigation();
+    return hierarchicalPathfinder;
+}
+
+JumpPointSearch& Map::getJumpPointSearch() const {
+    syncNavigation();
+    return jumpPointSearch;
+}
+
+PathCache& Map::getPathCache() const {
+    syncNavigation();
+    return pathCache;
+}
+
+SiegePlanner& Map::getSiegePlanner() const {
+    syncNavigation();
+    siegePlanner.update(tiles->grid);
+    return siegePlanner;
+}
+
+Tile Map::getBreachTarget(const Tile& from) const {
+    if (!from) {
+        return Tile();
+    }
+    const int wall = getSiegePlanner().getTarget(from.getIndex());
+    return wall >= 0 ? Tile(tiles.get(), wall) : Tile();
+}
+
+PathArena& Map::getPathArena() const {
+    return pathArena;
+}
+
+SharedPath Map::makeUnitPath(std::vector<int>& path) const {
+    if (pathSmoothing) {
+        smoothPath(tiles->grid, path);
+    }
+    return pathArena.intern(path);
+}
+
+void Map::setPathSmoothing(bool enabled) {
+    pathSmoothing = enabled;
+}
+
+bool Map::isPathSmoothing() const {
+    return pathSmoothing;
+}
+
+PathRequestService& Map::getPathRequestService() const {
+    return pathRequests;
+}
+
+PathScheduler& Map::getPathScheduler() const {
+    return pathScheduler;
+}
+
+void Map::setPathRequestMode(PathRequestMode mode) {
+    pathRequestMode = mode;
+}
+
+PathRequestMode Map::getPathRequestMode() const {
+    return pathRequestMode;
+}
+
+void Map::updatePathRequests() {
+    if (pathScheduler.getQueuedCount() > 0) {
+        syncNavigation();
+        pathScheduler.runFrame(tiles->grid);
+    }
+}
+
+SharedPath Map::followFlowField(const Tile& start, int stopBeforeWallTiles) const {
+    static thread_local std::vector<int> indices;
+    if (!start || !getFlowField().tracePath(tiles->grid, start.getIndex(), stopBeforeWallTiles, indices)) {
+        return SharedPath();
+    }
+    return makeUnitPath(indices);
+}
+
+// Cut at the first blocked tile: breachWall is the wall the route goes through,
+// or an empty Tile if it runs straight to a goal
+SharedPath Map::followBreachPath(const Tile& start, int stopBeforeWallTiles, Tile& breachWall) const {
+    breachWall = Tile();
+    static thread_local std::vector<int> indices;
+    if (!start || !getBreachPlanner().findPath(tiles->grid, start.getIndex(), indices)) {
+        return SharedPath();
+    }
+    const TileGrid& grid = tiles->grid;
+    for (size_t i = 1; i < indices.size(); ++i) {
+        if (grid.isBlocked(indices[i])) {
+            if (!isGoalTile(Tile(tiles.get(), indices[i]))) {
+                breachWall = Tile(tiles.get(), indices[i]);
+            }
+            indices.resize(i + 1);
+            break;
+        }
+    }
+    stopShortOfBlocked(grid, indices, stopBeforeWallTiles);
+    return makeUnitPath(indices);
+}
+
+// The approach field ends on the cut walls themselves, so the last tile of the
+// trace is the wall to breach
+SharedPath Map::followSiegePath(const Tile& start, int stopBeforeWallTiles, Tile& breachWall) const {
+    breachWall = getBreachTarget(start);
+    static thread_local std::vector<int> indices;
+    if (!breachWall || !siegePlanner.getApproachField().tracePath(tiles->grid, start.getIndex(), 0, indices)) {
+        breachWall = Tile();
+        return SharedPath();
+    }
+    const TileGrid& grid = tiles->grid;
+    if (indices.back() != breachWall.getIndex()) {
+        // Stopped at another blocked tile on the way; that is the one to break
+        breachWall = grid.getType(indices.back()) == TileType::Wall ? Tile(tiles.get(), indices.back()) : Tile();
+    }
+    stopShortOfBlocked(grid, indices, stopBeforeWallTiles);
+    return makeUnitPath(indices);
+}
+
 
 
 // void Map::loadTownHallAnimation() {
@@ -506,7 +730,7 @@ std::vector<std::shared_ptr<Tower>> Map::getTowers() const {
 // void Map::draw(sf::RenderWindow& window) const {
 //     for (const auto& row : tiles) {
 //         for (const auto& tile : row) {
-//             tile->draw(window);
+//             tile.draw(window);
 //         }
 //     }
 
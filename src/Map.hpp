@@ -14,14 +14,35 @@
 #include "TextureManager.hpp"
 
 #include "BulletManager.hpp"
-
+#include "DStarLite.hpp"
+#include "FlowField.hpp"
+#include "HierarchicalPathfinder.hpp"
+#include "JumpPointSearch.hpp"
+#include "PathArena.hpp"
+#include "PathCache.hpp"
+#include "PathRequestService.hpp"
+#include "PathScheduler.hpp"
+#include "ReachabilityIndex.hpp"
+#include "SiegePlanner.hpp"
+#include "WallDistanceField.hpp"
+
+
+// Where Pathfinding::requestPath sends its searches
+enum class PathRequestMode {
+    Threaded,  // PathRequestService worker threads
+    TimeSliced // PathScheduler, a bounded slice per frame on the update thread (deterministic)
+};
 
 class Map {
 public:
     // Map(int rows, int cols);
     Map(int rows, int cols, BulletManager& centralBulletManager);
     void initializeTiles();
-    std::shared_ptr<Tile> getTile(int row, int col) const;
+    Tile getTile(int row, int col) const;
+    Tile getTileAt(int index) const; // By TileGrid index, e.g. a SharedPath waypoint
+    sf::Vector2f getTilePosition(int index) const;
+    const std::vector<sf::Vector2f>& getTilePositions() const; // Indexed by TileGrid index
+    const TileGrid& getGrid() const;
     bool addBuilding(int row, int col, const std::string& buildingTexture);
     bool addWall(int row, int col);
     void draw(sf::RenderWindow& window) const;
@@ -29,13 +50,16 @@ public:
     int getCols() const;
     void saveToFile(const std::string& filename);
     void loadFromFile(const std::string& filename);
-    std::vector<std::vector<std::shared_ptr<Tile>>> getTiles();
-    std::vector<std::shared_ptr<Tile>> getNeighbors(std::shared_ptr<Tile>& tile) const;
+    std::vector<Tile> getNeighbors(const Tile& tile) const;
     void saveState();
     void undo();
     void redo();
 
-    std::shared_ptr<Tile> findNearestWall(int startRow, int startCol) const;
+    // Nearest blocked tile in four-way steps, looked up in the wall distance
+    // field; an empty Tile if nothing is blocked
+    Tile findNearestWall(int startRow, int startCol) const;
+    // Same, also giving the step count (-1 if there is no wall)
+    Tile findNearestWall(int startRow, int startCol, int& distance) const;
     bool addTrap(int row, int col, const std::string& trapTexture);
     int nextBuildingId;
     int nextTowerId;
@@ -44,6 +68,66 @@ public:
     bool addTower(int row, int col, const std::string& selectedBuildingTexture);
     std::vector<std::shared_ptr<Tower>> getTowers() const;
 
+    // Tiles enemies are heading for; the town hall unless configured otherwise
+    void setGoalTiles(const std::vector<TileCoordinates>& goals);
+    const std::vector<TileCoordinates>& getGoalTiles() const;
+    Tile getGoalTile() const; // First goal tile
+    bool isGoalTile(const Tile& tile) const;
+    // Tiles enemies spawn on; every boundary tile unless configured otherwise
+    void setSpawnTiles(const std::vector<TileCoordinates>& spawns);
+    const std::vector<TileCoordinates>& getSpawnTiles() const;
+    // True if tile is open and can get to a goal tile, breaching walls on the
+    // way if need be; tracked incrementally, so spawners can ask for every unit
+    bool hasPathToGoal(const Tile& tile) const;
+    // False if blocking the tile would cut an open spawn tile that reaches the
+    // goal off from it; walls do not count, as units breach them. addBuilding
+    // and addTower refuse such placements. Walls (addWall and brick walls in
+    // addBuilding) are not checked: a wall stays passable, and its straight
+    // neighbors stay linked through it, so it can never seal anything.
+    bool canBlockTile(int row, int col) const;
+
+    // Shared distance field toward the goal tiles, repaired on access from the
+    // tiles changed since the last call
+    const FlowField& getFlowField() const;
+    // Path along the flow field (see FlowField::tracePath); empty if start
+    // cannot reach a goal
+    SharedPath followFlowField(const Tile& start, int stopBeforeWallTiles) const;
+    // Incremental (D* Lite) planner toward the goal tiles that treats walls as
+    // passable at a cost proportional to their health, for units that breach
+    SharedPath followBreachPath(const Tile& start, int stopBeforeWallTiles, Tile& breachWall) const;
+    DStarLite& getBreachPlanner() const;
+    // Minimum cut of the walls closing the goal tiles in, replanned on access
+    // after a wall layout change
+    SiegePlanner& getSiegePlanner() const;
+    // Wall of that cut a unit on from should breach; empty unless walls seal
+    // the goal off and from is on the outside
+    Tile getBreachTarget(const Tile& from) const;
+    // Path to the breach target, cut at the first blocked tile like
+    // followBreachPath; empty if from has no breach target
+    SharedPath followSiegePath(const Tile& start, int stopBeforeWallTiles, Tile& breachWall) const;
+    // Cluster abstraction for long queries on large maps; only clusters whose
+    // tiles changed since the last call are rebuilt
+    HierarchicalPathfinder& getHierarchicalPathfinder() const;
+    // Jump point search with its jump tables kept in sync the same way
+    JumpPointSearch& getJumpPointSearch() const;
+    // Path query results shared by every unit; entries are evicted when a tile
+    // their route crosses changes
+    PathCache& getPathCache() const;
+    // Storage for unit paths; identical paths share one copy
+    PathArena& getPathArena() const;
+    // Stores a finished path for a unit, first collapsing it to any-angle
+    // segments if path smoothing is on (see smoothPath)
+    SharedPath makeUnitPath(std::vector<int>& path) const;
+    void setPathSmoothing(bool enabled);
+    bool isPathSmoothing() const;
+    // Worker threads for path searches that must not stall the update loop
+    PathRequestService& getPathRequestService() const;
+    PathScheduler& getPathScheduler() const;
+    void setPathRequestMode(PathRequestMode mode);
+    PathRequestMode getPathRequestMode() const;
+    // Runs this frame's slice of time-sliced path requests; call once per update
+    void updatePathRequests();
+
 
     // void loadTownHallAnimation();
     // void update(float deltaTime);
@@ -52,7 +136,9 @@ public:
 private:
     int rows;
     int cols;
-    std::vector<std::vector<std::shared_ptr<Tile>>> tiles;
+    // Held by pointer so Tile handles stay writable through a const Map, as
+    // the shared_ptr<Tile> grid they replace was
+    std::unique_ptr<TileStore> tiles;
     static std::vector<std::vector<TileType>> tileTypeMap; // Added static map
 
     std::vector<std::shared_ptr<Tower>> towers; // Vector of Towers
@@ -60,8 +146,26 @@ private:
     GameStateManager stateManager;
 
     BulletManager& centralBulletManager;
+
+    std::vector<TileCoordinates> goalTiles;
+    std::vector<TileCoordinates> spawnTiles;
+    mutable PathArena pathArena;
+    bool pathSmoothing;
+    mutable FlowField flowField;
+    mutable DStarLite breachPlanner;
+    mutable HierarchicalPathfinder hierarchicalPathfinder;
+    mutable JumpPointSearch jumpPointSearch;
+    mutable PathCache pathCache;
+    mutable ReachabilityIndex reachability;
+    mutable SiegePlanner siegePlanner;
+    mutable WallDistanceField wallDistance;
+    mutable PathRequestService pathRequests;
+    mutable PathScheduler pathScheduler;
+    PathRequestMode pathRequestMode;
     
     void restoreGameState(const GameState& state);
+    void rebuildNavigation() const;
+    void syncNavigation() const;
 
 
 
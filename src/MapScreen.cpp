@@ -2,14 +2,24 @@
 #include "MapScreen.hpp"
 #include "IsometricUtils.hpp"
 #include "TextureManager.hpp"
+#include <algorithm>
+#include <chrono>
 #include <iostream>
+#include <limits>
+
+constexpr float MapScreen::MAX_FAST_FORWARD;
 
 // Constructor: Initializes all components and calls initializeTowers()
 MapScreen::MapScreen(int rows, int cols, const sf::Vector2u& windowSize)
     : mapEntity(rows, cols, centralBulletManager), // Initialize Map with central BulletManager
       uiManager(windowSize), 
-      tankSpawn(mapEntity),    // Initialize TankSpawn with mapEntity
-      skeletonSpawn(mapEntity),
+      units(mapEntity, effects, HordeSpawn::MAX_UNITS),
+      tankSpawn(mapEntity, units),    // Initialize TankSpawn with mapEntity
+      skeletonSpawn(mapEntity, units),
+      hordeSpawn(mapEntity, units),
+      updateMilliseconds(0.0f),
+      fastForward(false),
+      fastForwardSkipped(0.0f),
       centralBulletManager() { // Initialize BulletManager
     // Load the background texture
     if (!backgroundTexture.loadFromFile("../assets/background/map_bg.png")) {
@@ -51,26 +61,27 @@ void MapScreen::handleEvents(const sf::Event& event, sf::RenderWindow& window) {
     uiManager.handleEvent(event);
     tankSpawn.handleEvent(event, mapEntity);
     skeletonSpawn.handleEvent(event, mapEntity);
+    hordeSpawn.handleEvent(event, mapEntity);
 
     if (event.type == sf::Event::MouseButtonPressed && event.mouseButton.button == sf::Mouse::Left) {
         sf::Vector2f mousePos = window.mapPixelToCoords(sf::Mouse::getPosition(window), cameraView);
         TileCoordinates tileCoords = IsometricUtils::screenToTile(mousePos.x, mousePos.y, mapEntity.getRows(), mapEntity.getCols());
         auto tile = mapEntity.getTile(tileCoords.row, tileCoords.col);
         if (tile) {
-            if (!selectedTrapTexture.empty() && !tile->hasTrap() && !tile->getBuilding()) {
+            if (!selectedTrapTexture.empty() && !tile.hasTrap() && !tile.getBuilding()) {
                 mapEntity.addTrap(tileCoords.row, tileCoords.col, selectedTrapTexture);
-            } else if (!selectedBuildingTexture.empty() && !tile->getBuilding() && !tile->hasTrap()) {
+            } else if (!selectedBuildingTexture.empty() && !tile.getBuilding() && !tile.hasTrap()) {
                 if (selectedBuildingTexture == "../assets/buildings/moontower.png") {
-                    // mapEntity.addBuilding(tile->getRow(), tile->getCol(), "../assets/buildings/moontower.png");
+                    // mapEntity.addBuilding(tile.getRow(), tile.getCol(), "../assets/buildings/moontower.png");
                     // Initialize a new tower instance
-                    mapEntity.addTower(tile->getRow(), tile->getCol(), selectedBuildingTexture);
+                    mapEntity.addTower(tile.getRow(), tile.getCol(), selectedBuildingTexture);
                     // sf::Vector2f newTowerPos = IsometricUtils::tileToScreen(tileCoords.row, tileCoords.col);
                     // std::shared_ptr<Tower> newTower = std::make_shared<Tower>((mapEntity.nextTowerId)++, newTowerPos, 200.0f, 1.0f, centralBulletManager, selectedBuildingTexture);
                     // towers.push_back(newTower);
-                    // tile->setTower(newTower);
+                    // tile.setTower(newTower);
                 } else {
                     // mapEntity.addBuilding(tileCoords.row, tileCoords.col, selectedBuildingTexture);
-                    mapEntity.addBuilding(tile->getRow(), tile->getCol(), selectedBuildingTexture);
+                    mapEntity.addBuilding(tile.getRow(), tile.getCol(), selectedBuildingTexture);
                 }
             }
         }
@@ -82,17 +93,25 @@ void MapScreen::handleEvents(const sf::Event& event, sf::RenderWindow& window) {
             sf::Vector2f targetTilePos = IsometricUtils::tileToScreen(1, 28);
             float bulletSpeed = 300.0f;
             centralBulletManager.fireBullet(startTilePos, targetTilePos, bulletSpeed);
+        } else if (event.key.code == sf::Keyboard::F) {
+            setFastForward(!fastForward);
+            if (fastForward) {
+                std::cout << "Fast-forward on.\n";
+            } else {
+                std::cout << "Fast-forward off, skipped " << fastForwardSkipped << " s of simulation.\n";
+            }
         }
     }
 }
 
 // Draws all game elements including background, map, spawns, towers, bullets, and UI
 void MapScreen::draw(sf::RenderWindow& window, float deltaTime) {
+    const auto start = std::chrono::steady_clock::now();
     window.setView(cameraView);
     window.draw(backgroundSprite);
     mapEntity.draw(window);
-    tankSpawn.draw(window, deltaTime, mapEntity);
-    skeletonSpawn.draw(window, deltaTime);
+    units.draw(window);
+    effects.draw(window);
 
     // Draw towers first
     // for (const auto& tower : mapEntity.getTowers()) {
@@ -105,6 +124,9 @@ void MapScreen::draw(sf::RenderWindow& window, float deltaTime) {
     // Reset to default view and draw UI
     window.setView(window.getDefaultView());
     uiManager.draw(window);
+
+    const std::chrono::duration<float, std::milli> drawTime = std::chrono::steady_clock::now() - start;
+    hordeSpawn.recordFrame(deltaTime, updateMilliseconds + drawTime.count());
 }
 
 // Sets the selected building type and clears any selected trap type
@@ -180,20 +202,25 @@ Map& MapScreen::getMapEntity() {
 
 // Updates all game logic including spawns, towers, bullets, and handles collisions
 void MapScreen::update(float deltaTime) {
+    const auto start = std::chrono::steady_clock::now();
+    mapEntity.updatePathRequests();
     skeletonSpawn.update(deltaTime, mapEntity);
     tankSpawn.update(deltaTime, mapEntity); // Pass mapEntity as the second argument
+    if (fastForward) {
+        fastForwardSkipped += skipToNextEvent(MAX_FAST_FORWARD);
+    }
+    const sf::Vector2f viewSize = cameraView.getSize();
+    units.setView(sf::FloatRect(cameraView.getCenter() - viewSize / 2.0f, viewSize));
+    units.update(deltaTime);
+    effects.update(deltaTime);
     centralBulletManager.update(deltaTime);
 
-    // Collect all troop positions
+    // Collect all troop positions; coarse units are out of every tower's reach
     std::vector<sf::Vector2f> troopPositions;
-    for (const auto& skeleton : skeletonSpawn.getSkeletons()) {
-        if (skeleton->isAlive()) {
-            troopPositions.emplace_back(skeleton->getPosition());
-        }
-    }
-    for (const auto& tank : tankSpawn.getTanks()) {
-        if (!tank->isDestroyed()) {
-            troopPositions.emplace_back(tank->getPosition());
+    const UnitStore& store = units.getUnits();
+    for (int i = 0; i < store.size(); ++i) {
+        if (units.isAlive(i) && !units.isCoarse(i)) {
+            troopPositions.emplace_back(store.posX[i], store.posY[i]);
         }
     }
 
@@ -204,10 +231,74 @@ void MapScreen::update(float deltaTime) {
 
     // Handle Bullet-Troop Collisions
     handleBulletCollisions(deltaTime);
+
+    const std::chrono::duration<float, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    updateMilliseconds = elapsed.count();
+}
+
+void MapScreen::startWave() {
+    skeletonSpawn.start();
+    tankSpawn.start();
+}
+
+void MapScreen::setFastForward(bool enabled) {
+    if (enabled && !fastForward) {
+        fastForwardSkipped = 0.0f;
+    }
+    fastForward = enabled;
+}
+
+float MapScreen::getFastForwardSkipped() const {
+    return fastForwardSkipped;
+}
+
+bool MapScreen::isSettled() {
+    const std::vector<Bullet>& bullets = centralBulletManager.getBullets();
+    return std::none_of(bullets.begin(), bullets.end(), [](const Bullet& bullet) { return bullet.isActive(); }) &&
+           nextEvent(MAX_FAST_FORWARD) == std::numeric_limits<float>::infinity();
+}
+
+float MapScreen::nextEvent(float limit) {
+    float next = std::min({units.nextInteraction(limit), skeletonSpawn.getTimeToNextSpawn(), tankSpawn.getTimeToNextSpawn()});
+    // A tower only fires at a troop in range; troops walking into range are
+    // unit interactions already, so this covers the ones standing in it
+    const UnitStore& store = units.getUnits();
+    for (const auto& tower : mapEntity.getTowers()) {
+        for (int i = 0; i < store.size() && next > 0.0f; ++i) {
+            if (units.isAlive(i) && !units.isCoarse(i) && tower->isWithinRange(sf::Vector2f(store.posX[i], store.posY[i]))) {
+                next = std::min(next, tower->getTimeToNextShot());
+                break;
+            }
+        }
+    }
+    return next;
+}
+
+float MapScreen::skipToNextEvent(float limit) {
+    // Bullets in flight are interactions of their own; wait for them to land
+    const std::vector<Bullet>& bullets = centralBulletManager.getBullets();
+    if (std::any_of(bullets.begin(), bullets.end(), [](const Bullet& bullet) { return bullet.isActive(); })) {
+        return 0.0f;
+    }
+    const float next = nextEvent(limit);
+    if (next <= 0.0f || next == std::numeric_limits<float>::infinity()) {
+        return 0.0f;
+    }
+    const float skipped = std::min(next, limit);
+    units.fastForward(skipped);
+    // At most one spawn each falls due within the jump, at its very end
+    skeletonSpawn.update(skipped, mapEntity);
+    tankSpawn.update(skipped, mapEntity);
+    const std::vector<sf::Vector2f> noTroops;
+    for (auto& tower : mapEntity.getTowers()) {
+        tower->update(skipped, noTroops); // Cooldowns only
+    }
+    effects.update(skipped);
+    return skipped;
 }
 
 // Handles collisions between bullets and troops (skeletons and tanks)
-void MapScreen::handleBulletCollisions(float deltaTime) {
+void MapScreen::handleBulletCollisions(float /*deltaTime*/) {
     for (auto& bullet : centralBulletManager.getBullets()) { // Central BulletManager
         if (!bullet.isActive()) continue;
         sf::FloatRect bulletBounds = bullet.getSprite().getGlobalBounds();
@@ -216,38 +307,20 @@ void MapScreen::handleBulletCollisions(float deltaTime) {
         //           << bulletBounds.top << ", " << bulletBounds.width << ", "
         //           << bulletBounds.height << ")\n";
 
-        for (auto& skeleton : skeletonSpawn.getSkeletons()) {
-            if (!skeleton->isAlive()) continue;
-            sf::FloatRect skeletonBounds = skeleton->getSprite().getGlobalBounds();
-            // Log skeleton bounds
-            // std::cout << "Skeleton bounds: (" << skeletonBounds.left << ", "
-            //           << skeletonBounds.top << ", " << skeletonBounds.width << ", "
-            //           << skeletonBounds.height << ")\n";
-            if (bulletBounds.intersects(skeletonBounds)) {
-                std::cout << "Bullet hit Skeleton at ("
-                          << skeleton->getPosition().x << ", "
-                          << skeleton->getPosition().y << ").\n";
-                skeleton->takeDamage(10); // Apply damage
-                bullet.deactivate(); // Deactivate bullet
-                break; // Move to next bullet
-            }
-        }
-
-        for (auto& tank : tankSpawn.getTanks()) {
-            if (tank->isDestroyed()) continue;
-            sf::FloatRect tankBounds = tank->getSprite().getGlobalBounds();
-            if (bulletBounds.intersects(tankBounds)) {
-                std::cout << "Bullet hit Tank at ("
-                          << tank->getPosition().x << ", "
-                          << tank->getPosition().y << ").\n";
-                tank->takeDamage(10, deltaTime); // Apply damage
+        const UnitStore& store = units.getUnits();
+        for (int i = 0; i < store.size(); ++i) {
+            if (!units.isAlive(i) || units.isCoarse(i)) continue;
+            if (bulletBounds.intersects(units.getBounds(i))) {
+                std::cout << "Bullet hit " << (store.type[i] == UnitType::Tank ? "Tank" : "Skeleton") << " at ("
+                          << store.posX[i] << ", "
+                          << store.posY[i] << ").\n";
+                units.takeDamage(i, 10); // Apply damage
                 bullet.deactivate(); // Deactivate bullet
                 break; // Move to next bullet
             }
         }
     }
 
-    // Remove Dead Skeletons and Tanks
-    skeletonSpawn.removeDeadSkeletons();
-    // tankSpawn.removeDeadTanks();
+    // Remove dead skeletons and tanks; their slots are free for the next spawn
+    units.removeDead();
 }
\ No newline at end of file
@@ -6,9 +6,11 @@
 #include "UIManager.hpp"
 #include "TankSpawn.hpp"
 #include "SkeletonSpawn.hpp"
+#include "HordeSpawn.hpp"
 #include "BulletManager.hpp"
 #include "Tower.hpp" // Include Tower class
-#include "Tank.hpp"
+#include "EffectSystem.hpp"
+#include "UnitManager.hpp"
 #include "Trap.hpp"
 
 class MapScreen {
@@ -24,6 +26,17 @@ public:
     void update(float deltaTime);
     // void handleBulletCollisions();
 
+    // Starts a skeleton and a tank wave together, as keys I and P do
+    void startWave();
+    // Key F. While on, each update first jumps the whole simulation to its
+    // next event (see nextEvent), at most MAX_FAST_FORWARD at a time.
+    void setFastForward(bool enabled);
+    // Simulated seconds jumped since fast-forward was last turned on
+    float getFastForwardSkipped() const;
+    // True once nothing will happen without input: no bullet in flight and
+    // no event pending (spawns done, every unit resting, dead or stranded)
+    bool isSettled();
+
     void handleBulletCollisions(float deltatime);
     void setSelectedTrapType(const std::string& trapTexture);
 
@@ -34,8 +47,15 @@ private:
     std::string selectedBuildingTexture;
     sf::View cameraView;
     float cameraSpeed = 300.0f;
+    EffectSystem effects; // Explosions left behind by dead units
+    UnitManager units; // Every skeleton and tank; the spawners only add to it
     TankSpawn tankSpawn;
     SkeletonSpawn skeletonSpawn;
+    HordeSpawn hordeSpawn; // Stress mode, key H
+    float updateMilliseconds; // Last update, for the horde frame report
+    static constexpr float MAX_FAST_FORWARD = 30.0f; // Seconds per jump
+    bool fastForward;
+    float fastForwardSkipped; // Simulated seconds jumped since it was turned on
     sf::Texture backgroundTexture;
     sf::Sprite backgroundSprite;
     BulletManager centralBulletManager; // Central BulletManager
@@ -43,6 +63,16 @@ private:
     // traps
     std::string selectedTrapTexture; // Add a member variable for the selected trap texture
     void initializeTowers(); // Initialize towers and pass central BulletManager
+
+    // Time until the next thing the frame-by-frame update has to handle: a
+    // unit interaction (UnitManager::nextInteraction), the next spawn of
+    // either wave, or a tower with a troop in range coming off cooldown. At
+    // most limit, or infinity when nothing is pending at all.
+    float nextEvent(float limit);
+    // Advances units, spawners, tower cooldowns and effects together to the
+    // next event, or by limit if none comes sooner, and returns the time
+    // skipped. Skips nothing while a bullet is in flight or nothing is pending.
+    float skipToNextEvent(float limit);
 };
 
 #endif // MAPSCREEN_HPP
\ No newline at end of file
@@ -0,0 +1,149 @@
+// MovementBench.cpp
+// Headless microbenchmark for the unit movement step. Runs every
+// MovementKernel version the CPU supports over the same units (a mix of
+// walking, arrived and idle ones, laid out in UnitStore's columns) and
+// reports units/sec per version. It also checks that each version's
+// columns end up bit-identical to the scalar ones. Output is JSON, or a
+// table with --table.
+// Build and run with `make movement-bench`. Options:
+//   --units N     units (default 100000)
+//   --frames N    steps to time (default 1000)
+//   --seed S      layout seed (default 1234)
+//   --table       human readable output instead of JSON
+#include "MovementKernel.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+struct Units {
+    std::vector<std::uint8_t> stepping;
+    std::vector<float> targetX;
+    std::vector<float> targetY;
+    std::vector<float> speed;
+    std::vector<float> posX;
+    std::vector<float> posY;
+    std::vector<float> velX;
+    std::vector<float> velY;
+    std::vector<float> remaining;
+    std::vector<std::uint8_t> arrived;
+
+    MovementColumns columns() {
+        return MovementColumns{stepping.data(), targetX.data(), targetY.data(), speed.data(), posX.data(),
+                               posY.data(), velX.data(), velY.data(), remaining.data(), arrived.data()};
+    }
+};
+
+// Skeleton and tank speeds; one unit in ten idle and one in twenty already
+// standing on its waypoint
+static Units makeUnits(int count, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> coordinate(0.0f, 4000.0f);
+    std::uniform_int_distribution<int> kind(0, 19);
+    Units units;
+    for (int i = 0; i < count; ++i) {
+        const int k = kind(rng);
+        const float x = coordinate(rng);
+        const float y = coordinate(rng);
+        units.stepping.push_back(k < 2 ? 0 : 1);
+        units.posX.push_back(x);
+        units.posY.push_back(y);
+        units.targetX.push_back(k == 2 ? x : coordinate(rng));
+        units.targetY.push_back(k == 2 ? y : coordinate(rng));
+        units.speed.push_back(k % 4 == 0 ? 100.0f : 70.0f);
+        units.velX.push_back(0.0f);
+        units.velY.push_back(0.0f);
+        units.remaining.push_back(0.0f);
+        units.arrived.push_back(0);
+    }
+    return units;
+}
+
+template <typename T>
+static bool sameBits(const std::vector<T>& a, const std::vector<T>& b) {
+    return a.size() == b.size() && std::memcmp(a.data(), b.data(), a.size() * sizeof(T)) == 0;
+}
+
+static bool sameBits(const Units& a, const Units& b) {
+    return sameBits(a.posX, b.posX) && sameBits(a.posY, b.posY) && sameBits(a.velX, b.velX) &&
+           sameBits(a.velY, b.velY) && sameBits(a.remaining, b.remaining) && sameBits(a.arrived, b.arrived);
+}
+
+static void printUsage() {
+    std::fprintf(stderr, "usage: movementbench [--units N] [--frames N] [--seed S] [--table]\n");
+}
+
+int main(int argc, char** argv) {
+    int count = 100000;
+    int frames = 1000;
+    unsigned seed = 1234u;
+    bool table = false;
+    for (int i = 1; i < argc; ++i) {
+        const std::string option = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (option == "--table") {
+            table = true;
+        } else if (option == "--units" && hasValue) {
+            count = std::atoi(argv[++i]);
+        } else if (option == "--frames" && hasValue) {
+            frames = std::atoi(argv[++i]);
+        } else if (option == "--seed" && hasValue) {
+            seed = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+        } else {
+            printUsage();
+            return 1;
+        }
+    }
+    if (count <= 0 || frames <= 0) {
+        std::fprintf(stderr, "Units and frames must be positive.\n");
+        return 1;
+    }
+
+    const float deltaTime = 1.0f / 60.0f;
+    const Units initial = makeUnits(count, seed);
+    Units reference;
+    const MovementKernel::Isa isas[] = {MovementKernel::Scalar, MovementKernel::Sse41, MovementKernel::Avx2};
+    double scalarRate = 0.0;
+    bool first = true;
+
+    if (table) {
+        std::printf("%-8s %12s %14s %8s %10s\n", "kernel", "ns/unit", "units/s", "speedup", "identical");
+    } else {
+        std::printf("{\n  \"benchmark\": \"movement\",\n  \"format\": 1,\n  \"seed\": %u,\n  \"units\": %d,\n"
+                    "  \"frames\": %d,\n  \"best\": \"%s\",\n  \"results\": [",
+                    seed, count, frames, MovementKernel::name(MovementKernel::best()));
+    }
+    for (MovementKernel::Isa isa : isas) {
+        if (!MovementKernel::isSupported(isa)) {
+            continue;
+        }
+        Units units = initial;
+        const MovementColumns columns = units.columns();
+        const auto start = std::chrono::steady_clock::now();
+        for (int frame = 0; frame < frames; ++frame) {
+            MovementKernel::step(isa, columns, 0, count, deltaTime);
+        }
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        const double rate = static_cast<double>(count) * frames / seconds;
+        if (isa == MovementKernel::Scalar) {
+            reference = units;
+            scalarRate = rate;
+        }
+        const bool identical = sameBits(units, reference);
+        if (table) {
+            std::printf("%-8s %12.3f %14.0f %7.2fx %10s\n", MovementKernel::name(isa), 1e9 / rate, rate,
+                        rate / scalarRate, identical ? "yes" : "NO");
+        } else {
+            std::printf("%s\n    {\"kernel\": \"%s\", \"units_per_sec\": %.1f, \"speedup\": %.2f, \"identical\": %s}",
+                        first ? "" : ",", MovementKernel::name(isa), rate, rate / scalarRate, identical ? "true" : "false");
+        }
+        first = false;
+    }
+    if (!table) {
+        std::printf("\n  ]\n}\n");
+    }
+    return 0;
+}
@@ -0,0 +1,174 @@
+// MovementKernel.cpp
+#include "MovementKernel.hpp"
+#include <cmath>
+#include <cstring>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define MOVEMENT_KERNEL_X86 1
+#include <immintrin.h>
+#endif
+
+void MovementKernel::step(const MovementColumns& columns, int begin, int end, float deltaTime) {
+    static const Isa isa = best();
+    step(isa, columns, begin, end, deltaTime);
+}
+
+void MovementKernel::step(Isa isa, const MovementColumns& columns, int begin, int end, float deltaTime) {
+    switch (isa) {
+        case Avx2:
+            stepAvx2(columns, begin, end, deltaTime);
+            break;
+        case Sse41:
+            stepSse41(columns, begin, end, deltaTime);
+            break;
+        default:
+            stepScalar(columns, begin, end, deltaTime);
+            break;
+    }
+}
+
+MovementKernel::Isa MovementKernel::best() {
+    if (isSupported(Avx2)) {
+        return Avx2;
+    }
+    return isSupported(Sse41) ? Sse41 : Scalar;
+}
+
+bool MovementKernel::isSupported(Isa isa) {
+#ifdef MOVEMENT_KERNEL_X86
+    switch (isa) {
+        case Avx2:
+            return __builtin_cpu_supports("avx2");
+        case Sse41:
+            return __builtin_cpu_supports("sse4.1");
+        default:
+            return true;
+    }
+#else
+    return isa == Scalar;
+#endif
+}
+
+const char* MovementKernel::name(Isa isa) {
+    switch (isa) {
+        case Avx2:
+            return "avx2";
+        case Sse41:
+            return "sse4.1";
+        default:
+            return "scalar";
+    }
+}
+
+void MovementKernel::stepScalar(const MovementColumns& c, int begin, int end, float deltaTime) {
+    for (int i = begin; i < end; ++i) {
+        if (!c.stepping[i]) {
+            continue;
+        }
+        const float dx = c.targetX[i] - c.posX[i];
+        const float dy = c.targetY[i] - c.posY[i];
+        const float distance = std::sqrt(dx * dx + dy * dy);
+        if (distance > 1.0f) {
+            c.velX[i] = dx / distance * c.speed[i];
+            c.velY[i] = dy / distance * c.speed[i];
+            c.posX[i] += c.velX[i] * deltaTime;
+            c.posY[i] += c.velY[i] * deltaTime;
+            c.remaining[i] = distance - c.speed[i] * deltaTime;
+            c.arrived[i] = 0;
+        } else {
+            c.remaining[i] = 0.0f;
+            c.arrived[i] = 1;
+        }
+    }
+}
+
+#ifdef MOVEMENT_KERNEL_X86
+
+// arrived[i] = 1 where a stepping unit did not move, left alone where it is
+// not stepping; moved holds one bit per lane
+static inline void storeArrived(const MovementColumns& c, int i, int lanes, int moved) {
+    for (int lane = 0; lane < lanes; ++lane) {
+        const std::uint8_t keep = static_cast<std::uint8_t>(-static_cast<int>(c.stepping[i + lane] == 0));
+        const std::uint8_t arrivedNow = static_cast<std::uint8_t>(((moved >> lane) & 1) ^ 1);
+        c.arrived[i + lane] = static_cast<std::uint8_t>((c.arrived[i + lane] & keep) | (arrivedNow & ~keep));
+    }
+}
+
+__attribute__((target("sse4.1")))
+void MovementKernel::stepSse41(const MovementColumns& c, int begin, int end, float deltaTime) {
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 dt = _mm_set1_ps(deltaTime);
+    int i = begin;
+    for (; i + 4 <= end; i += 4) {
+        int bytes;
+        std::memcpy(&bytes, c.stepping + i, sizeof(bytes));
+        const __m128 stepMask = _mm_castsi128_ps(_mm_cmpgt_epi32(_mm_cvtepu8_epi32(_mm_cvtsi32_si128(bytes)), _mm_setzero_si128()));
+        if (_mm_movemask_ps(stepMask) == 0) {
+            continue;
+        }
+        const __m128 px = _mm_loadu_ps(c.posX + i);
+        const __m128 py = _mm_loadu_ps(c.posY + i);
+        const __m128 speed = _mm_loadu_ps(c.speed + i);
+        const __m128 dx = _mm_sub_ps(_mm_loadu_ps(c.targetX + i), px);
+        const __m128 dy = _mm_sub_ps(_mm_loadu_ps(c.targetY + i), py);
+        const __m128 distance = _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)));
+        const __m128 moving = _mm_cmpgt_ps(distance, one);
+        const __m128 vx = _mm_mul_ps(_mm_div_ps(dx, distance), speed);
+        const __m128 vy = _mm_mul_ps(_mm_div_ps(dy, distance), speed);
+        const __m128 moveMask = _mm_and_ps(moving, stepMask);
+        _mm_storeu_ps(c.velX + i, _mm_blendv_ps(_mm_loadu_ps(c.velX + i), vx, moveMask));
+        _mm_storeu_ps(c.velY + i, _mm_blendv_ps(_mm_loadu_ps(c.velY + i), vy, moveMask));
+        _mm_storeu_ps(c.posX + i, _mm_blendv_ps(px, _mm_add_ps(px, _mm_mul_ps(vx, dt)), moveMask));
+        _mm_storeu_ps(c.posY + i, _mm_blendv_ps(py, _mm_add_ps(py, _mm_mul_ps(vy, dt)), moveMask));
+        const __m128 left = _mm_blendv_ps(zero, _mm_sub_ps(distance, _mm_mul_ps(speed, dt)), moving);
+        _mm_storeu_ps(c.remaining + i, _mm_blendv_ps(_mm_loadu_ps(c.remaining + i), left, stepMask));
+        storeArrived(c, i, 4, _mm_movemask_ps(moving));
+    }
+    stepScalar(c, i, end, deltaTime);
+}
+
+__attribute__((target("avx2")))
+void MovementKernel::stepAvx2(const MovementColumns& c, int begin, int end, float deltaTime) {
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 dt = _mm256_set1_ps(deltaTime);
+    int i = begin;
+    for (; i + 8 <= end; i += 8) {
+        const __m128i bytes = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(c.stepping + i));
+        const __m256 stepMask = _mm256_castsi256_ps(_mm256_cmpgt_epi32(_mm256_cvtepu8_epi32(bytes), _mm256_setzero_si256()));
+        if (_mm256_movemask_ps(stepMask) == 0) {
+            continue;
+        }
+        const __m256 px = _mm256_loadu_ps(c.posX + i);
+        const __m256 py = _mm256_loadu_ps(c.posY + i);
+        const __m256 speed = _mm256_loadu_ps(c.speed + i);
+        const __m256 dx = _mm256_sub_ps(_mm256_loadu_ps(c.targetX + i), px);
+        const __m256 dy = _mm256_sub_ps(_mm256_loadu_ps(c.targetY + i), py);
+        const __m256 distance = _mm256_sqrt_ps(_mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)));
+        const __m256 moving = _mm256_cmp_ps(distance, one, _CMP_GT_OQ);
+        const __m256 vx = _mm256_mul_ps(_mm256_div_ps(dx, distance), speed);
+        const __m256 vy = _mm256_mul_ps(_mm256_div_ps(dy, distance), speed);
+        const __m256 moveMask = _mm256_and_ps(moving, stepMask);
+        _mm256_storeu_ps(c.velX + i, _mm256_blendv_ps(_mm256_loadu_ps(c.velX + i), vx, moveMask));
+        _mm256_storeu_ps(c.velY + i, _mm256_blendv_ps(_mm256_loadu_ps(c.velY + i), vy, moveMask));
+        _mm256_storeu_ps(c.posX + i, _mm256_blendv_ps(px, _mm256_add_ps(px, _mm256_mul_ps(vx, dt)), moveMask));
+        _mm256_storeu_ps(c.posY + i, _mm256_blendv_ps(py, _mm256_add_ps(py, _mm256_mul_ps(vy, dt)), moveMask));
+        const __m256 left = _mm256_blendv_ps(zero, _mm256_sub_ps(distance, _mm256_mul_ps(speed, dt)), moving);
+        _mm256_storeu_ps(c.remaining + i, _mm256_blendv_ps(_mm256_loadu_ps(c.remaining + i), left, stepMask));
+        storeArrived(c, i, 8, _mm256_movemask_ps(moving));
+    }
+    stepScalar(c, i, end, deltaTime);
+}
+
+#else
+
+void MovementKernel::stepSse41(const MovementColumns& c, int begin, int end, float deltaTime) {
+    stepScalar(c, begin, end, deltaTime);
+}
+
+void MovementKernel::stepAvx2(const MovementColumns& c, int begin, int end, float deltaTime) {
+    stepScalar(c, begin, end, deltaTime);
+}
+
+#endif
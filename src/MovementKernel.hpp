@@ -0,0 +1,50 @@
+#ifndef MOVEMENTKERNEL_HPP
+#define MOVEMENTKERNEL_HPP
+
+#include <cstdint>
+
+// The columns a movement step reads and writes, as laid out by UnitStore
+struct MovementColumns {
+    const std::uint8_t* stepping; // Only these units move
+    const float* targetX;
+    const float* targetY;
+    const float* speed;
+    float* posX;
+    float* posY;
+    float* velX;
+    float* velY;
+    float* remaining; // Distance left to the target after the step
+    std::uint8_t* arrived; // Set when the unit was within 1px of its target
+};
+
+// One movement step toward each unit's target: subtract, length, normalize,
+// advance by speed * deltaTime. A unit already within 1px is marked arrived
+// and keeps its position and velocity. Units not stepping are left alone.
+//
+// There are AVX2 (8 units at a time), SSE4.1 (4) and scalar versions. The
+// best one the CPU supports is picked once at startup. Every version does
+// the same IEEE operations in the same order, with no fused multiply-add or
+// reciprocal estimates, so all of them give bit-identical results.
+class MovementKernel {
+public:
+    enum Isa {
+        Scalar,
+        Sse41,
+        Avx2
+    };
+
+    // With the best supported version
+    static void step(const MovementColumns& columns, int begin, int end, float deltaTime);
+    static void step(Isa isa, const MovementColumns& columns, int begin, int end, float deltaTime);
+
+    static Isa best();
+    static bool isSupported(Isa isa);
+    static const char* name(Isa isa);
+
+private:
+    static void stepScalar(const MovementColumns& columns, int begin, int end, float deltaTime);
+    static void stepSse41(const MovementColumns& columns, int begin, int end, float deltaTime);
+    static void stepAvx2(const MovementColumns& columns, int begin, int end, float deltaTime);
+};
+
+#endif // MOVEMENTKERNEL_HPP
@@ -0,0 +1,989 @@
+// NavigationTests.cpp
+// Headless checks for the navigation structures that are kept up to date
+// incrementally. Each one is driven through random map edits and compared
+// with a fresh rebuild (or a plain reference search) after every step.
+// Build and run with `make test`; exits non-zero if any check fails.
+//   --seed S      first map seed (default 1)
+//   --maps N      random maps per check (default 50)
+#include "DStarLite.hpp"
+#include "FlowField.hpp"
+#include "GridAStar.hpp"
+#include "GridConnectivity.hpp"
+#include "HierarchicalPathfinder.hpp"
+#include "HotMask.hpp"
+#include "IsometricUtils.hpp"
+#include "JumpPointSearch.hpp"
+#include "PathArena.hpp"
+#include "PathCache.hpp"
+#include "PathRequestService.hpp"
+#include "PathScheduler.hpp"
+#include "ReachabilityIndex.hpp"
+#include "RouteSearch.hpp"
+#include "SiegePlanner.hpp"
+#include "TileGrid.hpp"
+#include "WallDistanceField.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+static int failures = 0;
+static const float UNREACHABLE = std::numeric_limits<float>::infinity();
+
+static void check(bool condition, const char* test, const std::string& detail) {
+    if (!condition) {
+        ++failures;
+        std::printf("FAIL %s: %s\n", test, detail.c_str());
+    }
+}
+
+static void placeWall(TileGrid& grid, int index) {
+    grid.setType(index, TileType::Wall);
+    grid.setBlocked(index, true);
+    grid.setHealth(index, 100);
+}
+
+static void clearTile(TileGrid& grid, int index) {
+    grid.setType(index, TileType::Grass);
+    grid.setBlocked(index, false);
+    grid.setHealth(index, 0);
+}
+
+// Random walls (and some walls with a building's block status but no wall
+// type) around a blocked 2x2 town hall in the middle, whose tiles are returned
+static std::vector<int> makeMap(TileGrid& grid, int size, double density, unsigned seed) {
+    grid.resize(size, size);
+    std::mt19937 rng(seed);
+    std::bernoulli_distribution isWall(density);
+    std::uniform_int_distribution<int> health(10, 100);
+    for (int index = 0; index < grid.size(); ++index) {
+        if (isWall(rng)) {
+            placeWall(grid, index);
+            grid.setHealth(index, health(rng));
+        }
+    }
+    const int centre = size / 2;
+    std::vector<int> townHall;
+    for (int row = centre - 2; row <= centre + 1; ++row) {
+        for (int col = centre - 2; col <= centre + 1; ++col) {
+            const int index = grid.index(row, col);
+            clearTile(grid, index);
+            if (row >= centre - 1 && row <= centre && col >= centre - 1 && col <= centre) {
+                grid.setBlocked(index, true);
+                townHall.push_back(index);
+            }
+        }
+    }
+    grid.clearChanges();
+    grid.clearHealthChanges();
+    return townHall;
+}
+
+// A random edit of the kind the game makes: a wall built or knocked down,
+// a wall damaged, or a building (blocked, not a wall) placed or removed.
+// The town hall and its ring are left alone.
+static void randomEdit(TileGrid& grid, std::mt19937& rng) {
+    std::uniform_int_distribution<int> tile(0, grid.size() - 1);
+    std::uniform_int_distribution<int> kind(0, 3);
+    const int centre = grid.getRows() / 2;
+    int index = tile(rng);
+    while (std::abs(grid.rowOf(index) - centre) <= 2 && std::abs(grid.colOf(index) - centre) <= 2) {
+        index = tile(rng);
+    }
+    switch (kind(rng)) {
+        case 0:
+            placeWall(grid, index);
+            break;
+        case 1:
+            clearTile(grid, index);
+            break;
+        case 2:
+            if (grid.getType(index) == TileType::Wall) {
+                grid.setHealth(index, std::max(1, grid.getHealth(index) / 2));
+            }
+            break;
+        default:
+            grid.setType(index, TileType::Grass);
+            grid.setBlocked(index, !grid.isBlocked(index));
+            grid.setHealth(index, 0);
+            break;
+    }
+}
+
+// DStarLite's edge costs, written out independently
+static float breachStepCost(const TileGrid& grid, const std::vector<std::uint8_t>& goal, int from, int to) {
+    if (grid.isBlocked(from) && grid.getType(from) != TileType::Wall) {
+        return UNREACHABLE;
+    }
+    float enter = 0.0f;
+    if (!goal[to] && grid.isBlocked(to)) {
+        if (grid.getType(to) != TileType::Wall) {
+            return UNREACHABLE;
+        }
+        enter = static_cast<float>(grid.getHealth(to)) * DStarLite::DEFAULT_WALL_COST_PER_HEALTH;
+    }
+    const int fromRow = grid.rowOf(from);
+    const int fromCol = grid.colOf(from);
+    const int toRow = grid.rowOf(to);
+    const int toCol = grid.colOf(to);
+    if (fromRow != toRow && fromCol != toCol) {
+        if (grid.isBlocked(grid.index(fromRow, toCol)) || grid.isBlocked(grid.index(toRow, fromCol))) {
+            return UNREACHABLE;
+        }
+        return DIAGONAL_STEP_COST + enter;
+    }
+    return 1.0f + enter;
+}
+
+// FlowField's step costs, written out independently
+static float flowStepCost(const TileGrid& grid, const std::vector<std::uint8_t>& goal, int from, int to) {
+    if (grid.isBlocked(from) && grid.getType(from) != TileType::Wall) {
+        return UNREACHABLE;
+    }
+    float enter = 0.0f;
+    if (!goal[to] && grid.isBlocked(to)) {
+        if (grid.getType(to) != TileType::Wall) {
+            return UNREACHABLE;
+        }
+        enter = FlowField::WALL_COST;
+    }
+    const int fromRow = grid.rowOf(from);
+    const int fromCol = grid.colOf(from);
+    const int toRow = grid.rowOf(to);
+    const int toCol = grid.colOf(to);
+    if (fromRow != toRow && fromCol != toCol) {
+        if (grid.isBlocked(grid.index(fromRow, toCol)) || grid.isBlocked(grid.index(toRow, fromCol))) {
+            return UNREACHABLE;
+        }
+        return DIAGONAL_STEP_COST + enter;
+    }
+    return 1.0f + enter;
+}
+
+// Reference: plain Dijkstra backward from the goals, with the given step costs
+static std::vector<float> backwardDistances(const TileGrid& grid, const std::vector<int>& goals,
+                                            float (*stepCost)(const TileGrid&, const std::vector<std::uint8_t>&, int, int)) {
+    std::vector<std::uint8_t> goal(grid.size(), 0);
+    std::vector<float> distance(grid.size(), UNREACHABLE);
+    using Item = std::pair<float, int>;
+    std::priority_queue<Item, std::vector<Item>, std::greater<Item>> open;
+    for (int tile : goals) {
+        goal[tile] = 1;
+        distance[tile] = 0.0f;
+        open.push(Item(0.0f, tile));
+    }
+    while (!open.empty()) {
+        const Item top = open.top();
+        open.pop();
+        if (top.first > distance[top.second]) {
+            continue;
+        }
+        forEachNeighbor<MapConnectivity>(grid, top.second, [&](int predecessor, int) {
+            if (goal[predecessor]) {
+                return;
+            }
+            const float candidate = stepCost(grid, goal, predecessor, top.second) + top.first;
+            if (candidate < distance[predecessor]) {
+                distance[predecessor] = candidate;
+                open.push(Item(candidate, predecessor));
+            }
+        });
+    }
+    return distance;
+}
+
+static std::vector<float> breachDistances(const TileGrid& grid, const std::vector<int>& goals) {
+    return backwardDistances(grid, goals, breachStepCost);
+}
+
+// Cost of walking path, or UNREACHABLE if a step is not allowed
+static float breachPathCost(const TileGrid& grid, const std::vector<int>& goals, const std::vector<int>& path) {
+    std::vector<std::uint8_t> goal(grid.size(), 0);
+    for (int tile : goals) {
+        goal[tile] = 1;
+    }
+    float cost = 0.0f;
+    for (size_t i = 1; i < path.size(); ++i) {
+        const int dRow = grid.rowOf(path[i]) - grid.rowOf(path[i - 1]);
+        const int dCol = grid.colOf(path[i]) - grid.colOf(path[i - 1]);
+        if (!MapConnectivity::isStep(dRow, dCol)) {
+            return UNREACHABLE;
+        }
+        cost += breachStepCost(grid, goal, path[i - 1], path[i]);
+    }
+    return path.empty() || !goal[path.back()] ? UNREACHABLE : cost;
+}
+
+static bool sameCost(float a, float b) {
+    if (a == UNREACHABLE || b == UNREACHABLE) {
+        return a == b;
+    }
+    return std::fabs(a - b) <= 1e-3f * std::max(1.0f, std::fabs(b));
+}
+
+// Random edits repaired with applyChanges against a field built from
+// scratch: every tile must agree on reachability and distance, and its next
+// step must lead one step closer. The rebuilt field is checked against a
+// plain Dijkstra too.
+static void testFlowField(unsigned seed, int maps) {
+    for (int m = 0; m < maps; ++m) {
+        std::mt19937 rng(seed + m);
+        TileGrid grid;
+        const int size = 20 + static_cast<int>(rng() % 21);
+        const std::vector<int> townHall = makeMap(grid, size, 0.25, seed + m);
+        FlowField incremental;
+        incremental.build(grid, townHall);
+        for (int round = 0; round < 12; ++round) {
+            const int edits = 1 + static_cast<int>(rng() % 6);
+            for (int e = 0; e < edits; ++e) {
+                randomEdit(grid, rng);
+            }
+            incremental.applyChanges(grid, grid.getChanges());
+            grid.clearChanges();
+            grid.clearHealthChanges();
+
+            FlowField fresh;
+            fresh.build(grid, townHall);
+            const std::vector<float> reference = backwardDistances(grid, townHall, flowStepCost);
+            const std::string where = "map " + std::to_string(seed + m) + " round " + std::to_string(round);
+            int differing = 0;
+            for (int tile = 0; tile < grid.size(); ++tile) {
+                differing += sameCost(fresh.isReachable(tile) ? fresh.getDistance(tile) : UNREACHABLE, reference[tile]) ? 0 : 1;
+            }
+            check(differing == 0, "flowfield", where + ": " + std::to_string(differing) + " built distance(s) differ from a plain Dijkstra");
+            for (int tile = 0; tile < grid.size(); ++tile) {
+                const float distance = incremental.isReachable(tile) ? incremental.getDistance(tile) : UNREACHABLE;
+                const float expected = fresh.isReachable(tile) ? fresh.getDistance(tile) : UNREACHABLE;
+                if (!sameCost(distance, expected)) {
+                    check(false, "flowfield", where + ": tile " + std::to_string(tile) + " distance " +
+                                                  std::to_string(distance) + ", rebuilt " + std::to_string(expected));
+                    continue;
+                }
+                const int next = incremental.getNextStep(tile);
+                if (distance != UNREACHABLE && !incremental.isGoal(tile) &&
+                    (next < 0 || !(incremental.getDistance(next) < distance))) {
+                    check(false, "flowfield", where + ": tile " + std::to_string(tile) + " does not step downhill");
+                }
+            }
+        }
+    }
+}
+
+// Length of a route under GridAStar's rules (open tiles but the last, no
+// cutting corners), or UNREACHABLE if it breaks them
+static float routeCost(const TileGrid& grid, const std::vector<int>& path) {
+    float cost = 0.0f;
+    for (size_t i = 1; i < path.size(); ++i) {
+        const int fromRow = grid.rowOf(path[i - 1]);
+        const int fromCol = grid.colOf(path[i - 1]);
+        const int toRow = grid.rowOf(path[i]);
+        const int toCol = grid.colOf(path[i]);
+        if (!MapConnectivity::isStep(toRow - fromRow, toCol - fromCol) ||
+            (grid.isBlocked(path[i]) && i + 1 < path.size())) {
+            return UNREACHABLE;
+        }
+        if (fromRow != toRow && fromCol != toCol) {
+            if (grid.isBlocked(grid.index(fromRow, toCol)) || grid.isBlocked(grid.index(toRow, fromCol))) {
+                return UNREACHABLE;
+            }
+            cost += DIAGONAL_STEP_COST;
+        } else {
+            cost += 1.0f;
+        }
+    }
+    return path.empty() ? UNREACHABLE : cost;
+}
+
+// Clusters rebuilt by applyChanges against an abstraction built from
+// scratch: same abstract graph, and the same route for every query
+static void testHierarchical(unsigned seed, int maps) {
+    for (int m = 0; m < maps; ++m) {
+        std::mt19937 rng(seed + m);
+        TileGrid grid;
+        const int size = 48 + static_cast<int>(rng() % 49);
+        const std::vector<int> townHall = makeMap(grid, size, 0.25, seed + m);
+        HierarchicalPathfinder incremental;
+        incremental.build(grid);
+        std::uniform_int_distribution<int> tile(0, grid.size() - 1);
+        for (int round = 0; round < 8; ++round) {
+            const int edits = 1 + static_cast<int>(rng() % 6);
+            for (int e = 0; e < edits; ++e) {
+                randomEdit(grid, rng);
+            }
+            incremental.applyChanges(grid, grid.getChanges());
+            grid.clearChanges();
+            grid.clearHealthChanges();
+
+            HierarchicalPathfinder fresh;
+            fresh.build(grid);
+            const std::string where = "map " + std::to_string(seed + m) + " round " + std::to_string(round);
+            check(incremental.getAbstractNodeCount() == fresh.getAbstractNodeCount(), "hierarchical",
+                  where + ": abstract node count differs from a rebuild");
+            for (int query = 0; query < 5; ++query) {
+                const int start = tile(rng);
+                std::vector<int> path;
+                std::vector<int> freshPath;
+                const bool found = incremental.findPath(grid, start, townHall[0], path);
+                fresh.findPath(grid, start, townHall[0], freshPath);
+                check(path == freshPath, "hierarchical",
+                      where + " start " + std::to_string(start) + ": route differs from a rebuild");
+                check(!found || (path.front() == start && path.back() == townHall[0] && routeCost(grid, path) != UNREACHABLE),
+                      "hierarchical", where + " start " + std::to_string(start) + ": route breaks the movement rules");
+            }
+        }
+    }
+}
+
+// Jump tables patched by applyChanges against ones built from scratch: the
+// same route for every query, as short as GridAStar's
+static void testJumpPoint(unsigned seed, int maps) {
+    GridAStar astar;
+    for (int m = 0; m < maps; ++m) {
+        std::mt19937 rng(seed + m);
+        TileGrid grid;
+        const int size = 20 + static_cast<int>(rng() % 41);
+        const std::vector<int> townHall = makeMap(grid, size, 0.25, seed + m);
+        JumpPointSearch incremental;
+        incremental.build(grid);
+        std::uniform_int_distribution<int> tile(0, grid.size() - 1);
+        for (int round = 0; round < 12; ++round) {
+            const int edits = 1 + static_cast<int>(rng() % 6);
+            for (int e = 0; e < edits; ++e) {
+                randomEdit(grid, rng);
+            }
+            incremental.applyChanges(grid, grid.getChanges());
+            grid.clearChanges();
+            grid.clearHealthChanges();
+
+            JumpPointSearch fresh;
+            fresh.build(grid);
+            const std::string where = "map " + std::to_string(seed + m) + " round " + std::to_string(round);
+            for (int query = 0; query < 5; ++query) {
+                const int start = tile(rng);
+                if (grid.isBlocked(start)) {
+                    continue;
+                }
+                std::vector<int> path;
+                std::vector<int> freshPath;
+                std::vector<int> astarPath;
+                const bool found = incremental.findPath(grid, start, townHall[0], path);
+                fresh.findPath(grid, start, townHall[0], freshPath);
+                const bool astarFound = astar.findPath(grid, start, townHall[0], astarPath);
+                const std::string label = where + " start " + std::to_string(start);
+                check(path == freshPath, "jumppoint", label + ": route differs from a rebuild");
+                check(found == astarFound, "jumppoint", label + ": reachability differs from A*");
+                if (found && astarFound) {
+                    check(sameCost(routeCost(grid, path), routeCost(grid, astarPath)), "jumppoint",
+                          label + ": route is " + std::to_string(routeCost(grid, path)) + " long, A* found " +
+                              std::to_string(routeCost(grid, astarPath)));
+                }
+            }
+        }
+    }
+}
+
+// Repaired nearest-wall field against a rebuild, which must match tile for
+// tile since ties are broken by index, and against a brute-force scan
+static void testWallDistance(unsigned seed, int maps) {
+    for (int m = 0; m < maps; ++m) {
+        std::mt19937 rng(seed + m);
+        TileGrid grid;
+        const int size = 10 + static_cast<int>(rng() % 31);
+        makeMap(grid, size, 0.05 + 0.05 * static_cast<double>(m % 4), seed + m);
+        WallDistanceField incremental;
+        incremental.build(grid);
+        for (int round = 0; round < 12; ++round) {
+            const int edits = 1 + static_cast<int>(rng() % 6);
+            for (int e = 0; e < edits; ++e) {
+                randomEdit(grid, rng);
+            }
+            incremental.applyChanges(grid, grid.getChanges());
+            grid.clearChanges();
+            grid.clearHealthChanges();
+
+            WallDistanceField fresh;
+            fresh.build(grid);
+            const std::string where = "map " + std::to_string(seed + m) + " round " + std::to_string(round);
+            for (int tile = 0; tile < grid.size(); ++tile) {
+                int nearest = -1;
+                int distance = -1;
+                for (int wall = 0; wall < grid.size(); ++wall) {
+                    const int steps = std::abs(grid.rowOf(wall) - grid.rowOf(tile)) + std::abs(grid.colOf(wall) - grid.colOf(tile));
+                    if (grid.isBlocked(wall) && (distance < 0 || steps < distance)) {
+                        nearest = wall;
+                        distance = steps;
+                    }
+                }
+                check(incremental.getNearestWall(tile) == fresh.getNearestWall(tile) &&
+                          incremental.getDistance(tile) == fresh.getDistance(tile),
+                      "walldistance", where + ": tile " + std::to_string(tile) + " differs from a rebuild");
+                check(incremental.getDistance(tile) == distance && (nearest < 0) == (incremental.getNearestWall(tile) < 0),
+                      "walldistance", where + ": tile " + std::to_string(tile) + " is " +
+                                          std::to_string(incremental.getDistance(tile)) + " from a wall, not " +
+                                          std::to_string(distance));
+            }
+        }
+    }
+}
+
+// Layout edit: a tile outside the town hall's ring becomes open, a wall of
+// random health, or a building, whichever it is not. Unlike randomEdit it
+// never only changes a wall's health, which leaves the siege plan alone.
+static void layoutEdit(TileGrid& grid, std::mt19937& rng, const std::vector<int>& keepOpen) {
+    std::uniform_int_distribution<int> tile(0, grid.size() - 1);
+    const int centre = grid.getRows() / 2;
+    int index = tile(rng);
+    while ((std::abs(grid.rowOf(index) - centre) <= 2 && std::abs(grid.colOf(index) - centre) <= 2) ||
+           std::find(keepOpen.begin(), keepOpen.end(), index) != keepOpen.end()) {
+        index = tile(rng);
+    }
+    const int current = !grid.isBlocked(index) ? 0 : grid.getType(index) == TileType::Wall ? 1 : 2;
+    const int next = (current + 1 + static_cast<int>(rng() % 2)) % 3;
+    clearTile(grid, index);
+    if (next == 1) {
+        placeWall(grid, index);
+        grid.setHealth(index, 10 + static_cast<int>(rng() % 91));
+    } else if (next == 2) {
+        grid.setBlocked(index, true);
+    }
+}
+
+// Whether a spawn tile walks to a tile next to a goal over open tiles only,
+// in four-way steps as the siege planner's network links them
+static bool openRouteExists(const TileGrid& grid, const std::vector<int>& goals, const std::vector<int>& spawns) {
+    std::vector<std::uint8_t> seen(grid.size(), 0);
+    std::vector<int> queue;
+    for (int spawn : spawns) {
+        if (!grid.isBlocked(spawn)) {
+            seen[spawn] = 1;
+            queue.push_back(spawn);
+        }
+    }
+    for (size_t head = 0; head < queue.size(); ++head) {
+        bool found = false;
+        forEachNeighbor<FourWayConnectivity>(grid, queue[head], [&](int neighbor, int) {
+            if (std::find(goals.begin(), goals.end(), neighbor) != goals.end()) {
+                found = true;
+            } else if (!seen[neighbor] && !grid.isBlocked(neighbor)) {
+                seen[neighbor] = 1;
+                queue.push_back(neighbor);
+            }
+        });
+        if (found) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// A town hall behind a ring of walls, edited a layout change at a time. The
+// plan made after applyChanges must be the one a fresh planner makes; when
+// sealed, its cut must cost what its walls hold and opening them must give
+// a spawn tile an open route in. Wall damage alone must not trigger a replan.
+static void testSiegePlanner(unsigned seed, int maps) {
+    for (int m = 0; m < maps; ++m) {
+        std::mt19937 rng(seed + m);
+        TileGrid grid;
+        const int size = 16 + static_cast<int>(rng() % 17);
+        const std::vector<int> townHall = makeMap(grid, size, 0.15, seed + m);
+        const int centre = size / 2;
+        for (int row = centre - 5; row <= centre + 4; ++row) {
+            for (int col = centre - 5; col <= centre + 4; ++col) {
+                if (row == centre - 5 || row == centre + 4 || col == centre - 5 || col == centre + 4) {
+                    placeWall(grid, grid.index(row, col));
+                    grid.setHealth(grid.index(row, col), 10 + static_cast<int>(rng() % 91));
+                }
+            }
+        }
+        const std::vector<int> spawns = {0, size - 1, grid.index(size - 1, 0), grid.size() - 1};
+        for (int spawn : spawns) {
+            clearTile(grid, spawn);
+        }
+        grid.clearChanges();
+        grid.clearHealthChanges();
+        SiegePlanner incremental;
+        incremental.build(grid, spawns, townHall);
+        for (int round = 0; round < 12; ++round) {
+            const int edits = 1 + static_cast<int>(rng() % 4);
+            for (int e = 0; e < edits; ++e) {
+                layoutEdit(grid, rng, spawns);
+            }
+            incremental.applyChanges(grid, grid.getChanges());
+            incremental.update(grid);
+            grid.clearChanges();
+            grid.clearHealthChanges();
+
+            SiegePlanner fresh;
+            fresh.build(grid, spawns, townHall);
+            std::vector<int> cut = incremental.getCutWalls();
+            std::vector<int> freshCut = fresh.getCutWalls();
+            std::sort(cut.begin(), cut.end());
+            std::sort(freshCut.begin(), freshCut.end());
+            const std::string where = "map " + std::to_string(seed + m) + " round " + std::to_string(round);
+            check(cut == freshCut && incremental.getCutHealth() == fresh.getCutHealth(), "siegeplanner",
+                  where + ": cut differs from a fresh plan");
+            bool sameTargets = true;
+            for (int tile = 0; tile < grid.size(); ++tile) {
+                sameTargets = sameTargets && incremental.getTarget(tile) == fresh.getTarget(tile);
+            }
+            check(sameTargets, "siegeplanner", where + ": targets differ from a fresh plan");
+            check(incremental.isSealed() == !openRouteExists(grid, townHall, spawns), "siegeplanner",
+                  where + ": sealed should mean no open route");
+            if (incremental.isSealed()) {
+                std::int64_t health = 0;
+                TileGrid breached = grid;
+                for (int wall : cut) {
+                    health += grid.getHealth(wall);
+                    clearTile(breached, wall);
+                }
+                check(health == incremental.getCutHealth(), "siegeplanner", where + ": cut health is not its walls' total");
+                check(openRouteExists(breached, townHall, spawns), "siegeplanner", where + ": breaching the cut opens no route");
+            }
+        }
+
+        const int plans = incremental.getPlanCount();
+        for (int tile : incremental.getCutWalls()) {
+            grid.setHealth(tile, std::max(1, grid.getHealth(tile) / 2));
+        }
+        incremental.applyChanges(grid, grid.getChanges());
+        incremental.update(grid);
+        grid.clearHealthChanges();
+        check(incremental.getPlanCount() == plans, "siegeplanner", "map " + std::to_string(seed + m) + ": wall damage replanned");
+    }
+}
+
+// The incrementally repaired planner, queried from changing starts after
+// every batch of edits, against a freshly built one and a reference Dijkstra
+static void testBreachPlanner(unsigned seed, int maps) {
+    for (int m = 0; m < maps; ++m) {
+        std::mt19937 rng(seed + m);
+        TileGrid grid;
+        const int size = 20 + static_cast<int>(rng() % 21);
+        const std::vector<int> townHall = makeMap(grid, size, 0.25, seed + m);
+        DStarLite incremental;
+        incremental.build(grid, townHall);
+        std::uniform_int_distribution<int> tile(0, grid.size() - 1);
+        for (int round = 0; round < 12; ++round) {
+            const int edits = 1 + static_cast<int>(rng() % 6);
+            for (int e = 0; e < edits; ++e) {
+                randomEdit(grid, rng);
+            }
+            incremental.applyChanges(grid, grid.getChanges());
+            incremental.applyChanges(grid, grid.getHealthChanges());
+            grid.clearChanges();
+            grid.clearHealthChanges();
+
+            DStarLite fresh;
+            fresh.build(grid, townHall);
+            const std::vector<float> reference = breachDistances(grid, townHall);
+            for (int query = 0; query < 5; ++query) {
+                const int start = tile(rng);
+                std::vector<int> path;
+                std::vector<int> freshPath;
+                const bool found = incremental.findPath(grid, start, path);
+                const bool freshFound = fresh.findPath(grid, start, freshPath);
+                const float cost = found ? breachPathCost(grid, townHall, path) : UNREACHABLE;
+                const float freshCost = freshFound ? breachPathCost(grid, townHall, freshPath) : UNREACHABLE;
+                const std::string where = "map " + std::to_string(seed + m) + " round " + std::to_string(round) +
+                                          " start " + std::to_string(start);
+                check(sameCost(freshCost, reference[start]), "dstarlite", where + ": fresh build differs from Dijkstra");
+                check(sameCost(cost, reference[start]), "dstarlite",
+                      where + ": incremental cost " + std::to_string(cost) + ", optimal " + std::to_string(reference[start]));
+            }
+        }
+    }
+}
+
+// Spawn tiles that reach a goal according to a freshly built flow field
+static std::vector<int> reachingSpawns(const TileGrid& grid, const std::vector<int>& goals, const std::vector<int>& spawns) {
+    FlowField field;
+    field.build(grid, goals);
+    std::vector<int> reaching;
+    for (int spawn : spawns) {
+        if (field.isReachable(spawn)) {
+            reaching.push_back(spawn);
+        }
+    }
+    return reaching;
+}
+
+// The incrementally repaired index against a flow field built from scratch:
+// reachesGoal for every tile, and wouldSeal against actually placing a
+// building and checking which spawn tiles lost their way. A wall placed
+// instead must never cut a spawn off, which is why Map lets walls close the
+// town hall in without asking.
+static void testReachability(unsigned seed, int maps) {
+    for (int m = 0; m < maps; ++m) {
+        std::mt19937 rng(seed + m);
+        TileGrid grid;
+        const int size = 12 + static_cast<int>(rng() % 21);
+        const std::vector<int> townHall = makeMap(grid, size, 0.3, seed + m);
+        std::vector<std::uint8_t> isGoal(grid.size(), 0);
+        for (int tile : townHall) {
+            isGoal[tile] = 1;
+        }
+        std::uniform_int_distribution<int> tile(0, grid.size() - 1);
+        std::vector<int> spawns;
+        for (int s = 0; s < 4; ++s) {
+            spawns.push_back(tile(rng));
+        }
+        ReachabilityIndex index;
+        index.build(grid, townHall, spawns);
+        for (int round = 0; round < 12; ++round) {
+            const int edits = 1 + static_cast<int>(rng() % 4);
+            for (int e = 0; e < edits; ++e) {
+                randomEdit(grid, rng);
+            }
+            index.applyChanges(grid, grid.getChanges());
+            grid.clearChanges();
+            grid.clearHealthChanges();
+
+            const std::string where = "map " + std::to_string(seed + m) + " round " + std::to_string(round);
+            FlowField field;
+            field.build(grid, townHall);
+            for (int t = 0; t < grid.size(); ++t) {
+                if (!isGoal[t] && index.reachesGoal(grid, t) != field.isReachable(t)) {
+                    check(false, "reachability", where + ": reachesGoal differs at tile " + std::to_string(t));
+                }
+            }
+
+            const std::vector<int> before = reachingSpawns(grid, townHall, spawns);
+            for (int query = 0; query < 4; ++query) {
+                const int candidate = tile(rng);
+                if (isGoal[candidate] || grid.isBlocked(candidate)) {
+                    continue;
+                }
+                TileGrid walled = grid;
+                placeWall(walled, candidate);
+                check(reachingSpawns(walled, townHall, spawns) == before, "reachability",
+                      where + ": a wall at " + std::to_string(candidate) + " cut a spawn off");
+
+                TileGrid built = grid;
+                built.setType(candidate, TileType::Tower);
+                built.setBlocked(candidate, true);
+                std::vector<int> after = reachingSpawns(built, townHall, spawns);
+                std::vector<int> expected;
+                for (int spawn : before) {
+                    if (spawn != candidate) {
+                        expected.push_back(spawn);
+                    }
+                }
+                const bool seals = after != expected;
+                check(index.wouldSeal(grid, candidate) == seals, "reachability",
+                      where + ": wouldSeal(" + std::to_string(candidate) + ") should be " + (seals ? "true" : "false"));
+                if (!seals && query == 0) {
+                    // Place it, as Map does once canBlockTile agrees
+                    grid.setType(candidate, TileType::Tower);
+                    grid.setBlocked(candidate, true);
+                    index.applyChanges(grid, grid.getChanges());
+                    grid.clearChanges();
+                    break;
+                }
+            }
+        }
+    }
+}
+
+// Query through the cache the way Pathfinding::findPath does
+static std::vector<int> cachedPath(PathCache& cache, const TileGrid& grid, int start, int goal, bool& hit) {
+    static GridAStar search;
+    std::vector<int> path;
+    hit = cache.lookup(grid, start, goal, 0, path);
+    if (!hit) {
+        std::vector<int> route;
+        search.findPath(grid, start, goal, route);
+        path = route;
+        stopShortOfBlocked(grid, path, 0);
+        cache.insert(grid, start, goal, 0, route, path);
+    }
+    return path;
+}
+
+// A wall down column 5 with a gap at the bottom: the cached route detours
+// through the gap until the wall is broken, and a tile blocked off the
+// route leaves the entry alone
+static void testPathCache() {
+    TileGrid grid(10, 10);
+    for (int row = 0; row < 9; ++row) {
+        placeWall(grid, grid.index(row, 5));
+    }
+    grid.clearChanges();
+    PathCache cache;
+    cache.build(grid);
+    const int start = grid.index(0, 0);
+    const int goal = grid.index(0, 9);
+    bool hit = false;
+    const std::vector<int> detour = cachedPath(cache, grid, start, goal, hit);
+    check(!hit && detour.size() > 10, "pathcache", "first query should search and detour");
+
+    placeWall(grid, grid.index(9, 0)); // Nowhere near the route
+    cache.applyChanges(grid, grid.getChanges());
+    grid.clearChanges();
+    cachedPath(cache, grid, start, goal, hit);
+    check(hit, "pathcache", "blocking a tile off the route should keep the entry");
+
+    clearTile(grid, grid.index(0, 5));
+    cache.applyChanges(grid, grid.getChanges());
+    grid.clearChanges();
+    const std::vector<int> direct = cachedPath(cache, grid, start, goal, hit);
+    check(!hit, "pathcache", "opening a wall should drop the cached detour");
+    check(direct.size() == 10, "pathcache", "route through the broken wall should be straight");
+
+    placeWall(grid, grid.index(0, 5));
+    cache.applyChanges(grid, grid.getChanges());
+    grid.clearChanges();
+    cachedPath(cache, grid, start, goal, hit);
+    check(!hit, "pathcache", "blocking a tile on the route should evict it");
+}
+
+// Worker threads pick the same backend (HPA* above the size threshold, JPS
+// when asked) as a search run directly on the map
+static void testPathRequests(unsigned seed, int maps) {
+    PathRequestService service(2);
+    GridAStar astar;
+    HierarchicalPathfinder hierarchical;
+    JumpPointSearch jumpPoint;
+    const int size = 136; // Over HIERARCHICAL_MIN_TILES
+    TileGrid grid; // One grid throughout, so its version only goes up, as in game
+    for (int m = 0; m < maps / 10 + 1; ++m) {
+        const std::vector<int> townHall = makeMap(grid, size, 0.2, seed + m);
+        hierarchical.build(grid);
+        jumpPoint.build(grid);
+        for (RouteBackend backend : {RouteBackend::AStar, RouteBackend::JumpPoint}) {
+            const int start = grid.index(0, (m * 37) % size);
+            PathTicket ticket = service.submit(grid, start, townHall[0], 0, backend);
+            while (!ticket.isReady()) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            const PathResult result = ticket.take();
+            std::vector<int> expected;
+            searchRoute(backend, grid, astar, hierarchical, jumpPoint, start, townHall[0], expected);
+            check(result.route == expected, "pathrequests",
+                  "map " + std::to_string(seed + m) + ": worker route differs from searchRoute");
+        }
+    }
+}
+
+// One pass of the time-sliced scheduler over the same submissions: the
+// requests in the order they finished, with the frame each finished on
+struct ScheduleRun {
+    std::vector<int> finished;
+    std::vector<int> finishFrame;
+    std::vector<PathResult> results;
+    int pausedFrames = 0; // Frames that ended with a search half done
+};
+
+static ScheduleRun runSchedule(const TileGrid& grid, const std::vector<int>& starts, int goal, const std::string& where) {
+    PathScheduler scheduler;
+    scheduler.setFrameBudget(10); // 40 expansions at the default cost
+    std::vector<PathTicket> tickets;
+    for (int start : starts) {
+        tickets.push_back(scheduler.submit(grid, start, goal, 0));
+    }
+    ScheduleRun run;
+    run.results.resize(starts.size());
+    for (int frame = 0; scheduler.getQueuedCount() > 0 && frame < 100000; ++frame) {
+        scheduler.runFrame(grid);
+        check(scheduler.getLastFrameExpansions() <= scheduler.getExpansionBudget(), "pathscheduler",
+              where + ": frame " + std::to_string(frame) + " spent " + std::to_string(scheduler.getLastFrameExpansions()) +
+                  " expansions of " + std::to_string(scheduler.getExpansionBudget()));
+        for (size_t i = 0; i < tickets.size(); ++i) {
+            if (tickets[i].isPending() && tickets[i].isReady()) {
+                run.results[i] = tickets[i].take();
+                run.finished.push_back(static_cast<int>(i));
+                run.finishFrame.push_back(frame);
+            }
+        }
+        run.pausedFrames += scheduler.getQueuedCount() > 0 &&
+                            scheduler.getLastFrameExpansions() == scheduler.getExpansionBudget();
+    }
+    check(run.finished.size() == starts.size(), "pathscheduler", where + ": not every request finished");
+    return run;
+}
+
+// Searches resumed over many small frames against a one-shot search, the
+// same submissions run twice, and the per-frame expansion budget
+static void testPathScheduler(unsigned seed, int maps) {
+    GridAStar astar;
+    HierarchicalPathfinder hierarchical;
+    JumpPointSearch jumpPoint;
+    int pausedFrames = 0;
+    for (int m = 0; m < maps; ++m) {
+        std::mt19937 rng(seed + m);
+        TileGrid grid;
+        const int size = 30 + static_cast<int>(rng() % 31);
+        const std::vector<int> townHall = makeMap(grid, size, 0.2, seed + m);
+        std::uniform_int_distribution<int> tile(0, grid.size() - 1);
+        std::vector<int> starts;
+        while (starts.size() < 12) {
+            const int start = tile(rng);
+            if (!grid.isBlocked(start)) {
+                starts.push_back(start);
+            }
+        }
+        const std::string where = "map " + std::to_string(seed + m);
+        const ScheduleRun first = runSchedule(grid, starts, townHall[0], where);
+        const ScheduleRun second = runSchedule(grid, starts, townHall[0], where);
+        check(first.finished == second.finished && first.finishFrame == second.finishFrame, "pathscheduler",
+              where + ": two runs finished in a different order");
+        pausedFrames += first.pausedFrames;
+        for (size_t i = 0; i < starts.size(); ++i) {
+            std::vector<int> expected;
+            searchRoute(RouteBackend::AStar, grid, astar, hierarchical, jumpPoint, starts[i], townHall[0], expected);
+            check(first.results[i].route == expected, "pathscheduler",
+                  where + " start " + std::to_string(starts[i]) + ": sliced route differs from a one-shot search");
+        }
+    }
+    check(maps == 0 || pausedFrames > 0, "pathscheduler", "no search was ever resumed on a later frame");
+}
+
+// HotMask::stamp only looks at the tiles near the centre; it must mark the
+// same tiles as testing every one, wherever the centre is
+static void testHotMaskStamp(unsigned seed, int maps) {
+    for (int m = 0; m < maps; ++m) {
+        std::mt19937 rng(seed + m);
+        TileGrid grid;
+        grid.resize(10 + static_cast<int>(rng() % 41), 10 + static_cast<int>(rng() % 41));
+        std::vector<sf::Vector2f> positions(grid.size());
+        for (int tile = 0; tile < grid.size(); ++tile) {
+            positions[tile] = IsometricUtils::tileToScreen(grid.rowOf(tile), grid.colOf(tile));
+        }
+        std::uniform_real_distribution<float> jitter(-80.0f, 80.0f);
+        for (int stamp = 0; stamp < 20; ++stamp) {
+            const sf::Vector2f centre = positions[rng() % grid.size()] + sf::Vector2f(jitter(rng), jitter(rng));
+            const float radius = 20.0f + static_cast<float>(rng() % 381);
+            HotMask hot;
+            hot.reset(grid.size());
+            hot.stamp(grid, positions, centre, radius);
+            int missed = 0;
+            for (int tile = 0; tile < grid.size(); ++tile) {
+                const sf::Vector2f offset = positions[tile] - centre;
+                missed += (offset.x * offset.x + offset.y * offset.y <= radius * radius) != hot.isHot(tile) ? 1 : 0;
+            }
+            check(missed == 0, "hotmask", "map " + std::to_string(seed + m) + " stamp " + std::to_string(stamp) + ": " +
+                                              std::to_string(missed) + " tile(s) marked differently from a full scan");
+        }
+    }
+}
+
+struct TowerRange {
+    sf::Vector2f centre;
+    float range;
+};
+
+// Screen distance walked along path (starting at its first tile) before a
+// tower's range is entered, or infinity if it never is
+static float distanceToRange(const std::vector<sf::Vector2f>& positions, const std::vector<int>& path,
+                             const std::vector<TowerRange>& towers) {
+    const float step = 2.0f;
+    float walked = 0.0f;
+    for (size_t i = 1; i < path.size(); ++i) {
+        const sf::Vector2f from = positions[path[i - 1]];
+        const sf::Vector2f offset = positions[path[i]] - from;
+        const float length = std::sqrt(offset.x * offset.x + offset.y * offset.y);
+        for (float along = 0.0f; along <= length; along += step) {
+            const sf::Vector2f point = length > 0.0f ? from + offset * (along / length) : from;
+            for (const TowerRange& tower : towers) {
+                const sf::Vector2f toTower = point - tower.centre;
+                if (toTower.x * toTower.x + toTower.y * toTower.y <= tower.range * tower.range) {
+                    return walked + along;
+                }
+            }
+        }
+        walked += length;
+    }
+    return UNREACHABLE;
+}
+
+// The coarse walk a fast-forward jumps by must end before a unit enters a
+// tower's range, even when a smoothed segment runs through it between two
+// cold waypoints
+static void testColdWalk(unsigned seed, int maps) {
+    const float margin = 96.0f; // SimulationLod::INTERACTION_MARGIN
+    const float speed = 40.0f;
+    const float limit = 1000.0f;
+    PathArena arena;
+    TileGrid grid;
+    std::vector<sf::Vector2f> positions;
+    auto layOut = [&grid, &positions](int size) {
+        grid.resize(size, size);
+        positions.resize(grid.size());
+        for (int tile = 0; tile < grid.size(); ++tile) {
+            positions[tile] = IsometricUtils::tileToScreen(grid.rowOf(tile), grid.colOf(tile));
+        }
+    };
+
+    layOut(40);
+    HotMask hot;
+    hot.reset(grid.size());
+    const std::vector<TowerRange> tower = {{positions[grid.index(20, 20)], 120.0f}};
+    hot.stamp(grid, positions, tower[0].centre, tower[0].range + margin);
+    const std::vector<int> straight = {grid.index(20, 2), grid.index(20, 6), grid.index(20, 38)};
+    check(!hot.isHot(straight[1]) && !hot.isHot(straight[2]) && distanceToRange(positions, straight, tower) < UNREACHABLE,
+          "coldwalk", "the straight segment does not run from cold to cold through the range");
+    const float time = hot.coldWalkTime(grid, positions, arena.intern(straight), 1, straight[0], positions[straight[0]], speed, limit);
+    const sf::Vector2f first = positions[straight[1]] - positions[straight[0]];
+    check(std::fabs(time * speed - std::sqrt(first.x * first.x + first.y * first.y)) < 0.01f, "coldwalk",
+          "walk through the range took " + std::to_string(time) + " s instead of stopping at the last cold waypoint");
+
+    for (int m = 0; m < maps; ++m) {
+        std::mt19937 rng(seed + m);
+        layOut(30 + static_cast<int>(rng() % 31));
+        std::uniform_int_distribution<int> tile(0, grid.size() - 1);
+        std::vector<TowerRange> towers;
+        hot.reset(grid.size());
+        for (int t = 1 + static_cast<int>(rng() % 3); t > 0; --t) {
+            towers.push_back({positions[tile(rng)], 60.0f + static_cast<float>(rng() % 141)});
+            hot.stamp(grid, positions, towers.back().centre, towers.back().range + margin);
+        }
+        for (int walk = 0; walk < 20; ++walk) {
+            std::vector<int> path;
+            for (int w = 2 + static_cast<int>(rng() % 5); w > 0; --w) {
+                path.push_back(tile(rng));
+            }
+            const float time = hot.coldWalkTime(grid, positions, arena.intern(path), 1, path[0], positions[path[0]], speed, limit);
+            check(time == 0.0f || time * speed < distanceToRange(positions, path, towers), "coldwalk",
+                  "map " + std::to_string(seed + m) + " walk " + std::to_string(walk) + ": the coarse walk enters a tower's range");
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    unsigned seed = 1u;
+    int maps = 50;
+    for (int i = 1; i < argc; ++i) {
+        const std::string option = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (option == "--seed" && hasValue) {
+            seed = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (option == "--maps" && hasValue) {
+            maps = std::atoi(argv[++i]);
+        } else {
+            std::fprintf(stderr, "usage: navtests [--seed S] [--maps N]\n");
+            return 1;
+        }
+    }
+    testPathCache();
+    testPathRequests(seed, maps);
+    testPathScheduler(seed, maps);
+    testHotMaskStamp(seed, maps * 4);
+    testColdWalk(seed, maps);
+    testFlowField(seed, maps * 4);
+    testHierarchical(seed, maps);
+    testJumpPoint(seed, maps * 4);
+    testWallDistance(seed, maps * 2);
+    testSiegePlanner(seed, maps * 4);
+    testReachability(seed, maps * 10);
+    testBreachPlanner(seed, maps * 10);
+
+    std::printf("%s: %d failure(s)\n", failures == 0 ? "PASS" : "FAIL", failures);
+    return failures == 0 ? 0 : 1;
+}
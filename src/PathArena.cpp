@@ -0,0 +1,164 @@
+// PathArena.cpp
+#include "PathArena.hpp"
+#include <algorithm>
+#include <utility>
+
+// Compaction is skipped below this many pool entries; copying a small pool
+// costs more than the gaps do
+static const size_t MIN_COMPACT_TILES = 4096;
+
+SharedPath::SharedPath() : arena(nullptr), id(NO_PATH) {}
+
+SharedPath::SharedPath(PathArena* arena, std::uint32_t id) : arena(arena), id(id) {
+    arena->retain(id);
+}
+
+SharedPath::SharedPath(const SharedPath& other) : arena(other.arena), id(other.id) {
+    if (arena) {
+        arena->retain(id);
+    }
+}
+
+SharedPath::SharedPath(SharedPath&& other) noexcept : arena(other.arena), id(other.id) {
+    other.arena = nullptr;
+    other.id = NO_PATH;
+}
+
+SharedPath& SharedPath::operator=(const SharedPath& other) {
+    if (this != &other) {
+        SharedPath copy(other);
+        *this = std::move(copy);
+    }
+    return *this;
+}
+
+SharedPath& SharedPath::operator=(SharedPath&& other) noexcept {
+    if (this != &other) {
+        clear();
+        arena = other.arena;
+        id = other.id;
+        other.arena = nullptr;
+        other.id = NO_PATH;
+    }
+    return *this;
+}
+
+SharedPath::~SharedPath() {
+    clear();
+}
+
+bool SharedPath::empty() const {
+    return arena == nullptr;
+}
+
+size_t SharedPath::size() const {
+    return arena ? arena->entries[id].length : 0;
+}
+
+int SharedPath::operator[](size_t i) const {
+    return arena->pool[arena->entries[id].offset + i];
+}
+
+int SharedPath::back() const {
+    return (*this)[size() - 1];
+}
+
+void SharedPath::clear() {
+    if (arena) {
+        arena->release(id);
+        arena = nullptr;
+        id = NO_PATH;
+    }
+}
+
+PathArena::PathArena() : liveTiles(0) {}
+
+size_t PathArena::hashPath(const std::vector<int>& path) {
+    size_t hash = path.size();
+    for (int tile : path) {
+        hash ^= static_cast<size_t>(tile) + 0x9E3779B9u + (hash << 6) + (hash >> 2);
+    }
+    return hash;
+}
+
+SharedPath PathArena::intern(const std::vector<int>& path) {
+    if (path.empty()) {
+        return SharedPath();
+    }
+    const size_t hash = hashPath(path);
+    auto range = byHash.equal_range(hash);
+    for (auto it = range.first; it != range.second; ++it) {
+        const Entry& entry = entries[it->second];
+        if (entry.length == path.size() && std::equal(path.begin(), path.end(), pool.begin() + entry.offset)) {
+            return SharedPath(this, it->second);
+        }
+    }
+
+    std::uint32_t id;
+    if (!freeIds.empty()) {
+        id = freeIds.back();
+        freeIds.pop_back();
+    } else {
+        id = static_cast<std::uint32_t>(entries.size());
+        entries.emplace_back();
+    }
+    entries[id] = Entry{static_cast<std::uint32_t>(pool.size()), static_cast<std::uint32_t>(path.size()), 0, hash};
+    pool.insert(pool.end(), path.begin(), path.end());
+    liveTiles += path.size();
+    byHash.emplace(hash, id);
+    return SharedPath(this, id);
+}
+
+void PathArena::retain(std::uint32_t id) {
+    ++entries[id].refs;
+}
+
+void PathArena::release(std::uint32_t id) {
+    Entry& entry = entries[id];
+    if (--entry.refs > 0) {
+        return;
+    }
+    auto range = byHash.equal_range(entry.hash);
+    for (auto it = range.first; it != range.second; ++it) {
+        if (it->second == id) {
+            byHash.erase(it);
+            break;
+        }
+    }
+    liveTiles -= entry.length;
+    freeIds.push_back(id);
+    if (pool.size() >= MIN_COMPACT_TILES && liveTiles * 2 < pool.size()) {
+        compact();
+    }
+}
+
+// Slides live paths down over the gaps; handles refer to entries by id, so
+// none of them change
+void PathArena::compact() {
+    std::vector<std::uint32_t> live;
+    live.reserve(entries.size() - freeIds.size());
+    for (std::uint32_t id = 0; id < entries.size(); ++id) {
+        if (entries[id].refs > 0) {
+            live.push_back(id);
+        }
+    }
+    std::sort(live.begin(), live.end(), [this](std::uint32_t a, std::uint32_t b) {
+        return entries[a].offset < entries[b].offset;
+    });
+    std::uint32_t end = 0;
+    for (std::uint32_t id : live) {
+        Entry& entry = entries[id];
+        std::copy(pool.begin() + entry.offset, pool.begin() + entry.offset + entry.length, pool.begin() + end);
+        entry.offset = end;
+        end += entry.length;
+    }
+    pool.resize(end);
+}
+
+size_t PathArena::getPathCount() const {
+    return entries.size() - freeIds.size();
+}
+
+size_t PathArena::getStoredTiles() const {
+    return pool.size();
+}
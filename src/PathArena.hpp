@@ -0,0 +1,78 @@
+#ifndef PATHARENA_HPP
+#define PATHARENA_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+class PathArena;
+
+// Reference-counted handle to a path of tile indices stored in a PathArena.
+// Copies share the stored path; a default-constructed handle is an empty path.
+// Handles must not outlive their arena and, like the arena, are for the
+// update thread only.
+class SharedPath {
+public:
+    SharedPath();
+    SharedPath(const SharedPath& other);
+    SharedPath(SharedPath&& other) noexcept;
+    SharedPath& operator=(const SharedPath& other);
+    SharedPath& operator=(SharedPath&& other) noexcept;
+    ~SharedPath();
+
+    bool empty() const;
+    size_t size() const;
+    int operator[](size_t i) const; // Tile index of waypoint i
+    int back() const;
+    void clear();
+
+private:
+    friend class PathArena;
+    static const std::uint32_t NO_PATH = 0xFFFFFFFFu;
+
+    SharedPath(PathArena* arena, std::uint32_t id);
+
+    PathArena* arena;
+    std::uint32_t id;
+};
+
+// One contiguous pool of tile indices for every unit path. Identical paths
+// (e.g. units following the flow field from the same spawn) are stored once;
+// released space is reclaimed by compacting the pool once it is mostly gaps.
+class PathArena {
+public:
+    PathArena();
+
+    PathArena(const PathArena&) = delete;
+    PathArena& operator=(const PathArena&) = delete;
+
+    // Stores path, or finds an identical stored one; empty gives an empty handle
+    SharedPath intern(const std::vector<int>& path);
+
+    size_t getPathCount() const;   // Distinct paths held
+    size_t getStoredTiles() const; // Pool size, gaps included
+
+private:
+    friend class SharedPath;
+
+    struct Entry {
+        std::uint32_t offset;
+        std::uint32_t length;
+        std::uint32_t refs; // 0 marks a free slot
+        size_t hash;
+    };
+
+    std::vector<int> pool;
+    std::vector<Entry> entries;
+    std::vector<std::uint32_t> freeIds;
+    std::unordered_multimap<size_t, std::uint32_t> byHash;
+    size_t liveTiles;
+
+    static size_t hashPath(const std::vector<int>& path);
+    void retain(std::uint32_t id);
+    void release(std::uint32_t id);
+    void compact();
+};
+
+#endif // PATHARENA_HPP
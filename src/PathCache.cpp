@@ -0,0 +1,150 @@
+// PathCache.cpp
+#include "PathCache.hpp"
+#include <algorithm>
+#include <iterator>
+
+size_t PathCache::KeyHash::operator()(const Key& key) const {
+    size_t hash = static_cast<size_t>(key.start) * 0x9E3779B1u;
+    hash ^= static_cast<size_t>(key.goal) + 0x7F4A7C15u + (hash << 6) + (hash >> 2);
+    hash ^= static_cast<size_t>(key.stop) + 0x7F4A7C15u + (hash << 6) + (hash >> 2);
+    return hash;
+}
+
+PathCache::PathCache(size_t capacity)
+    : capacity(capacity), syncedVersion(0), hits(0), misses(0), invalidations(0) {}
+
+void PathCache::build(const TileGrid& grid) {
+    entries.clear();
+    byKey.clear();
+    byTile.clear();
+    syncedVersion = grid.getVersion();
+}
+
+void PathCache::applyChanges(const TileGrid& grid, const std::vector<int>& changedTiles) {
+    for (int tile : changedTiles) {
+        if (!grid.isBlocked(tile)) {
+            // A tile opened up (a wall broken, a building removed): any entry
+            // may now have a shorter route, or a route where it had none
+            invalidations += entries.size();
+            build(grid);
+            return;
+        }
+    }
+    for (int tile : changedTiles) {
+        auto dependents = byTile.find(tile);
+        if (dependents == byTile.end()) {
+            continue;
+        }
+        // erase() edits byTile, so work from a copy of the keys
+        std::vector<Key> keys = dependents->second;
+        for (const Key& key : keys) {
+            auto entry = byKey.find(key);
+            if (entry != byKey.end()) {
+                erase(entry->second);
+                ++invalidations;
+            }
+        }
+    }
+    syncedVersion = grid.getVersion();
+}
+
+bool PathCache::lookup(const TileGrid& grid, int start, int goal, int stopBeforeWallTiles, std::vector<int>& path) {
+    if (grid.getVersion() != syncedVersion) {
+        // Changes were made that this cache was never told about
+        build(grid);
+    }
+    auto found = byKey.find(Key{start, goal, stopBeforeWallTiles});
+    if (found == byKey.end()) {
+        ++misses;
+        return false;
+    }
+    entries.splice(entries.begin(), entries, found->second);
+    path = found->second->path;
+    ++hits;
+    return true;
+}
+
+void PathCache::insert(const TileGrid& grid, int start, int goal, int stopBeforeWallTiles,
+                       const std::vector<int>& route, const std::vector<int>& path) {
+    if (capacity == 0) {
+        return;
+    }
+    const Key key{start, goal, stopBeforeWallTiles};
+    auto existing = byKey.find(key);
+    if (existing != byKey.end()) {
+        erase(existing->second);
+    }
+
+    Entry entry{key, path, route, grid.getVersion()};
+    // A diagonal step also depends on the two tiles it passes between
+    for (size_t i = 1; i < route.size(); ++i) {
+        const int fromRow = grid.rowOf(route[i - 1]);
+        const int fromCol = grid.colOf(route[i - 1]);
+        const int toRow = grid.rowOf(route[i]);
+        const int toCol = grid.colOf(route[i]);
+        if (fromRow != toRow && fromCol != toCol) {
+            entry.dependencies.push_back(grid.index(fromRow, toCol));
+            entry.dependencies.push_back(grid.index(toRow, fromCol));
+        }
+    }
+    std::sort(entry.dependencies.begin(), entry.dependencies.end());
+    entry.dependencies.erase(std::unique(entry.dependencies.begin(), entry.dependencies.end()), entry.dependencies.end());
+    for (int tile : entry.dependencies) {
+        byTile[tile].push_back(key);
+    }
+
+    entries.push_front(std::move(entry));
+    byKey[key] = entries.begin();
+    while (entries.size() > capacity) {
+        erase(std::prev(entries.end()));
+    }
+}
+
+void PathCache::erase(std::list<Entry>::iterator entry) {
+    for (int tile : entry->dependencies) {
+        auto dependents = byTile.find(tile);
+        if (dependents == byTile.end()) {
+            continue;
+        }
+        std::vector<Key>& keys = dependents->second;
+        keys.erase(std::remove(keys.begin(), keys.end(), entry->key), keys.end());
+        if (keys.empty()) {
+            byTile.erase(dependents);
+        }
+    }
+    byKey.erase(entry->key);
+    entries.erase(entry);
+}
+
+void PathCache::setCapacity(size_t capacity) {
+    this->capacity = capacity;
+    while (entries.size() > capacity) {
+        erase(std::prev(entries.end()));
+    }
+}
+
+size_t PathCache::getCapacity() const {
+    return capacity;
+}
+
+size_t PathCache::size() const {
+    return entries.size();
+}
+
+std::uint64_t PathCache::getHits() const {
+    return hits;
+}
+
+std::uint64_t PathCache::getMisses() const {
+    return misses;
+}
+
+std::uint64_t PathCache::getInvalidations() const {
+    return invalidations;
+}
+
+void PathCache::resetCounters() {
+    hits = 0;
+    misses = 0;
+    invalidations = 0;
+}
@@ -0,0 +1,78 @@
+#ifndef PATHCACHE_HPP
+#define PATHCACHE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <unordered_map>
+#include <vector>
+#include "TileGrid.hpp"
+
+// Bounded LRU cache of path query results keyed by (start, goal,
+// stopBeforeWallTiles). Spawners send the same queries every wave, so most
+// can be answered without searching. Each entry remembers the tiles its route
+// depends on, so a tile becoming blocked evicts only the entries that depend
+// on that tile. A tile opening up can shorten any route (or connect one that
+// had none), so it drops every entry.
+class PathCache {
+public:
+    explicit PathCache(size_t capacity = 256);
+
+    // Drops every entry and starts tracking the grid's current version
+    void build(const TileGrid& grid);
+    // Evicts entries whose routes cross a newly blocked tile, or everything
+    // if any of the changed tiles is passable
+    void applyChanges(const TileGrid& grid, const std::vector<int>& changedTiles);
+
+    // Copies the cached path into path and returns true on a hit
+    bool lookup(const TileGrid& grid, int start, int goal, int stopBeforeWallTiles, std::vector<int>& path);
+    // Stores path for the query. route is the untrimmed search result (before
+    // the stop rule), so the wall a path stops short of still evicts it.
+    void insert(const TileGrid& grid, int start, int goal, int stopBeforeWallTiles,
+                const std::vector<int>& route, const std::vector<int>& path);
+
+    void setCapacity(size_t capacity);
+    size_t getCapacity() const;
+    size_t size() const;
+
+    std::uint64_t getHits() const;
+    std::uint64_t getMisses() const;
+    // Entries evicted by tile changes (not by the LRU bound)
+    std::uint64_t getInvalidations() const;
+    void resetCounters();
+
+private:
+    struct Key {
+        int start;
+        int goal;
+        int stop;
+
+        bool operator==(const Key& other) const {
+            return start == other.start && goal == other.goal && stop == other.stop;
+        }
+    };
+
+    struct KeyHash {
+        size_t operator()(const Key& key) const;
+    };
+
+    struct Entry {
+        Key key;
+        std::vector<int> path;
+        std::vector<int> dependencies; // Sorted tiles whose change invalidates the path
+        std::uint32_t version;         // Grid version the path was computed at
+    };
+
+    size_t capacity;
+    std::list<Entry> entries; // Most recently used first
+    std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> byKey;
+    std::unordered_map<int, std::vector<Key>> byTile;
+    std::uint32_t syncedVersion;
+    std::uint64_t hits;
+    std::uint64_t misses;
+    std::uint64_t invalidations;
+
+    void erase(std::list<Entry>::iterator entry);
+};
+
+#endif // PATHCACHE_HPP
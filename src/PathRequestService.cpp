@@ -0,0 +1,123 @@
+// PathRequestService.cpp
+#include "PathRequestService.hpp"
+#include "GridAStar.hpp"
+#include "HierarchicalPathfinder.hpp"
+#include "JumpPointSearch.hpp"
+#include <algorithm>
+#include <chrono>
+
+PathTicket::PathTicket() : start(-1), goal(-1), stopBeforeWallTiles(0) {}
+
+bool PathTicket::isPending() const {
+    return result.valid();
+}
+
+bool PathTicket::isReady() const {
+    return result.valid() && result.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+}
+
+PathResult PathTicket::take() {
+    return result.get();
+}
+
+PathRequestService::PathRequestService(unsigned workerCount) : stopping(false), snapshotVersion(0) {
+    if (workerCount == 0) {
+        unsigned hardware = std::thread::hardware_concurrency();
+        workerCount = std::min(4u, std::max(1u, hardware > 1 ? hardware - 1 : 1u));
+    }
+    for (unsigned i = 0; i < workerCount; ++i) {
+        workers.emplace_back(&PathRequestService::workerLoop, this);
+    }
+}
+
+PathRequestService::~PathRequestService() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+PathTicket PathRequestService::submit(const TileGrid& grid, int start, int goal, int stopBeforeWallTiles,
+                                      RouteBackend backend) {
+    if (!snapshot || snapshotVersion != grid.getVersion()) {
+        auto copy = std::make_shared<TileGrid>(grid);
+        copy->clearChanges();
+        snapshot = copy;
+        snapshotVersion = grid.getVersion();
+    }
+
+    PathTicket ticket;
+    ticket.start = start;
+    ticket.goal = goal;
+    ticket.stopBeforeWallTiles = stopBeforeWallTiles;
+    Job job{snapshot, start, goal, stopBeforeWallTiles, backend, std::promise<PathResult>()};
+    ticket.result = job.promise.get_future();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        jobs.push_back(std::move(job));
+    }
+    wake.notify_one();
+    return ticket;
+}
+
+PathTicket PathRequestService::completed(int start, int goal, int stopBeforeWallTiles, PathResult result) {
+    PathTicket ticket;
+    ticket.start = start;
+    ticket.goal = goal;
+    ticket.stopBeforeWallTiles = stopBeforeWallTiles;
+    std::promise<PathResult> promise;
+    ticket.result = promise.get_future();
+    promise.set_value(std::move(result));
+    return ticket;
+}
+
+size_t PathRequestService::getQueuedCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return jobs.size();
+}
+
+unsigned PathRequestService::getWorkerCount() const {
+    return static_cast<unsigned>(workers.size());
+}
+
+void PathRequestService::workerLoop() {
+    // Per-worker scratch, and search data for the snapshot each was built on
+    GridAStar search;
+    HierarchicalPathfinder hierarchical;
+    JumpPointSearch jumpPoint;
+    std::shared_ptr<const TileGrid> hierarchicalGrid;
+    std::shared_ptr<const TileGrid> jumpPointGrid;
+    while (true) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [this] { return stopping || !jobs.empty(); });
+            if (stopping) {
+                return; // Queued promises break; nobody is left to collect them
+            }
+            job = std::move(jobs.front());
+            jobs.pop_front();
+        }
+
+        const TileGrid& grid = *job.grid;
+        if (job.backend == RouteBackend::JumpPoint) {
+            if (jumpPointGrid != job.grid) {
+                jumpPoint.build(grid);
+                jumpPointGrid = job.grid;
+            }
+        } else if (grid.size() >= HIERARCHICAL_MIN_TILES && hierarchicalGrid != job.grid) {
+            hierarchical.build(grid);
+            hierarchicalGrid = job.grid;
+        }
+        PathResult result;
+        result.version = grid.getVersion();
+        searchRoute(job.backend, grid, search, hierarchical, jumpPoint, job.start, job.goal, result.route);
+        result.path = result.route;
+        stopShortOfBlocked(grid, result.path, job.stopBeforeWallTiles);
+        job.promise.set_value(std::move(result));
+    }
+}
@@ -0,0 +1,93 @@
+#ifndef PATHREQUESTSERVICE_HPP
+#define PATHREQUESTSERVICE_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "RouteSearch.hpp"
+#include "TileGrid.hpp"
+
+// Outcome of an asynchronous path request
+struct PathResult {
+    std::vector<int> route;  // Search result before the stop rule
+    std::vector<int> path;   // Route after the stop rule
+    std::uint32_t version;   // Grid version of the snapshot it was computed on
+};
+
+// Handle for a submitted path request. Poll isReady() once per frame; it never
+// blocks. A default-constructed ticket has no request attached.
+class PathTicket {
+public:
+    PathTicket();
+
+    bool isPending() const; // Submitted and not yet taken
+    bool isReady() const;
+    // Only valid once isReady() returns true; leaves the ticket empty
+    PathResult take();
+
+    int getStart() const { return start; }
+    int getGoal() const { return goal; }
+    int getStopBeforeWallTiles() const { return stopBeforeWallTiles; }
+
+private:
+    friend class PathRequestService;
+    friend class PathScheduler;
+
+    std::future<PathResult> result;
+    int start;
+    int goal;
+    int stopBeforeWallTiles;
+};
+
+// Runs path searches on worker threads so the update loop never waits on
+// them. Each request is searched against an immutable copy of the grid taken
+// at submit time; a new copy is made only when the grid's version changes.
+// Workers keep their own HPA* and JPS data, built for the snapshot they last
+// searched when the backend needs them.
+class PathRequestService {
+public:
+    // 0 workers picks one less than the hardware threads (at least one, at most four)
+    explicit PathRequestService(unsigned workerCount = 0);
+    ~PathRequestService();
+
+    PathRequestService(const PathRequestService&) = delete;
+    PathRequestService& operator=(const PathRequestService&) = delete;
+
+    // Queues a search from start to goal (same rules as Pathfinding::findPath)
+    PathTicket submit(const TileGrid& grid, int start, int goal, int stopBeforeWallTiles,
+                      RouteBackend backend = RouteBackend::AStar);
+    // Ticket that is ready immediately, e.g. for a cache hit
+    static PathTicket completed(int start, int goal, int stopBeforeWallTiles, PathResult result);
+
+    size_t getQueuedCount() const;
+    unsigned getWorkerCount() const;
+
+private:
+    struct Job {
+        std::shared_ptr<const TileGrid> grid;
+        int start;
+        int goal;
+        int stopBeforeWallTiles;
+        RouteBackend backend;
+        std::promise<PathResult> promise;
+    };
+
+    std::vector<std::thread> workers;
+    mutable std::mutex mutex;
+    std::condition_variable wake;
+    std::deque<Job> jobs;
+    bool stopping;
+
+    std::shared_ptr<const TileGrid> snapshot; // Touched by the submitting thread only
+    std::uint32_t snapshotVersion;
+
+    void workerLoop();
+};
+
+#endif // PATHREQUESTSERVICE_HPP
@@ -0,0 +1,117 @@
+// PathScheduler.cpp
+#include "PathScheduler.hpp"
+#include "GridConnectivity.hpp"
+#include <algorithm>
+#include <cstdlib>
+
+constexpr float PathScheduler::WAIT_WEIGHT;
+
+PathScheduler::PathScheduler()
+    : frameBudget(1000), expansionCost(250), frame(0), nextSequence(0), searching(false),
+      current(), searchVersion(0), lastFrameExpansions(0) {}
+
+void PathScheduler::setFrameBudget(int microseconds) {
+    frameBudget = std::max(0, microseconds);
+}
+
+int PathScheduler::getFrameBudget() const {
+    return frameBudget;
+}
+
+void PathScheduler::setExpansionCost(int nanoseconds) {
+    expansionCost = std::max(1, nanoseconds);
+}
+
+int PathScheduler::getExpansionCost() const {
+    return expansionCost;
+}
+
+size_t PathScheduler::getExpansionBudget() const {
+    // Always allow some progress, or a tiny budget would starve the queue
+    return std::max<size_t>(1, static_cast<size_t>(frameBudget) * 1000 / static_cast<size_t>(expansionCost));
+}
+
+// A request's urgency is its distance minus WAIT_WEIGHT for every frame it
+// has waited. Every queued request gains the same bonus each frame, so their
+// order never changes; adding WAIT_WEIGHT * submittedFrame instead gives a
+// key fixed at submission that sorts the same way, and the queue can be a heap.
+PathTicket PathScheduler::submit(const TileGrid& grid, int start, int goal, int stopBeforeWallTiles) {
+    PathTicket ticket;
+    ticket.start = start;
+    ticket.goal = goal;
+    ticket.stopBeforeWallTiles = stopBeforeWallTiles;
+    const double key = urgency(grid, start, goal) + static_cast<double>(WAIT_WEIGHT) * static_cast<double>(frame);
+    Request request{key, nextSequence++, start, goal, stopBeforeWallTiles, std::promise<PathResult>()};
+    ticket.result = request.promise.get_future();
+    queue.push_back(std::move(request));
+    std::push_heap(queue.begin(), queue.end(), LessUrgent());
+    return ticket;
+}
+
+size_t PathScheduler::getQueuedCount() const {
+    return queue.size() + (searching ? 1 : 0);
+}
+
+size_t PathScheduler::getLastFrameExpansions() const {
+    return lastFrameExpansions;
+}
+
+// Octile distance from start to goal. Lower is more urgent: units close to
+// the goal first, then whoever has waited longest catches up
+float PathScheduler::urgency(const TileGrid& grid, int start, int goal) const {
+    const int dRow = std::abs(grid.rowOf(start) - grid.rowOf(goal));
+    const int dCol = std::abs(grid.colOf(start) - grid.colOf(goal));
+    return static_cast<float>(dRow + dCol) + (DIAGONAL_STEP_COST - 2.0f) * static_cast<float>(std::min(dRow, dCol));
+}
+
+// Ties go to the earlier request, so the order never depends on the heap's
+// internals
+void PathScheduler::startNext(const TileGrid& grid) {
+    std::pop_heap(queue.begin(), queue.end(), LessUrgent());
+    current = std::move(queue.back());
+    queue.pop_back();
+    search.beginSearch(grid, current.start, current.goal);
+    searchVersion = grid.getVersion();
+    searching = true;
+}
+
+void PathScheduler::finishCurrent(const TileGrid& grid, GridAStar::Status status) {
+    PathResult result;
+    result.version = grid.getVersion();
+    search.getSearchPath(result.route);
+    if (status == GridAStar::Status::Unreachable) {
+        // The goal is walled off: aim for the wall in front of the closest tile we can reach
+        int wall = blockedNeighborTowards(grid, result.route.back(), current.goal);
+        if (wall >= 0) {
+            result.route.push_back(wall);
+        }
+    }
+    result.path = result.route;
+    stopShortOfBlocked(grid, result.path, current.stopBeforeWallTiles);
+    current.promise.set_value(std::move(result));
+    searching = false;
+}
+
+void PathScheduler::runFrame(const TileGrid& grid) {
+    ++frame;
+    lastFrameExpansions = 0;
+    if (searching && searchVersion != grid.getVersion()) {
+        // The grid changed under a paused search; its partial state is stale
+        search.beginSearch(grid, current.start, current.goal);
+        searchVersion = grid.getVersion();
+    }
+
+    const size_t budget = getExpansionBudget();
+    while (lastFrameExpansions < budget && (searching || !queue.empty())) {
+        if (!searching) {
+            startNext(grid);
+        }
+        const size_t before = search.getLastExpansions();
+        GridAStar::Status status = search.resumeSearch(grid, budget - lastFrameExpansions);
+        // A finished search counts at least one expansion so the loop always advances
+        lastFrameExpansions += std::max<size_t>(1, search.getLastExpansions() - before);
+        if (status != GridAStar::Status::Searching) {
+            finishCurrent(grid, status);
+        }
+    }
+}
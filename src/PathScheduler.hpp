@@ -0,0 +1,75 @@
+#ifndef PATHSCHEDULER_HPP
+#define PATHSCHEDULER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <vector>
+#include "GridAStar.hpp"
+#include "PathRequestService.hpp"
+#include "TileGrid.hpp"
+
+// Single-threaded alternative to PathRequestService: queued path requests are
+// searched a slice at a time from the update loop, most urgent first, so a
+// mass replan spreads over several frames instead of stalling one. The frame
+// budget is given in microseconds but spent as a fixed number of A* node
+// expansions (budget / expansion cost), so the same inputs always produce the
+// same results on the same frames, which keeps replays reproducible.
+class PathScheduler {
+public:
+    // Urgency bonus per frame waited, in tiles of distance to the goal
+    static constexpr float WAIT_WEIGHT = 0.5f;
+
+    PathScheduler();
+
+    void setFrameBudget(int microseconds);
+    int getFrameBudget() const;
+    // Assumed cost of one node expansion; see PathfindingBench for measurements
+    void setExpansionCost(int nanoseconds);
+    int getExpansionCost() const;
+    size_t getExpansionBudget() const;
+
+    // Queues an A* search (same movement and stop rules as
+    // Pathfinding::findPath, but never HPA* or JPS, whose searches cannot be
+    // paused mid-way); the ticket becomes ready during a later runFrame
+    PathTicket submit(const TileGrid& grid, int start, int goal, int stopBeforeWallTiles);
+    // Spends this frame's budget on the queue, continuing any search left
+    // unfinished by the previous frame
+    void runFrame(const TileGrid& grid);
+
+    size_t getQueuedCount() const; // Including the search in progress
+    size_t getLastFrameExpansions() const;
+
+private:
+    struct Request {
+        double key; // Urgency with the wait bonus folded in; see submit
+        std::uint64_t sequence;
+        int start;
+        int goal;
+        int stopBeforeWallTiles;
+        std::promise<PathResult> promise;
+    };
+    // Heap order: the most urgent request (lowest key, then earliest) on top
+    struct LessUrgent {
+        bool operator()(const Request& a, const Request& b) const {
+            return a.key != b.key ? a.key > b.key : a.sequence > b.sequence;
+        }
+    };
+
+    int frameBudget;
+    int expansionCost;
+    std::uint64_t frame;
+    std::uint64_t nextSequence;
+    std::vector<Request> queue; // Binary heap ordered by LessUrgent
+    bool searching;
+    Request current;
+    std::uint32_t searchVersion; // Grid version the current search started on
+    GridAStar search;
+    size_t lastFrameExpansions;
+
+    float urgency(const TileGrid& grid, int start, int goal) const;
+    void startNext(const TileGrid& grid);
+    void finishCurrent(const TileGrid& grid, GridAStar::Status status);
+};
+
+#endif // PATHSCHEDULER_HPP
@@ -0,0 +1,84 @@
+// PathSmoothing.cpp
+#include "PathSmoothing.hpp"
+#include <cstdlib>
+
+SegmentWalker::SegmentWalker()
+    : row(0), col(0), stepRow(0), stepCol(0), rowSteps(0), colSteps(0), rowTaken(0), colTaken(0), cols(1) {}
+
+void SegmentWalker::reset(const TileGrid& grid, int from, int to) {
+    row = grid.rowOf(from);
+    col = grid.colOf(from);
+    const int dRow = grid.rowOf(to) - row;
+    const int dCol = grid.colOf(to) - col;
+    stepRow = dRow > 0 ? 1 : (dRow < 0 ? -1 : 0);
+    stepCol = dCol > 0 ? 1 : (dCol < 0 ? -1 : 0);
+    rowSteps = std::abs(dRow);
+    colSteps = std::abs(dCol);
+    rowTaken = 0;
+    colTaken = 0;
+    cols = grid.getCols();
+}
+
+// The segment leaves its current tile across a column boundary at
+// t = (colTaken + 0.5) / colSteps and across a row boundary at
+// t = (rowTaken + 0.5) / rowSteps. Cross-multiplying keeps the comparison
+// exact, so corner crossings are recognised.
+int SegmentWalker::advance(float progress) {
+    if (rowTaken == rowSteps && colTaken == colSteps) {
+        return -1;
+    }
+    const long colSide = static_cast<long>(2 * colTaken + 1) * rowSteps;
+    const long rowSide = static_cast<long>(2 * rowTaken + 1) * colSteps;
+    const bool crossColumn = colTaken < colSteps && (rowTaken == rowSteps || colSide <= rowSide);
+    const bool crossRow = rowTaken < rowSteps && (colTaken == colSteps || rowSide <= colSide);
+    const float entry = crossColumn
+        ? static_cast<float>(2 * colTaken + 1) / static_cast<float>(2 * colSteps)
+        : static_cast<float>(2 * rowTaken + 1) / static_cast<float>(2 * rowSteps);
+    if (entry > progress) {
+        return -1;
+    }
+    if (crossColumn) {
+        col += stepCol;
+        ++colTaken;
+    }
+    if (crossRow) {
+        row += stepRow;
+        ++rowTaken;
+    }
+    return row * cols + col;
+}
+
+bool hasLineOfSight(const TileGrid& grid, int from, int to) {
+    SegmentWalker walker;
+    walker.reset(grid, from, to);
+    int previous = from;
+    for (int tile = walker.advance(1.0f); tile >= 0; tile = walker.advance(1.0f)) {
+        if (grid.isBlocked(tile)) {
+            return false;
+        }
+        const int previousRow = grid.rowOf(previous);
+        const int previousCol = grid.colOf(previous);
+        const int row = grid.rowOf(tile);
+        const int col = grid.colOf(tile);
+        if (row != previousRow && col != previousCol &&
+            (grid.isBlocked(grid.index(previousRow, col)) || grid.isBlocked(grid.index(row, previousCol)))) {
+            return false;
+        }
+        previous = tile;
+    }
+    return true;
+}
+
+void smoothPath(const TileGrid& grid, std::vector<int>& path) {
+    if (path.size() < 3) {
+        return;
+    }
+    size_t kept = 0; // path[0..kept] is the smoothed prefix
+    for (size_t i = 2; i < path.size(); ++i) {
+        if (!hasLineOfSight(grid, path[kept], path[i])) {
+            path[++kept] = path[i - 1];
+        }
+    }
+    path[++kept] = path.back();
+    path.resize(kept + 1);
+}
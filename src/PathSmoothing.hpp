@@ -0,0 +1,45 @@
+#ifndef PATHSMOOTHING_HPP
+#define PATHSMOOTHING_HPP
+
+#include <vector>
+#include "TileGrid.hpp"
+
+// Walks the tiles a straight segment between two tile centres passes
+// through, in order. Where the segment runs exactly through a tile corner it
+// moves diagonally without entering the two tiles that only share the corner.
+// Tiles are reported as the segment enters them, so a unit moving along the
+// segment can react to every tile it crosses (e.g. traps) without storing them.
+class SegmentWalker {
+public:
+    SegmentWalker();
+
+    void reset(const TileGrid& grid, int from, int to);
+    // Next tile entered at or before progress (0 at from, 1 at to), or -1 if
+    // there is none yet. Call repeatedly until it returns -1.
+    int advance(float progress);
+
+private:
+    int row;
+    int col;
+    int stepRow;
+    int stepCol;
+    int rowSteps; // |dRow|
+    int colSteps; // |dCol|
+    int rowTaken;
+    int colTaken;
+    int cols;
+};
+
+// True if a unit can walk the straight segment between the centres of from
+// and to: every tile it crosses is open, and at a corner crossing so are both
+// tiles beside the corner (no corner cutting, as with single diagonal steps).
+// from itself is not checked.
+bool hasLineOfSight(const TileGrid& grid, int from, int to);
+
+// String pulling: drops waypoints that the previous kept waypoint can see
+// past, so straight and open stretches become single segments. The first and
+// last tiles are kept, and so is a blocked last tile's approach (line of sight
+// never reaches a blocked tile).
+void smoothPath(const TileGrid& grid, std::vector<int>& path);
+
+#endif // PATHSMOOTHING_HPP
@@ -2,88 +2,105 @@
 #include "Pathfinding.hpp"
 #include "Tile.hpp"
 #include "Map.hpp"
+#include "GridAStar.hpp"
+#include "PathCache.hpp"
 #include <vector>
 #include <memory>
 #include <cmath>
 #include <iostream>
 
-Pathfinding::Pathfinding(const Map& map) : map(map) {}
-
-std::vector<std::shared_ptr<Tile>> Pathfinding::findPath(
-    std::shared_ptr<Tile> start, 
-    std::shared_ptr<Tile> end, 
-    int stopBeforeWallTiles
-) {
-    std::vector<std::shared_ptr<Tile>> path;
-    std::shared_ptr<Tile> current = start;
-
-    while (current != end) {
-        // Get the next tile in the straight path towards the end
-        auto nextTile = getNextTileInStraightPath(current, end);
-        if (!nextTile) {
-            break; // No valid next tile
-        }
-
-        // Check if the next tile is blocked
-        if (nextTile->isBlocked()) {
-            // Calculate the stopping tile based on the given parameter
-            auto stopTile = getTileStepsBeforeWall(current, nextTile, stopBeforeWallTiles);
-            if (stopTile) {
-                path.push_back(stopTile);
-            }
-
-            // **Ensure that when stopBeforeWallTiles is 0, the wall tile itself is included**
-            if (stopBeforeWallTiles <= 0) {
-                path.push_back(nextTile); // Include the wall tile
-            }
+// Search scratch shared by every Pathfinding instance on a thread, so units
+// don't each carry grid-sized arrays
+static GridAStar& sharedSearch() {
+    static thread_local GridAStar search;
+    return search;
+}
 
-            return path; // Stop pathfinding upon reaching this condition
-        }
+Pathfinding::Pathfinding(const Map& map, Backend backend) : map(map), backend(backend) {}
 
-        path.push_back(current);
-        current = nextTile;
-    }
+void Pathfinding::setBackend(Backend backend) {
+    this->backend = backend;
+}
 
-    path.push_back(end);
-    return path;
+Pathfinding::Backend Pathfinding::getBackend() const {
+    return backend;
 }
 
-std::shared_ptr<Tile> Pathfinding::getTileStepsBeforeWall(
-    std::shared_ptr<Tile> current, 
-    std::shared_ptr<Tile> wallTile, 
+std::vector<Tile> Pathfinding::findPath(
+    Tile start, 
+    Tile end, 
     int stopBeforeWallTiles
 ) {
-    if (stopBeforeWallTiles <= 0) {
-        // When stopBeforeWallTiles is 0, return the wallTile itself
-        return wallTile;
+    std::vector<Tile> path;
+    if (!start || !end) {
+        return path;
     }
 
-    int dx = wallTile->getRow() - current->getRow();
-    int dy = wallTile->getCol() - current->getCol();
-    int stepX = (dx != 0) ? (dx / std::abs(dx)) : 0;
-    int stepY = (dy != 0) ? (dy / std::abs(dy)) : 0;
+    const TileGrid& grid = map.getGrid();
+    PathCache& cache = map.getPathCache();
+    static thread_local std::vector<int> indices;
+    if (!cache.lookup(grid, start.getIndex(), end.getIndex(), stopBeforeWallTiles, indices)) {
+        static thread_local std::vector<int> route;
+        searchRoute(backend, grid, sharedSearch(), map.getHierarchicalPathfinder(), map.getJumpPointSearch(),
+                    start.getIndex(), end.getIndex(), route);
+        indices = route;
+        stopShortOfBlocked(grid, indices, stopBeforeWallTiles);
+        cache.insert(grid, start.getIndex(), end.getIndex(), stopBeforeWallTiles, route, indices);
+    }
 
-    return current->getNeighbor(-stopBeforeWallTiles * stepX, -stopBeforeWallTiles * stepY);
+    path.reserve(indices.size());
+    for (int index : indices) {
+        path.push_back(map.getTile(grid.rowOf(index), grid.colOf(index)));
+    }
+    return path;
 }
 
-std::shared_ptr<Tile> Pathfinding::getNextTileInStraightPath(std::shared_ptr<Tile> current, std::shared_ptr<Tile> end) {
-    int dx = end->getRow() - current->getRow();
-    int dy = end->getCol() - current->getCol();
-    int stepX = (dx != 0) ? (dx / std::abs(dx)) : 0;
-    int stepY = (dy != 0) ? (dy / std::abs(dy)) : 0;
-    return current->getNeighbor(stepX, stepY);
+PathTicket Pathfinding::requestPath(Tile start, Tile end, int stopBeforeWallTiles) {
+    if (!start || !end) {
+        return PathTicket();
+    }
+    const TileGrid& grid = map.getGrid();
+    PathResult cached;
+    if (map.getPathCache().lookup(grid, start.getIndex(), end.getIndex(), stopBeforeWallTiles, cached.path)) {
+        cached.version = grid.getVersion();
+        return PathRequestService::completed(start.getIndex(), end.getIndex(), stopBeforeWallTiles, std::move(cached));
+    }
+    if (map.getPathRequestMode() == PathRequestMode::TimeSliced) {
+        return map.getPathScheduler().submit(grid, start.getIndex(), end.getIndex(), stopBeforeWallTiles);
+    }
+    return map.getPathRequestService().submit(grid, start.getIndex(), end.getIndex(), stopBeforeWallTiles, backend);
 }
 
-std::shared_ptr<Tile> Pathfinding::getTileTwoStepsBehind(std::shared_ptr<Tile> current, std::shared_ptr<Tile> wallTile) {
-    int dx = wallTile->getRow() - current->getRow();
-    int dy = wallTile->getCol() - current->getCol();
-    int stepX = (dx != 0) ? (dx / std::abs(dx)) : 0;
-    int stepY = (dy != 0) ? (dy / std::abs(dy)) : 0;
-    return current->getNeighbor(-2 * stepX, -2 * stepY);
+bool Pathfinding::collectPath(PathTicket& ticket, SharedPath& path) {
+    if (!ticket.isReady()) {
+        return false;
+    }
+    const int start = ticket.getStart();
+    const int end = ticket.getGoal();
+    const int stopBeforeWallTiles = ticket.getStopBeforeWallTiles();
+    PathResult result = ticket.take();
+
+    const TileGrid& grid = map.getGrid();
+    if (result.version != grid.getVersion()) {
+        // Computed on an older snapshot: still usable unless a tile it walks
+        // through has been blocked since (the last tile may be the target wall)
+        for (size_t i = 1; i + 1 < result.path.size(); ++i) {
+            if (grid.isBlocked(result.path[i])) {
+                ticket = requestPath(map.getTile(grid.rowOf(start), grid.colOf(start)),
+                                     map.getTile(grid.rowOf(end), grid.colOf(end)), stopBeforeWallTiles);
+                return false;
+            }
+        }
+    } else if (!result.route.empty()) {
+        map.getPathCache().insert(grid, start, end, stopBeforeWallTiles, result.route, result.path);
+    }
+
+    path = map.makeUnitPath(result.path);
+    return true;
 }
 
-void Pathfinding::attackWall(std::shared_ptr<Tile> wallTile) {
+void Pathfinding::attackWall(Tile wallTile) {
     // Implement wall attacking logic
-    wallTile->takeDamage(10.0f); // Example: Deal 10 damage
+    wallTile.takeDamage(10.0f); // Example: Deal 10 damage
     // Optionally remove the wall if damage exceeds threshold
-}
\ No newline at end of file
+}
@@ -3,25 +3,47 @@
 
 #include <memory>
 #include <vector>
+#include "PathArena.hpp"
+#include "PathRequestService.hpp"
+#include "RouteSearch.hpp"
 
 class Tile;
 class Map;
+class TileGrid;
 
 class Pathfinding {
 public:
-    Pathfinding(const Map& map);
+    // Search used for findPath and requestPath (see RouteSearch.hpp)
+    using Backend = RouteBackend;
 
-    std::vector<std::shared_ptr<Tile>> findPath(std::shared_ptr<Tile> start, std::shared_ptr<Tile> end, int stopBeforeWallTiles);
+    Pathfinding(const Map& map, Backend backend = Backend::AStar);
+
+    void setBackend(Backend backend);
+    Backend getBackend() const;
+
+    // Path from start to end using the selected backend; end may be a blocked
+    // tile such as the town hall. If end is sealed off, the path instead leads
+    // to the blocked tile next to the reachable tile closest to end. When the
+    // path ends on a blocked tile it stops stopBeforeWallTiles tiles short of
+    // it (0 keeps the blocked tile itself).
+    // Results are served from the map's PathCache when possible.
+    std::vector<Tile> findPath(Tile start, Tile end, int stopBeforeWallTiles);
+
+    // Non-blocking findPath for the update loop: the search runs on the map's
+    // PathRequestService or PathScheduler, per its PathRequestMode (cache hits
+    // are ready at once). The worker threads use the selected backend; the
+    // scheduler's time-sliced search is always A*. Returns an empty ticket if
+    // start or end is invalid.
+    PathTicket requestPath(Tile start, Tile end, int stopBeforeWallTiles);
+    // Once the ticket's result has arrived, writes it to path, clears the
+    // ticket and returns true. A result that crosses tiles blocked since its
+    // snapshot was taken is requested again instead.
+    bool collectPath(PathTicket& ticket, SharedPath& path);
 
-    // std::vector<std::shared_ptr<Tile>> findPath(std::shared_ptr<Tile> start, std::shared_ptr<Tile> end);
-    std::shared_ptr<Tile> getTileStepsBeforeWall(std::shared_ptr<Tile> current, std::shared_ptr<Tile> wallTile, int stopBeforeWallTiles);
-    std::shared_ptr<Tile> getNextTileInStraightPath(std::shared_ptr<Tile> current, std::shared_ptr<Tile> end);
-    std::shared_ptr<Tile> getTileTwoStepsBehind(std::shared_ptr<Tile> current, std::shared_ptr<Tile> wallTile);
-    
 private:
     const Map& map;
-
-    void attackWall(std::shared_ptr<Tile> wallTile);
+    Backend backend;
+    void attackWall(Tile wallTile);
 };
 
-#endif // PATHFINDING_HPP
\ No newline at end of file
+#endif // PATHFINDING_HPP
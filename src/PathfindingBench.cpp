@@ -0,0 +1,485 @@
+// PathfindingBench.cpp
+// Headless pathfinding benchmark. Generates maps of a given size, wall
+// density, maze structure and chokepoint count, then runs queries from the
+// open boundary tiles (where SkeletonSpawn/TankSpawn place units) to a town
+// hall in the middle with plain A*, the hierarchical (HPA*) search, jump point
+// search and the tanks' D* Lite breach planner. Reports queries/sec, expanded
+// nodes, p50/p99 latency and peak heap use as JSON (or a table with --table),
+// so results can be kept and compared across releases.
+// Build with `make bench`; `make bench-report` writes pathbench.json.
+//
+// With no map options the default suite runs: open, random, maze and
+// chokepoint maps at 30x30, 256x256 and 1024x1024. Options:
+//   --map NAME         label for a custom map (default "custom")
+//   --size N           map width and height in tiles
+//   --density D        fraction of tiles walled at random (0..1)
+//   --maze             carve a maze of one-tile corridors first
+//   --chokepoints K    wall ring around the town hall with K gaps
+//   --queries N        queries per search (default scales with map size)
+//   --seed S           map and start order seed (default 1234)
+//   --search LIST      comma separated: astar,hpa,jps,dstar (default all)
+//   --table            human readable output instead of JSON
+#include "DStarLite.hpp"
+#include "GridAStar.hpp"
+#include "HierarchicalPathfinder.hpp"
+#include "JumpPointSearch.hpp"
+#include "TileGrid.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+#include <sys/resource.h>
+#ifdef __APPLE__
+#include <malloc/malloc.h>
+#else
+#include <malloc.h>
+#endif
+
+// Heap accounting: the live total of allocated blocks and its peak, sized by
+// the allocator itself. The benchmark is single threaded.
+static size_t heapLive = 0;
+static size_t heapPeak = 0;
+
+static size_t blockSize(void* block) {
+#ifdef __APPLE__
+    return malloc_size(block);
+#else
+    return malloc_usable_size(block);
+#endif
+}
+
+void* operator new(size_t size) {
+    void* block = std::malloc(size);
+    if (!block) {
+        throw std::bad_alloc();
+    }
+    heapLive += blockSize(block);
+    heapPeak = std::max(heapPeak, heapLive);
+    return block;
+}
+
+// Kept out of line: inlined into callers, GCC flags the free() of a pointer
+// that came from operator new
+__attribute__((noinline)) void operator delete(void* block) noexcept {
+    if (block) {
+        heapLive -= blockSize(block);
+        std::free(block);
+    }
+}
+
+void operator delete(void* block, size_t) noexcept {
+    operator delete(block);
+}
+
+struct MapSpec {
+    std::string name;
+    int size;
+    double wallDensity;
+    bool maze;
+    int chokepoints;
+};
+
+struct SearchResult {
+    const char* search;
+    int queries;
+    int reached;
+    double seconds;
+    double averageExpanded;
+    double p50;  // Latency percentiles, microseconds
+    double p99;
+    double worst;
+    size_t peakHeap; // Bytes held by the search's structures at their peak
+};
+
+static void placeWall(TileGrid& grid, int index) {
+    grid.setType(index, TileType::Wall);
+    grid.setBlocked(index, true);
+    grid.setHealth(index, 100);
+}
+
+static void clearTile(TileGrid& grid, int row, int col) {
+    int index = grid.index(row, col);
+    grid.setType(index, TileType::Grass);
+    grid.setBlocked(index, false);
+    grid.setHealth(index, 0);
+}
+
+// One-tile corridors carved by a depth-first walk over the odd coordinates
+static void carveMaze(TileGrid& grid, std::mt19937& rng) {
+    const int size = grid.getRows();
+    for (int index = 0; index < grid.size(); ++index) {
+        placeWall(grid, index);
+    }
+    const int dRow[4] = {-2, 2, 0, 0};
+    const int dCol[4] = {0, 0, -2, 2};
+    std::vector<int> stack = {grid.index(1, 1)};
+    clearTile(grid, 1, 1);
+    while (!stack.empty()) {
+        int row = grid.rowOf(stack.back());
+        int col = grid.colOf(stack.back());
+        int options[4];
+        int count = 0;
+        for (int direction = 0; direction < 4; ++direction) {
+            int newRow = row + dRow[direction];
+            int newCol = col + dCol[direction];
+            if (newRow > 0 && newRow < size - 1 && newCol > 0 && newCol < size - 1 &&
+                grid.isBlocked(grid.index(newRow, newCol))) {
+                options[count++] = direction;
+            }
+        }
+        if (count == 0) {
+            stack.pop_back();
+            continue;
+        }
+        int direction = options[rng() % count];
+        clearTile(grid, row + dRow[direction] / 2, col + dCol[direction] / 2);
+        clearTile(grid, row + dRow[direction], col + dCol[direction]);
+        stack.push_back(grid.index(row + dRow[direction], col + dCol[direction]));
+    }
+}
+
+// Square wall ring halfway between the edge and the centre, with `gaps`
+// two-tile openings spread evenly around it; every route to the town hall
+// has to squeeze through one of them
+static void placeChokepoints(TileGrid& grid, int gaps) {
+    const int size = grid.getRows();
+    const int centre = size / 2;
+    const int radius = size / 4;
+    if (radius < 3) {
+        return;
+    }
+    const int low = centre - radius;
+    const int high = centre + radius;
+    // Ring tiles in clockwise order, so gaps can be spaced along it
+    std::vector<int> ring;
+    for (int col = low; col < high; ++col) {
+        ring.push_back(grid.index(low, col));
+    }
+    for (int row = low; row < high; ++row) {
+        ring.push_back(grid.index(row, high));
+    }
+    for (int col = high; col > low; --col) {
+        ring.push_back(grid.index(high, col));
+    }
+    for (int row = high; row > low; --row) {
+        ring.push_back(grid.index(row, low));
+    }
+    for (int index : ring) {
+        placeWall(grid, index);
+    }
+    for (int gap = 0; gap < gaps; ++gap) {
+        const size_t at = ring.size() * gap / gaps + radius / 2;
+        for (size_t offset = 0; offset < 2; ++offset) {
+            const int index = ring[(at + offset) % ring.size()];
+            // Clear the tiles on both sides of the opening as well, so random
+            // walls cannot plug it
+            const int row = grid.rowOf(index);
+            const int col = grid.colOf(index);
+            for (int dRow = -1; dRow <= 1; ++dRow) {
+                for (int dCol = -1; dCol <= 1; ++dCol) {
+                    const bool onRing = row + dRow == low || row + dRow == high || col + dCol == low || col + dCol == high;
+                    if (!onRing || (dRow == 0 && dCol == 0)) {
+                        clearTile(grid, row + dRow, col + dCol);
+                    }
+                }
+            }
+        }
+    }
+}
+
+// 2x2 blocked town hall in the centre with an open ring around it
+static void placeTownHall(TileGrid& grid) {
+    int centre = grid.getRows() / 2;
+    for (int row = centre - 2; row <= centre + 1; ++row) {
+        for (int col = centre - 2; col <= centre + 1; ++col) {
+            clearTile(grid, row, col);
+        }
+    }
+    for (int row = centre - 1; row <= centre; ++row) {
+        for (int col = centre - 1; col <= centre; ++col) {
+            grid.setBlocked(grid.index(row, col), true);
+        }
+    }
+}
+
+static std::vector<int> townHallTiles(const TileGrid& grid) {
+    int centre = grid.getRows() / 2;
+    return {grid.index(centre - 1, centre - 1), grid.index(centre - 1, centre),
+            grid.index(centre, centre - 1), grid.index(centre, centre)};
+}
+
+static TileGrid makeMap(const MapSpec& spec, unsigned seed) {
+    TileGrid grid(spec.size, spec.size);
+    std::mt19937 rng(seed);
+    if (spec.maze) {
+        carveMaze(grid, rng);
+    }
+    std::bernoulli_distribution isWall(spec.wallDensity);
+    for (int index = 0; index < grid.size(); ++index) {
+        if (!grid.isBlocked(index) && isWall(rng)) {
+            placeWall(grid, index);
+        }
+    }
+    if (spec.chokepoints > 0) {
+        placeChokepoints(grid, spec.chokepoints);
+    }
+    if (spec.maze) {
+        // Open ring along the map edge for the spawns
+        for (int i = 0; i < spec.size; ++i) {
+            clearTile(grid, i, 0);
+            clearTile(grid, i, spec.size - 1);
+            clearTile(grid, 0, i);
+            clearTile(grid, spec.size - 1, i);
+        }
+    }
+    placeTownHall(grid);
+    grid.clearChanges();
+    grid.clearHealthChanges();
+    return grid;
+}
+
+// Open boundary tiles, like the SkeletonSpawn/TankSpawn presets, in a
+// seeded random order so every side of the map is sampled
+static std::vector<int> boundaryTiles(const TileGrid& grid, unsigned seed) {
+    std::vector<int> tiles;
+    int size = grid.getRows();
+    for (int i = 0; i < size; ++i) {
+        int candidates[4] = {grid.index(i, 0), grid.index(i, size - 1), grid.index(0, i), grid.index(size - 1, i)};
+        for (int index : candidates) {
+            if (!grid.isBlocked(index)) {
+                tiles.push_back(index);
+            }
+        }
+    }
+    std::sort(tiles.begin(), tiles.end());
+    tiles.erase(std::unique(tiles.begin(), tiles.end()), tiles.end());
+    std::shuffle(tiles.begin(), tiles.end(), std::mt19937(seed));
+    return tiles;
+}
+
+static int defaultQueries(int size) {
+    if (size <= 64) {
+        return 20000;
+    }
+    return size <= 512 ? 400 : 40;
+}
+
+static double percentile(std::vector<double>& sorted, double fraction) {
+    size_t at = static_cast<size_t>(fraction * (sorted.size() - 1) + 0.5);
+    return sorted[std::min(at, sorted.size() - 1)];
+}
+
+// Builds the search, warms its scratch up and times `queries` queries one by
+// one. Heap use is measured from before the search is constructed.
+template <typename Search, typename Build, typename Query>
+static SearchResult runSearch(const char* name, const std::vector<int>& starts, int queries,
+                              Build build, Query query) {
+    SearchResult result{name, queries, 0, 0.0, 0.0, 0.0, 0.0, 0.0, 0};
+    std::vector<double> latencies(queries);
+    std::vector<int> path;
+    const size_t heapBefore = heapLive;
+    heapPeak = heapLive;
+    {
+        Search search;
+        build(search);
+        size_t expanded = 0;
+        query(search, starts[0], path, expanded);
+        expanded = 0;
+        for (int i = 0; i < queries; ++i) {
+            auto begin = std::chrono::steady_clock::now();
+            bool found = query(search, starts[i % starts.size()], path, expanded);
+            auto end = std::chrono::steady_clock::now();
+            latencies[i] = std::chrono::duration<double, std::micro>(end - begin).count();
+            result.seconds += latencies[i] * 1e-6;
+            if (found) {
+                ++result.reached;
+            }
+        }
+        result.averageExpanded = static_cast<double>(expanded) / queries;
+    }
+    result.peakHeap = heapPeak - heapBefore;
+    std::sort(latencies.begin(), latencies.end());
+    result.p50 = percentile(latencies, 0.50);
+    result.p99 = percentile(latencies, 0.99);
+    result.worst = latencies.back();
+    return result;
+}
+
+static bool wants(const std::vector<std::string>& searches, const char* name) {
+    return std::find(searches.begin(), searches.end(), name) != searches.end();
+}
+
+static std::vector<SearchResult> runMap(const MapSpec& spec, int queries, unsigned seed,
+                                        const std::vector<std::string>& searches) {
+    const TileGrid grid = makeMap(spec, seed);
+    const std::vector<int> starts = boundaryTiles(grid, seed);
+    const std::vector<int> goals = townHallTiles(grid);
+    const int goal = goals.back();
+    std::vector<SearchResult> results;
+    if (starts.empty()) {
+        std::fprintf(stderr, "Map %s (%d) has no open boundary tiles.\n", spec.name.c_str(), spec.size);
+        return results;
+    }
+
+    if (wants(searches, "astar")) {
+        results.push_back(runSearch<GridAStar>("astar", starts, queries,
+            [&](GridAStar&) {},
+            [&](GridAStar& search, int start, std::vector<int>& path, size_t& expanded) {
+                bool found = search.findPath(grid, start, goal, path);
+                expanded += search.getLastExpansions();
+                return found;
+            }));
+    }
+    if (wants(searches, "hpa")) {
+        results.push_back(runSearch<HierarchicalPathfinder>("hpa", starts, queries,
+            [&](HierarchicalPathfinder& search) { search.build(grid); },
+            [&](HierarchicalPathfinder& search, int start, std::vector<int>& path, size_t& expanded) {
+                bool found = search.findPath(grid, start, goal, path);
+                expanded += search.getLastExpansions();
+                return found;
+            }));
+    }
+    if (wants(searches, "jps")) {
+        results.push_back(runSearch<JumpPointSearch>("jps", starts, queries,
+            [&](JumpPointSearch& search) { search.build(grid); },
+            [&](JumpPointSearch& search, int start, std::vector<int>& path, size_t& expanded) {
+                bool found = search.findPath(grid, start, goal, path);
+                expanded += search.getLastExpansions();
+                return found;
+            }));
+    }
+    if (wants(searches, "dstar")) {
+        // Tanks: one planner shared by every query, walls priced by health
+        results.push_back(runSearch<DStarLite>("dstar", starts, queries,
+            [&](DStarLite& search) { search.build(grid, goals); },
+            [&](DStarLite& search, int start, std::vector<int>& path, size_t& expanded) {
+                bool found = search.findPath(grid, start, path);
+                expanded += search.getLastExpansions();
+                return found;
+            }));
+    }
+    return results;
+}
+
+static long maxResidentKilobytes() {
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+    return usage.ru_maxrss / 1024; // Bytes on macOS
+#else
+    return usage.ru_maxrss;
+#endif
+}
+
+static void printUsage() {
+    std::fprintf(stderr,
+                 "usage: pathbench [--map NAME] [--size N] [--density D] [--maze] [--chokepoints K]\n"
+                 "                 [--queries N] [--seed S] [--search astar,hpa,jps,dstar] [--table]\n");
+}
+
+int main(int argc, char** argv) {
+    MapSpec custom{"custom", 256, 0.0, false, 0};
+    bool customMap = false;
+    bool table = false;
+    int queries = 0;
+    unsigned seed = 1234u;
+    std::vector<std::string> searches = {"astar", "hpa", "jps", "dstar"};
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string option = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (option == "--table") {
+            table = true;
+        } else if (option == "--maze") {
+            custom.maze = true;
+            customMap = true;
+        } else if (option == "--map" && hasValue) {
+            custom.name = argv[++i];
+            customMap = true;
+        } else if (option == "--size" && hasValue) {
+            custom.size = std::atoi(argv[++i]);
+            customMap = true;
+        } else if (option == "--density" && hasValue) {
+            custom.wallDensity = std::atof(argv[++i]);
+            customMap = true;
+        } else if (option == "--chokepoints" && hasValue) {
+            custom.chokepoints = std::atoi(argv[++i]);
+            customMap = true;
+        } else if (option == "--queries" && hasValue) {
+            queries = std::atoi(argv[++i]);
+        } else if (option == "--seed" && hasValue) {
+            seed = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (option == "--search" && hasValue) {
+            searches.clear();
+            std::string list = argv[++i];
+            for (size_t begin = 0; begin <= list.size();) {
+                size_t end = list.find(',', begin);
+                if (end == std::string::npos) {
+                    end = list.size();
+                }
+                searches.push_back(list.substr(begin, end - begin));
+                begin = end + 1;
+            }
+        } else {
+            printUsage();
+            return 1;
+        }
+    }
+    if (custom.size < 8 || custom.wallDensity < 0.0 || custom.wallDensity >= 1.0 || custom.chokepoints < 0 || queries < 0) {
+        std::fprintf(stderr, "Size must be at least 8, density in [0, 1), counts non-negative.\n");
+        return 1;
+    }
+
+    std::vector<MapSpec> specs;
+    if (customMap) {
+        specs.push_back(custom);
+    } else {
+        for (int size : {30, 256, 1024}) {
+            specs.push_back(MapSpec{"open", size, 0.05, false, 0});
+            specs.push_back(MapSpec{"random", size, 0.2, false, 0});
+            specs.push_back(MapSpec{"maze", size, 0.0, true, 0});
+            specs.push_back(MapSpec{"chokepoint", size, 0.1, false, 4});
+        }
+    }
+
+    if (table) {
+        std::printf("%-10s %-10s %-6s %8s %11s %10s %10s %12s %11s %8s\n", "map", "size", "search", "queries",
+                    "queries/s", "p50 us", "p99 us", "avg expanded", "peak KiB", "reached");
+    } else {
+        std::printf("{\n  \"benchmark\": \"pathfinding\",\n  \"format\": 1,\n  \"seed\": %u,\n  \"results\": [", seed);
+    }
+    bool first = true;
+    for (const MapSpec& spec : specs) {
+        const int count = queries > 0 ? queries : defaultQueries(spec.size);
+        for (const SearchResult& result : runMap(spec, count, seed, searches)) {
+            const double perSecond = result.queries / result.seconds;
+            const double reached = 100.0 * result.reached / result.queries;
+            if (table) {
+                char label[32];
+                std::snprintf(label, sizeof(label), "%dx%d", spec.size, spec.size);
+                std::printf("%-10s %-10s %-6s %8d %11.0f %10.1f %10.1f %12.0f %11.0f %7.0f%%\n", spec.name.c_str(), label,
+                            result.search, result.queries, perSecond, result.p50, result.p99, result.averageExpanded,
+                            result.peakHeap / 1024.0, reached);
+                continue;
+            }
+            std::printf("%s\n    {\"map\": \"%s\", \"size\": %d, \"wall_density\": %.3f, \"maze\": %s, \"chokepoints\": %d,"
+                        " \"search\": \"%s\", \"queries\": %d, \"queries_per_sec\": %.1f, \"reached_pct\": %.1f,"
+                        " \"avg_expanded\": %.1f, \"latency_us\": {\"p50\": %.2f, \"p99\": %.2f, \"max\": %.2f},"
+                        " \"peak_heap_bytes\": %zu}",
+                        first ? "" : ",", spec.name.c_str(), spec.size, spec.wallDensity, spec.maze ? "true" : "false",
+                        spec.chokepoints, result.search, result.queries, perSecond, reached, result.averageExpanded,
+                        result.p50, result.p99, result.worst, result.peakHeap);
+            first = false;
+        }
+        std::fflush(stdout);
+    }
+    if (!table) {
+        std::printf("\n  ],\n  \"max_rss_kb\": %ld\n}\n", maxResidentKilobytes());
+    }
+    return 0;
+}
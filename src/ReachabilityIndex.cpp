@@ -0,0 +1,452 @@
+// ReachabilityIndex.cpp
+#include "ReachabilityIndex.hpp"
+#include "GridConnectivity.hpp"
+#include <algorithm>
+
+// The ring around a tile in clockwise order from straight up; even entries are
+// the straight neighbors. Consecutive entries are a straight step apart, so a
+// run of open ring tiles is always walkable end to end.
+static const int RING_ROW[8] = {-1, -1, 0, 1, 1, 1, 0, -1};
+static const int RING_COL[8] = {0, 1, 1, 1, 0, -1, -1, -1};
+
+// Half of the eight directions; visiting these from every tile covers each
+// pair of neighbors once
+static const int FORWARD_ROW[4] = {0, 1, 1, 1};
+static const int FORWARD_COL[4] = {1, 0, 1, -1};
+
+ReachabilityIndex::ReachabilityIndex() : stale(true), verifiedTile(-1), visitGeneration(0), lastVisited(0) {}
+
+void ReachabilityIndex::build(const TileGrid& grid, const std::vector<int>& goalTiles, const std::vector<int>& spawnTiles) {
+    goals = goalTiles;
+    spawns = spawnTiles;
+    relabel(grid);
+}
+
+void ReachabilityIndex::relabel(const TileGrid& grid) {
+    const int count = grid.size();
+    isGoal.assign(count, 0);
+    for (int goal : goals) {
+        if (goal >= 0 && goal < count) {
+            isGoal[goal] = 1;
+        }
+    }
+    isSpawn.assign(count, 0);
+    for (int spawn : spawns) {
+        if (spawn >= 0 && spawn < count) {
+            isSpawn[spawn] = 1;
+        }
+    }
+
+    parent.resize(count);
+    regionSize.assign(count, 1);
+    spawnCount.assign(count, 0);
+    entryCount.assign(count, 0);
+    open.assign(count, 0);
+    isEntry.assign(count, 0);
+    detached.assign(count, 0);
+    for (int tile = 0; tile < count; ++tile) {
+        parent[tile] = tile;
+        open[tile] = isPassable(grid, tile);
+    }
+    for (int tile = 0; tile < count; ++tile) {
+        if (open[tile]) {
+            isEntry[tile] = entersGoal(grid, tile, -1);
+            spawnCount[tile] = isSpawn[tile];
+            entryCount[tile] = isEntry[tile];
+        }
+    }
+    for (int tile = 0; tile < count; ++tile) {
+        if (!open[tile]) {
+            continue;
+        }
+        for (int direction = 0; direction < 4; ++direction) {
+            if (canStep(grid, tile, FORWARD_ROW[direction], FORWARD_COL[direction], -1)) {
+                unite(tile, grid.index(grid.rowOf(tile) + FORWARD_ROW[direction], grid.colOf(tile) + FORWARD_COL[direction]));
+            }
+        }
+    }
+
+    visitStamp.assign(count, 0);
+    visitFront.assign(count, 0);
+    visitGeneration = 0;
+    stale = false;
+    verifiedTile = -1;
+}
+
+int ReachabilityIndex::find(int tile) {
+    while (parent[tile] != tile) {
+        parent[tile] = parent[parent[tile]];
+        tile = parent[tile];
+    }
+    return tile;
+}
+
+void ReachabilityIndex::unite(int a, int b) {
+    a = find(a);
+    b = find(b);
+    if (a == b) {
+        return;
+    }
+    if (regionSize[a] < regionSize[b]) {
+        std::swap(a, b);
+    }
+    parent[b] = a;
+    regionSize[a] += regionSize[b];
+    spawnCount[a] += spawnCount[b];
+    entryCount[a] += entryCount[b];
+}
+
+// Openings are merged first, so a tile blocked in the same batch is judged
+// against the final grid with every new link in place
+void ReachabilityIndex::applyChanges(const TileGrid& grid, const std::vector<int>& changedTiles) {
+    if (stale || open.size() != static_cast<size_t>(grid.size())) {
+        stale = true;
+        return;
+    }
+    const int verified = verifiedTile;
+    verifiedTile = -1;
+    int blockedTile = -1;
+    int newlyBlocked = 0;
+    for (int tile : changedTiles) {
+        if (open[tile] && !isPassable(grid, tile)) {
+            blockedTile = tile;
+            ++newlyBlocked;
+        }
+    }
+    for (int tile : changedTiles) {
+        if (!open[tile] && isPassable(grid, tile)) {
+            openTile(grid, tile);
+            if (stale) {
+                return;
+            }
+        } else if (open[tile] && isPassable(grid, tile)) {
+            // A wall built or cleared keeps the tile passable but changes the
+            // corners it lends to diagonal moves. Its straight neighbors stay
+            // linked through it, so regions are unchanged; only entries move.
+            refreshEntries(grid, tile);
+        }
+    }
+    if (newlyBlocked == 0) {
+        return;
+    }
+    // New openings only add links, so a verified tile stays safe to remove
+    if (newlyBlocked > 1 || touchesGoal(grid, blockedTile) ||
+        (blockedTile != verified && openArcs(grid, blockedTile, nullptr) > 1)) {
+        stale = true;
+        return;
+    }
+    // Its open neighbors stay linked around it, so no region splits; the tile
+    // stays in the tree, detached from its region's counts
+    const int root = find(blockedTile);
+    spawnCount[root] -= isSpawn[blockedTile];
+    entryCount[root] -= isEntry[blockedTile];
+    isEntry[blockedTile] = 0;
+    open[blockedTile] = 0;
+    detached[blockedTile] = 1;
+}
+
+void ReachabilityIndex::openTile(const TileGrid& grid, int tile) {
+    const int row = grid.rowOf(tile);
+    const int col = grid.colOf(tile);
+    if (detached[tile]) {
+        // It still hangs off the region it was blocked in, which is only right
+        // if it borders that region again
+        const int root = find(tile);
+        bool linked = false;
+        for (int direction = 0; direction < MapConnectivity::count && !linked; ++direction) {
+            const int dRow = MapConnectivity::dRow[direction];
+            const int dCol = MapConnectivity::dCol[direction];
+            if (canStep(grid, tile, dRow, dCol, -1)) {
+                const int neighbor = grid.index(row + dRow, col + dCol);
+                linked = open[neighbor] && find(neighbor) == root;
+            }
+        }
+        if (!linked) {
+            stale = true;
+            return;
+        }
+        detached[tile] = 0;
+    }
+    open[tile] = 1;
+    spawnCount[find(tile)] += isSpawn[tile];
+    refreshEntries(grid, tile);
+    for (int direction = 0; direction < MapConnectivity::count; ++direction) {
+        const int dRow = MapConnectivity::dRow[direction];
+        const int dCol = MapConnectivity::dCol[direction];
+        if (canStep(grid, tile, dRow, dCol, -1)) {
+            const int neighbor = grid.index(row + dRow, col + dCol);
+            if (open[neighbor]) {
+                unite(tile, neighbor);
+            }
+        }
+    }
+}
+
+// The tile may be an entry, and may let its neighbors enter a goal diagonally
+// past it or stop them from doing so
+void ReachabilityIndex::refreshEntries(const TileGrid& grid, int tile) {
+    const int row = grid.rowOf(tile);
+    const int col = grid.colOf(tile);
+    for (int dRow = -1; dRow <= 1; ++dRow) {
+        for (int dCol = -1; dCol <= 1; ++dCol) {
+            if (!grid.inBounds(row + dRow, col + dCol)) {
+                continue;
+            }
+            const int nearby = grid.index(row + dRow, col + dCol);
+            if (!open[nearby]) {
+                continue;
+            }
+            const unsigned char entry = entersGoal(grid, nearby, -1) ? 1 : 0;
+            if (entry != isEntry[nearby]) {
+                isEntry[nearby] = entry;
+                entryCount[find(nearby)] += entry ? 1 : -1;
+            }
+        }
+    }
+}
+
+// Walls can be breached, so only other blocked tiles cut a region
+bool ReachabilityIndex::isPassable(const TileGrid& grid, int tile) {
+    return !grid.isBlocked(tile) || grid.getType(tile) == TileType::Wall;
+}
+
+bool ReachabilityIndex::isOpen(const TileGrid& grid, int tile, int closed) const {
+    return tile != closed && isPassable(grid, tile);
+}
+
+// Same corner rule as FlowField::stepCost: a wall can be breached, but not
+// squeezed past
+bool ReachabilityIndex::isClear(const TileGrid& grid, int tile, int closed) const {
+    return tile != closed && !grid.isBlocked(tile);
+}
+
+bool ReachabilityIndex::canStep(const TileGrid& grid, int from, int dRow, int dCol, int closed) const {
+    const int row = grid.rowOf(from);
+    const int col = grid.colOf(from);
+    if (!grid.inBounds(row + dRow, col + dCol) || !isOpen(grid, grid.index(row + dRow, col + dCol), closed)) {
+        return false;
+    }
+    return dRow == 0 || dCol == 0 ||
+           (isClear(grid, grid.index(row + dRow, col), closed) && isClear(grid, grid.index(row, col + dCol), closed));
+}
+
+bool ReachabilityIndex::entersGoal(const TileGrid& grid, int tile, int closed) const {
+    if (isGoal[tile]) {
+        return true;
+    }
+    const int row = grid.rowOf(tile);
+    const int col = grid.colOf(tile);
+    for (int direction = 0; direction < MapConnectivity::count; ++direction) {
+        const int dRow = MapConnectivity::dRow[direction];
+        const int dCol = MapConnectivity::dCol[direction];
+        if (!grid.inBounds(row + dRow, col + dCol) || !isGoal[grid.index(row + dRow, col + dCol)]) {
+            continue;
+        }
+        // A goal may be blocked, so only the corners are checked
+        if (dRow == 0 || dCol == 0 ||
+            (isClear(grid, grid.index(row + dRow, col), closed) && isClear(grid, grid.index(row, col + dCol), closed))) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ReachabilityIndex::touchesGoal(const TileGrid& grid, int tile) const {
+    const int row = grid.rowOf(tile);
+    const int col = grid.colOf(tile);
+    for (int direction = 0; direction < MapConnectivity::count; ++direction) {
+        const int newRow = row + MapConnectivity::dRow[direction];
+        const int newCol = col + MapConnectivity::dCol[direction];
+        if (grid.inBounds(newRow, newCol) && isGoal[grid.index(newRow, newCol)]) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// A diagonal ring tile can only be walked to from the centre when both
+// straight tiles beside it are clear, and then it shares their arc, so arcs
+// without a straight tile do not touch the centre at all
+int ReachabilityIndex::openArcs(const TileGrid& grid, int tile, int* seeds) const {
+    const int row = grid.rowOf(tile);
+    const int col = grid.colOf(tile);
+    bool ringOpen[8];
+    int firstClosed = -1;
+    for (int i = 0; i < 8; ++i) {
+        const int newRow = row + RING_ROW[i];
+        const int newCol = col + RING_COL[i];
+        ringOpen[i] = grid.inBounds(newRow, newCol) && isPassable(grid, grid.index(newRow, newCol));
+        if (!ringOpen[i] && firstClosed < 0) {
+            firstClosed = i;
+        }
+    }
+    if (firstClosed < 0) {
+        if (seeds) {
+            seeds[0] = grid.index(row + RING_ROW[0], col + RING_COL[0]);
+        }
+        return 1;
+    }
+    int arcs = 0;
+    int seed = -1;
+    for (int step = 1; step <= 8; ++step) {
+        const int i = (firstClosed + step) % 8;
+        if (ringOpen[i]) {
+            if (i % 2 == 0 && seed < 0) {
+                seed = grid.index(row + RING_ROW[i], col + RING_COL[i]);
+            }
+        } else if (seed >= 0) {
+            if (seeds) {
+                seeds[arcs] = seed;
+            }
+            ++arcs;
+            seed = -1;
+        }
+    }
+    return arcs;
+}
+
+bool ReachabilityIndex::reachesGoal(const TileGrid& grid, int tile) {
+    if (stale || open.size() != static_cast<size_t>(grid.size())) {
+        relabel(grid);
+    }
+    return tile >= 0 && tile < grid.size() && open[tile] && entryCount[find(tile)] > 0;
+}
+
+// Blocking the tile can only split its region between the arcs around it.
+// One flood fill per arc runs in lockstep; fills that meet are merged, and a
+// fill that runs dry has enumerated a piece cut off from the rest, which is
+// fatal if it holds spawn tiles but no goal entry. Whatever is left over is
+// judged from the region's counts minus the pieces split off.
+bool ReachabilityIndex::wouldSeal(const TileGrid& grid, int tile) {
+    lastVisited = 0;
+    verifiedTile = -1;
+    if (stale || open.size() != static_cast<size_t>(grid.size())) {
+        relabel(grid);
+    }
+    if (tile < 0 || tile >= grid.size() || !open[tile]) {
+        return false;
+    }
+    const int root = find(tile);
+    if (entryCount[root] == 0) {
+        return false; // Nothing here reaches a goal to begin with
+    }
+    int seeds[MAX_ARCS];
+    const int arcs = openArcs(grid, tile, seeds);
+    const bool nearGoal = touchesGoal(grid, tile);
+    if (arcs <= 1 && !nearGoal) {
+        return false;
+    }
+
+    int spawnsLeft = spawnCount[root] - isSpawn[tile];
+    int entriesLeft = entryCount[root] - isEntry[tile];
+    if (nearGoal) {
+        // Neighbors that entered a goal diagonally past the tile lose the way in
+        const int row = grid.rowOf(tile);
+        const int col = grid.colOf(tile);
+        for (int direction = 0; direction < MapConnectivity::count; ++direction) {
+            const int newRow = row + MapConnectivity::dRow[direction];
+            const int newCol = col + MapConnectivity::dCol[direction];
+            if (grid.inBounds(newRow, newCol)) {
+                const int neighbor = grid.index(newRow, newCol);
+                if (open[neighbor] && isEntry[neighbor] && !entersGoal(grid, neighbor, tile)) {
+                    --entriesLeft;
+                }
+            }
+        }
+    }
+
+    if (++visitGeneration == 0) {
+        std::fill(visitStamp.begin(), visitStamp.end(), 0);
+        visitGeneration = 1;
+    }
+    int link[MAX_ARCS];
+    int regionSpawns[MAX_ARCS];
+    int regionEntries[MAX_ARCS];
+    size_t head[MAX_ARCS];
+    bool done[MAX_ARCS];
+    for (int front = 0; front < arcs; ++front) {
+        const int seed = seeds[front];
+        link[front] = front;
+        regionSpawns[front] = isSpawn[seed];
+        regionEntries[front] = entersGoal(grid, seed, tile);
+        head[front] = 0;
+        done[front] = false;
+        fronts[front].clear();
+        fronts[front].push_back(seed);
+        visitStamp[seed] = visitGeneration;
+        visitFront[seed] = static_cast<unsigned char>(front);
+    }
+    auto regionOf = [&](int front) {
+        while (link[front] != front) {
+            front = link[front];
+        }
+        return front;
+    };
+
+    int active = arcs;
+    bool split = false;
+    while (active > 1) {
+        for (int front = 0; front < arcs; ++front) {
+            if (head[front] == fronts[front].size()) {
+                continue;
+            }
+            const int current = fronts[front][head[front]++];
+            const int row = grid.rowOf(current);
+            const int col = grid.colOf(current);
+            ++lastVisited;
+            for (int direction = 0; direction < MapConnectivity::count; ++direction) {
+                const int dRow = MapConnectivity::dRow[direction];
+                const int dCol = MapConnectivity::dCol[direction];
+                if (!canStep(grid, current, dRow, dCol, tile)) {
+                    continue;
+                }
+                const int neighbor = grid.index(row + dRow, col + dCol);
+                const int region = regionOf(front);
+                if (visitStamp[neighbor] != visitGeneration) {
+                    visitStamp[neighbor] = visitGeneration;
+                    visitFront[neighbor] = static_cast<unsigned char>(front);
+                    fronts[front].push_back(neighbor);
+                    regionSpawns[region] += isSpawn[neighbor];
+                    regionEntries[region] += entersGoal(grid, neighbor, tile);
+                } else {
+                    const int other = regionOf(visitFront[neighbor]);
+                    if (other != region) {
+                        link[other] = region;
+                        regionSpawns[region] += regionSpawns[other];
+                        regionEntries[region] += regionEntries[other];
+                        --active;
+                    }
+                }
+            }
+        }
+        // A region whose fills have all run dry is cut off from the others
+        for (int region = 0; region < arcs; ++region) {
+            if (done[region] || regionOf(region) != region) {
+                continue;
+            }
+            bool dry = true;
+            for (int front = 0; front < arcs && dry; ++front) {
+                dry = regionOf(front) != region || head[front] == fronts[front].size();
+            }
+            if (!dry) {
+                continue;
+            }
+            done[region] = true;
+            split = true;
+            --active;
+            if (regionEntries[region] == 0 && regionSpawns[region] > 0) {
+                return true;
+            }
+            spawnsLeft -= regionSpawns[region];
+            entriesLeft -= regionEntries[region];
+        }
+    }
+    if (!split && !nearGoal) {
+        verifiedTile = tile;
+    }
+    return entriesLeft == 0 && spawnsLeft > 0;
+}
+
+size_t ReachabilityIndex::getLastVisited() const {
+    return lastVisited;
+}
@@ -0,0 +1,88 @@
+#ifndef REACHABILITYINDEX_HPP
+#define REACHABILITYINDEX_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "TileGrid.hpp"
+
+// Connected regions of tiles units can get through (eight-way moves without
+// corner cutting, as units walk; walls count as open, since units breach them,
+// but like any blocked tile they still stop a diagonal move past their corner)
+// kept in a union-find forest, with per region counts of spawn tiles and of
+// tiles a goal can be entered from. Answers "can this tile get to a goal?" in
+// near constant time, and "would blocking this tile with something that cannot
+// be breached cut a spawn tile off from every goal?" without searching the
+// whole map.
+//
+// Opening a tile only merges regions, so it is applied at once. Blocking one
+// can split a region, which union-find cannot undo; when the tile's open
+// neighbors stay linked around it (one arc of open tiles in its ring), or
+// wouldSeal just found them linked further out, nothing splits and the forest
+// is kept. Otherwise it is relabelled on the next query.
+class ReachabilityIndex {
+public:
+    ReachabilityIndex();
+
+    void build(const TileGrid& grid, const std::vector<int>& goalTiles, const std::vector<int>& spawnTiles);
+    // Block status and wall changes since the last call (others are ignored)
+    void applyChanges(const TileGrid& grid, const std::vector<int>& changedTiles);
+
+    // True if tile is open and can get to a tile from which a goal is entered
+    bool reachesGoal(const TileGrid& grid, int tile);
+    // True if blocking the open tile would leave an open spawn tile that
+    // reaches a goal now with no way to any goal. Searches outward from the
+    // tile's neighbors only when they are not linked around it, and stops as
+    // soon as the pieces meet again.
+    bool wouldSeal(const TileGrid& grid, int tile);
+
+    // Tiles visited by the last wouldSeal (0 when the local test settled it)
+    size_t getLastVisited() const;
+
+private:
+    static const int MAX_ARCS = 4; // Open arcs around a tile that touch it
+
+    std::vector<int> goals;
+    std::vector<int> spawns;
+    std::vector<unsigned char> isGoal;
+    std::vector<unsigned char> isSpawn;
+
+    // Union-find over tile indices; blocked tiles are singletons, except tiles
+    // blocked without a relabel, which stay in the tree as detached nodes
+    std::vector<int> parent;
+    std::vector<int> regionSize;
+    std::vector<int> spawnCount; // Per root: open spawn tiles in the region
+    std::vector<int> entryCount; // Per root: tiles in the region a goal can be entered from
+    std::vector<unsigned char> open;     // Passability the forest reflects
+    std::vector<unsigned char> isEntry;
+    std::vector<unsigned char> detached;
+    bool stale;
+    int verifiedTile; // Last wouldSeal tile whose arcs were found linked without it
+
+    // Scratch for wouldSeal
+    std::vector<std::uint32_t> visitStamp;
+    std::vector<unsigned char> visitFront;
+    std::uint32_t visitGeneration;
+    std::vector<int> fronts[MAX_ARCS];
+    size_t lastVisited;
+
+    void relabel(const TileGrid& grid);
+    int find(int tile);
+    void unite(int a, int b);
+    void openTile(const TileGrid& grid, int tile);
+    void refreshEntries(const TileGrid& grid, int tile);
+
+    static bool isPassable(const TileGrid& grid, int tile);
+    // Step rules with `closed` also treated as blocked (-1 for none)
+    bool isOpen(const TileGrid& grid, int tile, int closed) const;
+    // Whether a diagonal move may pass the tile's corner
+    bool isClear(const TileGrid& grid, int tile, int closed) const;
+    bool canStep(const TileGrid& grid, int from, int dRow, int dCol, int closed) const;
+    bool entersGoal(const TileGrid& grid, int tile, int closed) const;
+    bool touchesGoal(const TileGrid& grid, int tile) const;
+    // Open arcs in the ring around tile that contain a straight neighbor, with
+    // one such neighbor of each written to seeds (may be null)
+    int openArcs(const TileGrid& grid, int tile, int* seeds) const;
+};
+
+#endif // REACHABILITYINDEX_HPP
@@ -0,0 +1,24 @@
+// RouteSearch.cpp
+#include "RouteSearch.hpp"
+
+void searchRoute(RouteBackend backend, const TileGrid& grid, GridAStar& astar, HierarchicalPathfinder& hierarchical,
+                 JumpPointSearch& jumpPoint, int start, int end, std::vector<int>& route) {
+    bool reached = false;
+    if (backend == RouteBackend::JumpPoint) {
+        reached = jumpPoint.findPath(grid, start, end, route);
+    } else if (grid.size() >= HIERARCHICAL_MIN_TILES) {
+        reached = hierarchical.findPath(grid, start, end, route);
+    }
+    if (!reached) {
+        // Small map, or no route found above
+        reached = astar.findPath(grid, start, end, route);
+    }
+
+    if (!reached) {
+        // The goal is walled off: aim for the wall in front of the closest tile we can reach
+        int wall = blockedNeighborTowards(grid, route.back(), end);
+        if (wall >= 0) {
+            route.push_back(wall);
+        }
+    }
+}
@@ -0,0 +1,29 @@
+#ifndef ROUTESEARCH_HPP
+#define ROUTESEARCH_HPP
+
+#include <vector>
+#include "GridAStar.hpp"
+#include "HierarchicalPathfinder.hpp"
+#include "JumpPointSearch.hpp"
+#include "TileGrid.hpp"
+
+// Search used for a route. AStar switches to HPA* on large maps; JumpPoint
+// suits open, uniform-cost maps.
+enum class RouteBackend {
+    AStar,
+    JumpPoint
+};
+
+// Maps with at least this many tiles route through the cluster abstraction;
+// on smaller ones plain A* is faster than connecting to the abstract graph
+constexpr int HIERARCHICAL_MIN_TILES = 128 * 128;
+
+// The search behind every route request, wherever it runs: picks the backend,
+// falls back to A* (which also finds the closest reachable tile when the goal
+// is sealed off) and then aims at the wall in front of that tile. hierarchical
+// and jumpPoint must be built for grid; each is only used when selected.
+// Writes the route before the stop rule.
+void searchRoute(RouteBackend backend, const TileGrid& grid, GridAStar& astar, HierarchicalPathfinder& hierarchical,
+                 JumpPointSearch& jumpPoint, int start, int end, std::vector<int>& route);
+
+#endif // ROUTESEARCH_HPP
@@ -0,0 +1,276 @@
+// SiegePlanner.cpp
+#include "SiegePlanner.hpp"
+#include "GridConnectivity.hpp"
+#include <algorithm>
+
+// Capacity of open tiles and links between tiles; far above any sum of wall health
+static const std::int64_t UNLIMITED = std::int64_t(1) << 40;
+
+SiegePlanner::SiegePlanner() : stale(true), cutHealth(0), planCount(0), source(0), sink(0) {}
+
+void SiegePlanner::build(const TileGrid& grid, const std::vector<int>& spawnTiles, const std::vector<int>& goalTiles) {
+    spawns = spawnTiles;
+    goals = goalTiles;
+    plan(grid);
+}
+
+void SiegePlanner::applyChanges(const TileGrid& grid, const std::vector<int>& changedTiles) {
+    if (stale || layout.size() != static_cast<size_t>(grid.size())) {
+        stale = true;
+        return;
+    }
+    for (int tile : changedTiles) {
+        if (layoutOf(grid, tile) != layout[tile]) {
+            stale = true;
+            return;
+        }
+    }
+}
+
+void SiegePlanner::update(const TileGrid& grid) {
+    if (stale || layout.size() != static_cast<size_t>(grid.size())) {
+        plan(grid);
+    }
+}
+
+bool SiegePlanner::isSealed() const {
+    return !cutWalls.empty();
+}
+
+const std::vector<int>& SiegePlanner::getCutWalls() const {
+    return cutWalls;
+}
+
+std::int64_t SiegePlanner::getCutHealth() const {
+    return cutHealth;
+}
+
+int SiegePlanner::getTarget(int tile) const {
+    return tile >= 0 && tile < static_cast<int>(target.size()) ? target[tile] : -1;
+}
+
+const FlowField& SiegePlanner::getApproachField() const {
+    return approach;
+}
+
+int SiegePlanner::getPlanCount() const {
+    return planCount;
+}
+
+SiegePlanner::Layout SiegePlanner::layoutOf(const TileGrid& grid, int tile) {
+    if (!grid.isBlocked(tile)) {
+        return Open;
+    }
+    return grid.getType(tile) == TileType::Wall ? Wall : Impassable;
+}
+
+void SiegePlanner::plan(const TileGrid& grid) {
+    const int count = grid.size();
+    isGoal.assign(count, 0);
+    for (int goal : goals) {
+        if (goal >= 0 && goal < count) {
+            isGoal[goal] = 1;
+        }
+    }
+    layout.resize(count);
+    for (int tile = 0; tile < count; ++tile) {
+        layout[tile] = layoutOf(grid, tile);
+    }
+    cutWalls.clear();
+    cutHealth = 0;
+    target.assign(count, -1);
+    stale = false;
+    ++planCount;
+
+    buildNetwork(grid);
+    // An open route needs no breach, and if even breaching walls leads nowhere
+    // there is no cut to make
+    if (levelGraph(UNLIMITED) || !levelGraph(1)) {
+        approach.build(grid, cutWalls);
+        return;
+    }
+
+    // Dinic's algorithm: blocking flows along BFS levels
+    std::int64_t flow = 0;
+    while (levelGraph(1)) {
+        currentEdge = firstEdge;
+        for (std::int64_t pushed = augment(); pushed > 0; pushed = augment()) {
+            flow += pushed;
+        }
+    }
+    cutHealth = flow;
+
+    // Whatever the source still reaches is its side of the cut; walls entered
+    // from that side but not left are the cut
+    levelGraph(1);
+    for (int tile = 0; tile < count; ++tile) {
+        if (layout[tile] == Wall && !isGoal[tile] && level[node[tile]] >= 0 && level[node[tile] + 1] < 0) {
+            cutWalls.push_back(tile);
+        }
+    }
+    assignTargets(grid);
+}
+
+void SiegePlanner::addEdge(int from, int to, std::int64_t capacity) {
+    edges.push_back(Edge{to, firstEdge[from], capacity});
+    firstEdge[from] = static_cast<int>(edges.size()) - 1;
+    edges.push_back(Edge{from, firstEdge[to], 0});
+    firstEdge[to] = static_cast<int>(edges.size()) - 1;
+}
+
+// Links are four-way: a diagonal step without corner cutting can always be
+// made as two straight ones, so the cuts are the same as for eight-way moves.
+// Open tiles are uncapped, so each four-way connected area of them is a single
+// node; only walls are split, which keeps augmenting paths short.
+void SiegePlanner::buildNetwork(const TileGrid& grid) {
+    const int count = grid.size();
+    node.assign(count, -1);
+    int nodes = 0;
+    for (int tile = 0; tile < count; ++tile) {
+        if (layout[tile] != Open || isGoal[tile] || node[tile] >= 0) {
+            continue;
+        }
+        queue.clear();
+        queue.push_back(tile);
+        node[tile] = nodes;
+        for (size_t head = 0; head < queue.size(); ++head) {
+            const int current = queue[head];
+            forEachNeighbor<FourWayConnectivity>(grid, current, [&](int neighbor, int) {
+                if (layout[neighbor] == Open && !isGoal[neighbor] && node[neighbor] < 0) {
+                    node[neighbor] = nodes;
+                    queue.push_back(neighbor);
+                }
+            });
+        }
+        ++nodes;
+    }
+    for (int tile = 0; tile < count; ++tile) {
+        if (layout[tile] == Wall && !isGoal[tile]) {
+            node[tile] = nodes;
+            nodes += 2;
+        }
+    }
+    source = nodes;
+    sink = nodes + 1;
+    edges.clear();
+    firstEdge.assign(nodes + 2, -1);
+
+    // A wall's node is its in-node; the out-node follows it
+    auto exitOf = [&](int tile) { return layout[tile] == Wall ? node[tile] + 1 : node[tile]; };
+    std::vector<unsigned char> toSink(nodes, 0);
+    std::vector<unsigned char> fromSource(nodes, 0);
+    for (int tile = 0; tile < count; ++tile) {
+        if (layout[tile] == Wall && !isGoal[tile]) {
+            addEdge(node[tile], node[tile] + 1, std::max(1, grid.getHealth(tile)));
+        }
+    }
+    for (int tile = 0; tile < count; ++tile) {
+        if (!isGoal[tile] && node[tile] < 0) {
+            continue;
+        }
+        const int row = grid.rowOf(tile);
+        const int col = grid.colOf(tile);
+        const int right = col + 1 < grid.getCols() ? grid.index(row, col + 1) : -1;
+        const int below = row + 1 < grid.getRows() ? grid.index(row + 1, col) : -1;
+        for (int neighbor : {right, below}) {
+            if (neighbor < 0 || (!isGoal[neighbor] && node[neighbor] < 0) || (isGoal[tile] && isGoal[neighbor])) {
+                continue;
+            }
+            if (isGoal[tile] || isGoal[neighbor]) {
+                toSink[exitOf(isGoal[tile] ? neighbor : tile)] = 1;
+            } else if (layout[tile] == Wall || layout[neighbor] == Wall) {
+                addEdge(exitOf(tile), node[neighbor], UNLIMITED);
+                addEdge(exitOf(neighbor), node[tile], UNLIMITED);
+            }
+        }
+    }
+    for (int spawn : spawns) {
+        if (spawn >= 0 && spawn < count && !isGoal[spawn] && node[spawn] >= 0) {
+            fromSource[node[spawn]] = 1;
+        }
+    }
+    for (int from = 0; from < nodes; ++from) {
+        if (fromSource[from]) {
+            addEdge(source, from, UNLIMITED);
+        }
+        if (toSink[from]) {
+            addEdge(from, sink, UNLIMITED);
+        }
+    }
+}
+
+bool SiegePlanner::levelGraph(std::int64_t minCapacity) {
+    level.assign(firstEdge.size(), -1);
+    queue.clear();
+    level[source] = 0;
+    queue.push_back(source);
+    for (size_t head = 0; head < queue.size(); ++head) {
+        const int node = queue[head];
+        for (int e = firstEdge[node]; e != -1; e = edges[e].next) {
+            if (edges[e].capacity >= minCapacity && level[edges[e].to] < 0) {
+                level[edges[e].to] = level[node] + 1;
+                queue.push_back(edges[e].to);
+            }
+        }
+    }
+    return level[sink] >= 0;
+}
+
+// One augmenting path along the levels, found without recursion; dead ends
+// are taken out of the level graph so they are not tried again
+std::int64_t SiegePlanner::augment() {
+    pathEdges.clear();
+    int node = source;
+    while (true) {
+        if (node == sink) {
+            std::int64_t pushed = UNLIMITED;
+            for (int e : pathEdges) {
+                pushed = std::min(pushed, edges[e].capacity);
+            }
+            for (int e : pathEdges) {
+                edges[e].capacity -= pushed;
+                edges[e ^ 1].capacity += pushed;
+            }
+            return pushed;
+        }
+        int& e = currentEdge[node];
+        while (e != -1 && (edges[e].capacity == 0 || level[edges[e].to] != level[node] + 1)) {
+            e = edges[e].next;
+        }
+        if (e != -1) {
+            pathEdges.push_back(e);
+            node = edges[e].to;
+            continue;
+        }
+        level[node] = -1;
+        if (pathEdges.empty()) {
+            return 0;
+        }
+        node = edges[pathEdges.back() ^ 1].to;
+        pathEdges.pop_back();
+    }
+}
+
+// Every tile on the spawn side is given the cut wall its approach field path
+// ends at, resolving each chain of next steps once
+void SiegePlanner::assignTargets(const TileGrid& grid) {
+    approach.build(grid, cutWalls);
+    for (int wall : cutWalls) {
+        target[wall] = wall;
+    }
+    for (int tile = 0; tile < grid.size(); ++tile) {
+        if (target[tile] != -1 || node[tile] < 0 || level[node[tile]] < 0 || !approach.isReachable(tile)) {
+            continue;
+        }
+        queue.clear();
+        int current = tile;
+        while (current >= 0 && target[current] == -1) {
+            queue.push_back(current);
+            current = approach.getNextStep(current);
+        }
+        const int wall = current >= 0 ? target[current] : -1;
+        for (int step : queue) {
+            target[step] = wall;
+        }
+    }
+}
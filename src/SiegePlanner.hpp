@@ -0,0 +1,90 @@
+#ifndef SIEGEPLANNER_HPP
+#define SIEGEPLANNER_HPP
+
+#include <cstdint>
+#include <vector>
+#include "FlowField.hpp"
+#include "TileGrid.hpp"
+
+// Finds the weakest part of a fortification: when walls close every route
+// from the spawn tiles to the goal tiles, the ring of walls with the least total
+// health that closes them all by itself (a minimum cut, found by max-flow with
+// wall health as tile capacity; open tiles are uncapped, other blocked tiles
+// are impassable). Of the cheapest rings the outermost is taken. Units are then
+// pointed at the nearest wall of that ring through a flow field, so assigning a
+// breach target is a lookup rather than a search.
+//
+// Only changes to the layout (which tiles are open, walls or impassable) make
+// the plan stale; wall damage does not move the cut. Replanning is lazy.
+class SiegePlanner {
+public:
+    SiegePlanner();
+
+    void build(const TileGrid& grid, const std::vector<int>& spawnTiles, const std::vector<int>& goalTiles);
+    // Marks the plan stale if any of the tiles changed layout
+    void applyChanges(const TileGrid& grid, const std::vector<int>& changedTiles);
+    // Replans if the layout changed since the last plan
+    void update(const TileGrid& grid);
+
+    // True if walls cut every spawn tile off from the goals (the cut is non-empty)
+    bool isSealed() const;
+    const std::vector<int>& getCutWalls() const;
+    // Total health of the cut walls when the plan was made
+    std::int64_t getCutHealth() const;
+    // Cut wall assigned to tile (the one its unit should breach), or -1
+    int getTarget(int tile) const;
+    // Field leading every tile that can reach the cut to its assigned wall
+    const FlowField& getApproachField() const;
+    // Number of times the cut has been computed
+    int getPlanCount() const;
+
+private:
+    struct Edge {
+        int to;
+        int next; // Next edge out of the same node, or -1
+        std::int64_t capacity;
+    };
+
+    enum Layout : unsigned char {
+        Open,
+        Wall,
+        Impassable
+    };
+
+    std::vector<int> spawns;
+    std::vector<int> goals;
+    std::vector<unsigned char> isGoal;
+    std::vector<unsigned char> layout; // Per tile, as of the last plan
+    bool stale;
+
+    std::vector<int> cutWalls;
+    std::int64_t cutHealth;
+    std::vector<int> target;
+    FlowField approach;
+    int planCount;
+
+    // Flow network: node[t] is the open area tile t lies in, or for a wall its
+    // in-node (the out-node is next), so that capacities sit on walls; edge e
+    // and e ^ 1 are each other's reverse
+    std::vector<int> node;
+    std::vector<Edge> edges;
+    std::vector<int> firstEdge;
+    std::vector<int> currentEdge;
+    std::vector<int> level;
+    std::vector<int> queue;
+    std::vector<int> pathEdges;
+    int source;
+    int sink;
+
+    static Layout layoutOf(const TileGrid& grid, int tile);
+    void plan(const TileGrid& grid);
+    void buildNetwork(const TileGrid& grid);
+    void addEdge(int from, int to, std::int64_t capacity);
+    // Levels nodes by BFS over edges with at least minCapacity left; true if
+    // the sink is reached
+    bool levelGraph(std::int64_t minCapacity);
+    std::int64_t augment();
+    void assignTargets(const TileGrid& grid);
+};
+
+#endif // SIEGEPLANNER_HPP
@@ -0,0 +1,67 @@
+// SimulationLod.cpp
+#include "SimulationLod.hpp"
+#include "Tower.hpp"
+
+constexpr float SimulationLod::COARSE_STEP;
+constexpr float SimulationLod::REFRESH_INTERVAL;
+constexpr float SimulationLod::INTERACTION_MARGIN;
+constexpr float SimulationLod::VIEW_MARGIN;
+
+SimulationLod::SimulationLod() : enabled(false), sinceRefresh(REFRESH_INTERVAL) {}
+
+void SimulationLod::setEnabled(bool enabled) {
+    this->enabled = enabled;
+    sinceRefresh = REFRESH_INTERVAL; // Rebuild before the first coarse tick
+}
+
+bool SimulationLod::isEnabled() const {
+    return enabled;
+}
+
+void SimulationLod::setView(const sf::FloatRect& view) {
+    this->view = sf::FloatRect(view.left - VIEW_MARGIN, view.top - VIEW_MARGIN,
+                               view.width + 2.0f * VIEW_MARGIN, view.height + 2.0f * VIEW_MARGIN);
+}
+
+void SimulationLod::update(const Map& map, float deltaTime) {
+    if (!enabled) {
+        return;
+    }
+    sinceRefresh += deltaTime;
+    if (sinceRefresh >= REFRESH_INTERVAL || hot.size() != map.getGrid().size()) {
+        sinceRefresh = 0.0f;
+        rebuild(map);
+    }
+}
+
+bool SimulationLod::isInView(float x, float y) const {
+    return view.contains(x, y);
+}
+
+bool SimulationLod::isHot(int tile) const {
+    return hot.isHot(tile);
+}
+
+const HotMask& SimulationLod::getHotMask() const {
+    return hot;
+}
+
+void SimulationLod::rebuild(const Map& map) {
+    const TileGrid& grid = map.getGrid();
+    const std::vector<sf::Vector2f>& positions = map.getTilePositions();
+    hot.reset(grid.size());
+    for (const auto& tower : map.getTowers()) {
+        hot.stamp(grid, positions, tower->getPosition(), tower->getRange() + INTERACTION_MARGIN);
+    }
+    for (int tile = 0; tile < grid.size(); ++tile) {
+        if (map.getTileAt(tile).hasTrap()) {
+            hot.stamp(grid, positions, positions[tile], INTERACTION_MARGIN);
+        }
+    }
+    // Arriving at the town hall is decided per frame too
+    for (const TileCoordinates& goal : map.getGoalTiles()) {
+        if (grid.inBounds(goal.row, goal.col)) {
+            hot.stamp(grid, positions, positions[grid.index(goal.row, goal.col)], INTERACTION_MARGIN);
+        }
+    }
+}
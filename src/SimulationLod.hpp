@@ -0,0 +1,45 @@
+#ifndef SIMULATIONLOD_HPP
+#define SIMULATIONLOD_HPP
+
+#include <SFML/Graphics.hpp>
+#include "HotMask.hpp"
+#include "Map.hpp"
+
+// Simulation level of detail for large hordes. Keeps a per-tile "hot" mask of
+// everything within reach of a tower, a trap or the town hall, and the camera
+// rectangle. A unit that is off screen and on cold tiles does not need
+// per-frame movement, animation or trap sweeps, and UnitManager advances it
+// analytically along its path in coarse steps instead. Both inputs are read
+// concurrently by the parallel update pass and only written between updates.
+class SimulationLod {
+public:
+    static constexpr float COARSE_STEP = 0.25f;     // Seconds per coarse advance
+    static constexpr float REFRESH_INTERVAL = 0.5f; // Seconds between hot mask rebuilds
+    static constexpr float INTERACTION_MARGIN = 96.0f; // Pixels beyond tower range and around traps
+    static constexpr float VIEW_MARGIN = 128.0f;    // Pixels around the camera still drawn
+
+    SimulationLod();
+
+    void setEnabled(bool enabled);
+    bool isEnabled() const;
+    void setView(const sf::FloatRect& view);
+
+    // Rebuilds the hot mask when the refresh interval has passed or the map
+    // size changed. Towers and traps placed in between are picked up at the
+    // next rebuild; the margin covers what a coarse step can travel meanwhile.
+    void update(const Map& map, float deltaTime);
+    // Right away, whether or not level of detail is on
+    void rebuild(const Map& map);
+
+    bool isInView(float x, float y) const;
+    bool isHot(int tile) const;
+    const HotMask& getHotMask() const;
+
+private:
+    bool enabled;
+    sf::FloatRect view;
+    HotMask hot;
+    float sinceRefresh;
+};
+
+#endif // SIMULATIONLOD_HPP
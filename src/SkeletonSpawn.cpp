@@ -5,93 +5,72 @@
 #include <ctime>
 #include <iostream>
 #include <algorithm>
+#include <limits>
 #include <random>
 
 // Constructor
 // Constructor
-SkeletonSpawn::SkeletonSpawn(const Map& map)
-    : pathFinder(map), nextSpawnIndex(0), timeSinceLastSpawn(0.0f), spawningActive(false) {
+SkeletonSpawn::SkeletonSpawn(const Map& map, UnitManager& units)
+    : units(units), nextSpawnIndex(0), timeSinceLastSpawn(0.0f), spawningActive(false) {
     std::srand(static_cast<unsigned int>(std::time(nullptr)));
-    int rows = map.getRows();
-    int cols = map.getCols();
-
-    // Populate presetTiles with all boundary tiles
-    for (int i = 0; i < rows; ++i) {
-        presetTiles.emplace_back(TileCoordinates{i, 0}); // Left boundary
-        presetTiles.emplace_back(TileCoordinates{i, cols - 1}); // Right boundary
-    }
-    for (int j = 0; j < cols; ++j) {
-        presetTiles.emplace_back(TileCoordinates{0, j}); // Top boundary
-        presetTiles.emplace_back(TileCoordinates{rows - 1, j}); // Bottom boundary
-    }
+    // Spawn on the map's spawn tiles (every boundary tile unless configured
+    // otherwise); placements that would cut them off are refused by the map
+    presetTiles = map.getSpawnTiles();
 }
 
 void SkeletonSpawn::handleEvent(const sf::Event& event, Map& /*map*/) {
     if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::I) {
-        spawningActive = true;
-        nextSpawnIndex = 0;
-        timeSinceLastSpawn = 0.0f;
-        // Create a random device and a random number generator
-        std::random_device rd;
-        std::mt19937 g(rd());
-        // Shuffle presetTiles with the random generator
-        std::shuffle(presetTiles.begin(), presetTiles.end(), g);
+        start();
     }
 }
 
+void SkeletonSpawn::start() {
+    spawningActive = true;
+    nextSpawnIndex = 0;
+    timeSinceLastSpawn = 0.0f;
+    // Create a random device and a random number generator
+    std::random_device rd;
+    std::mt19937 g(rd());
+    // Shuffle presetTiles with the random generator
+    std::shuffle(presetTiles.begin(), presetTiles.end(), g);
+}
+
+float SkeletonSpawn::getTimeToNextSpawn() const {
+    if (!spawningActive || nextSpawnIndex >= presetTiles.size()) {
+        return std::numeric_limits<float>::infinity();
+    }
+    return std::max(0.0f, spawnInterval - timeSinceLastSpawn);
+}
+
 void SkeletonSpawn::spawnSkeleton(Map& map, const TileCoordinates& spawnLocation) {
     auto tile = map.getTile(spawnLocation.row, spawnLocation.col);
-    if (!tile || tile->getBuilding()) {
+    if (!tile || tile.getBuilding()) {
         std::cerr << "Invalid or occupied tile at (" << spawnLocation.row << ", " << spawnLocation.col << ").\n";
         return;
     }
+    if (!map.hasPathToGoal(tile)) {
+        // Not even breaching walls leads anywhere from here
+        std::cerr << "Spawn tile (" << spawnLocation.row << ", " << spawnLocation.col << ") is cut off from the town hall.\n";
+        return;
+    }
 
     sf::Vector2f isoPos = IsometricUtils::tileToScreen(spawnLocation.row, spawnLocation.col);
     sf::Vector2f skeletonPosition = sf::Vector2f(isoPos.x + Tile::TILE_WIDTH / 2.0f, isoPos.y + Tile::TILE_HEIGHT);
 
-    // Find path from spawn location to goal
-    std::vector<std::shared_ptr<Tile>> path = pathFinder.findPath(
-        map.getTile(spawnLocation.row, spawnLocation.col),
-        map.getTile(goal.row, goal.col),
-        0
-    );
-
+    // Follow the shared flow field from spawn location to goal, or head for the
+    // weakest wall if walls close the town hall in; failing both the skeleton
+    // requests a path itself
+    Tile breachWall;
+    SharedPath path = map.followSiegePath(tile, 0, breachWall);
     if (path.empty()) {
-        std::cerr << "No available path from (" << spawnLocation.row << ", " << spawnLocation.col
-                  << ") to (" << goal.row << ", " << goal.col << ").\n";
-        return;
+        path = map.followFlowField(tile, 0);
     }
 
-    // Create a skeleton with the map reference
-    skeletons.emplace_back(std::make_unique<Skeleton>(skeletonPosition.x, skeletonPosition.y, path, map));
+    units.spawnSkeleton(skeletonPosition.x, skeletonPosition.y, path);
 
     // std::cout << "Skeleton placed at tile: (" << spawnLocation.row << ", " << spawnLocation.col << ").\n";
 }
 
-void SkeletonSpawn::draw(sf::RenderWindow& window, float deltaTime) {
-    for (auto& skeleton : skeletons) {
-        skeleton->draw(window, deltaTime);
-    }
-}
-
-const std::vector<std::unique_ptr<Skeleton>>& SkeletonSpawn::getSkeletons() const {
-    return skeletons;
-}
-
-std::vector<std::unique_ptr<Skeleton>>& SkeletonSpawn::getSkeletons() {
-    return skeletons;
-}
-
-void SkeletonSpawn::removeDeadSkeletons() {
-    size_t initialSize = skeletons.size();
-    skeletons.erase(
-        std::remove_if(skeletons.begin(), skeletons.end(),
-            [](const std::unique_ptr<Skeleton>& s) { return !s->isAlive(); }),
-        skeletons.end()
-    );
-    size_t finalSize = skeletons.size();
-}
-
 void SkeletonSpawn::update(float deltaTime, Map& map) {
     if (spawningActive) {
         timeSinceLastSpawn += deltaTime; // Increment time with each frame
@@ -105,8 +84,4 @@ void SkeletonSpawn::update(float deltaTime, Map& map) {
             }
         }
     }
-    // Update the position of all active skeletons
-    for (auto& skeleton : skeletons) {
-        skeleton->move(deltaTime);
-    }
 }
\ No newline at end of file
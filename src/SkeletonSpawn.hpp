@@ -4,35 +4,31 @@
 #include <SFML/Graphics.hpp>
 #include <vector>
 #include <memory>
-#include "Skeleton.hpp"
 #include "Map.hpp"
 #include "Pathfinding.hpp"
 #include "IsometricUtils.hpp"
+#include "UnitManager.hpp"
 
 class SkeletonSpawn {
 public:
-    SkeletonSpawn(const Map& map);
+    // Spawned skeletons are added to units, which moves and draws them
+    SkeletonSpawn(const Map& map, UnitManager& units);
     void handleEvent(const sf::Event& event, Map& map);
+    // Starts a wave over the preset tiles in a new random order (key I)
+    void start();
     void update(float deltaTime, Map& map);
-    void draw(sf::RenderWindow& window, float deltaTime);
-
-    const std::vector<std::unique_ptr<Skeleton>>& getSkeletons() const;
-    std::vector<std::unique_ptr<Skeleton>>& getSkeletons();
-
-    void removeDeadSkeletons();
+    // Seconds until update() spawns the next skeleton, or infinity while no
+    // wave is spawning
+    float getTimeToNextSpawn() const;
 
 private:
-    std::vector<std::unique_ptr<Skeleton>> skeletons;
+    UnitManager& units;
     std::vector<TileCoordinates> presetTiles;
-    Pathfinding pathFinder;
-    TileCoordinates goal = {14, 14};
     bool spawningActive;
     float timeSinceLastSpawn;
     const float spawnInterval = 0.5f;
     size_t nextSpawnIndex;
 
-    // Reference to the map is no longer required as a member here since it’s passed directly to Skeleton
-
     void spawnSkeleton(Map& map, const TileCoordinates& spawnLocation);
 };
 
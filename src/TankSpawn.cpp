@@ -5,41 +5,43 @@
 #include <ctime>
 #include <iostream>
 #include <algorithm>
+#include <limits>
 #include <random>
 
-// Constructor initializes preset tiles and initializes the pathfinder with the provided map
-TankSpawn::TankSpawn(const Map& map)
-    : pathFinder(map), nextSpawnIndex(0), timeSinceLastSpawn(0.0f), spawningActive(false) {
+// Constructor initializes preset tiles
+TankSpawn::TankSpawn(const Map& map, UnitManager& units)
+    : units(units), nextSpawnIndex(0), timeSinceLastSpawn(0.0f), spawningActive(false) {
     std::srand(static_cast<unsigned int>(std::time(nullptr)));
-    int rows = map.getRows();
-    int cols = map.getCols();
-
-    // Populate presetTiles with all boundary tiles
-    for (int i = 0; i < rows; ++i) {
-        presetTiles.emplace_back(TileCoordinates{i, 0}); // Left boundary
-        presetTiles.emplace_back(TileCoordinates{i, cols - 1}); // Right boundary
-    }
-    for (int j = 0; j < cols; ++j) {
-        presetTiles.emplace_back(TileCoordinates{0, j}); // Top boundary
-        presetTiles.emplace_back(TileCoordinates{rows - 1, j}); // Bottom boundary
-    }
+    // The map's spawn tiles, shared with SkeletonSpawn
+    presetTiles = map.getSpawnTiles();
 }
 
 
 // Handles events related to tank spawning
 void TankSpawn::handleEvent(const sf::Event& event, Map& map) {
     if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::P) {
-        spawningActive = true;
-        nextSpawnIndex = 0;
-        timeSinceLastSpawn = 0.0f;
+        start();
+    }
+}
+
+void TankSpawn::start() {
+    spawningActive = true;
+    nextSpawnIndex = 0;
+    timeSinceLastSpawn = 0.0f;
 
-        // Create a random device and a random number generator
-        std::random_device rd;
-        std::mt19937 g(rd());
+    // Create a random device and a random number generator
+    std::random_device rd;
+    std::mt19937 g(rd());
+
+    // Shuffle presetTiles with the random generator
+    std::shuffle(presetTiles.begin(), presetTiles.end(), g);
+}
 
-        // Shuffle presetTiles with the random generator
-        std::shuffle(presetTiles.begin(), presetTiles.end(), g);
+float TankSpawn::getTimeToNextSpawn() const {
+    if (!spawningActive || nextSpawnIndex >= presetTiles.size()) {
+        return std::numeric_limits<float>::infinity();
     }
+    return std::max(0.0f, spawnInterval - timeSinceLastSpawn);
 }
 
 // Spawns a tank on a randomly selected preset tile
@@ -47,7 +49,7 @@ void TankSpawn::spawnTankOnPresetTile(Map& map) {
     if (!presetTiles.empty()) {
         TileCoordinates spawnLocation = presetTiles[nextSpawnIndex];
         auto tile = map.getTile(spawnLocation.row, spawnLocation.col);
-        if (!tile || tile->getBuilding()) {
+        if (!tile || tile.getBuilding()) {
             std::cerr << "Invalid or occupied tile at (" << spawnLocation.row << ", " << spawnLocation.col << ").\n";
             return;
         }
@@ -55,7 +57,7 @@ void TankSpawn::spawnTankOnPresetTile(Map& map) {
         sf::Vector2f tankPosition = sf::Vector2f(isoPos.x, isoPos.y + Tile::TILE_HEIGHT);
 
         // Pathfinding from spawn location to the town hall.
-        // std::vector<std::shared_ptr<Tile>> path = pathFinder.findPath(
+        // std::vector<Tile> path = pathFinder.findPath(
         //     map.getTile(spawnLocation.row, spawnLocation.col),
         //     map.getTile(townHall.row, townHall.col)
         // );
@@ -67,7 +69,7 @@ void TankSpawn::spawnTankOnPresetTile(Map& map) {
         // }
         std::cout << "Tank placed at tile: (" << spawnLocation.row << ", " << spawnLocation.col << ").\n";
 
-        tanks.emplace_back(std::make_shared<Tank>(tankPosition.x, tankPosition.y, map, *map.getTile(townHall.row, townHall.col)));
+        units.spawnTank(tankPosition.x, tankPosition.y);
     } else {
         std::cerr << "No preset tiles available for spawning tanks.\n";
     }
@@ -87,35 +89,4 @@ void TankSpawn::update(float deltaTime, Map& map) {
             }
         }
     }
-
-    // Update the tanks
-    for (auto& tank : tanks) {
-        tank->update(deltaTime); // Correctly call the update method
-    }
-}
-
-// Draws all active tanks
-void TankSpawn::draw(sf::RenderWindow& window, float deltaTime, Map& map) {
-    for (auto& tank : tanks) {
-        tank->draw(window);
-    }
-}
-
-// Returns a const reference to the tanks vector
-const std::vector<std::shared_ptr<Tank>>& TankSpawn::getTanks() const {
-    return tanks;
 }
-
-// Removes dead tanks
-// void TankSpawn::removeDeadTanks() {
-//     size_t initialSize = tanks.size();
-//     tanks.erase(
-//         std::remove_if(tanks.begin(), tanks.end(),
-//             [](const std::shared_ptr<Tank>& t) { return !t->isAlive(); }),
-//         tanks.end()
-//     );
-//     size_t finalSize = tanks.size();
-//     if (initialSize != finalSize) {
-//         std::cout << "Removed " << (initialSize - finalSize) << " dead tank(s).\n";
-//     }
-// }
\ No newline at end of file
@@ -2,12 +2,11 @@
 #ifndef TANKSPAWN_HPP
 #define TANKSPAWN_HPP
 
-#include "Tank.hpp"
 #include <vector>
 #include <SFML/Graphics.hpp>
 #include "Map.hpp"
 #include "IsometricUtils.hpp" // Included to use TileCoordinates
-#include "Pathfinding.hpp"
+#include "UnitManager.hpp"
 #include "Trap.hpp"
 
 // Structure to hold tile coordinates
@@ -18,32 +17,26 @@
 
 class TankSpawn {
 public:
-    // Constructor initializes preset tiles and initializes the pathfinder with the provided map
-    TankSpawn(const Map& map);
+    // Constructor initializes preset tiles; spawned tanks are handed to units
+    TankSpawn(const Map& map, UnitManager& units);
 
     // Handles events related to tank spawning
     void handleEvent(const sf::Event& event, Map& map);
 
-    // Updates all active tanks and manages spawning logic
-    void update(float deltaTime, Map& map);
-
-    // Draws all active tanks on the window
-    void draw(sf::RenderWindow& window, float deltaTime, Map& map);
+    // Starts a wave over the preset tiles in a new random order (key P)
+    void start();
 
-    // Getter Methods
-    const std::vector<std::shared_ptr<Tank>>& getTanks() const;
+    // Manages spawning logic; UnitManager moves the tanks
+    void update(float deltaTime, Map& map);
 
-    // Removal Method
-    // void removeDeadTanks();
+    // Seconds until update() spawns the next tank, or infinity while no wave
+    // is spawning
+    float getTimeToNextSpawn() const;
 
 private:
-    std::vector<std::shared_ptr<Tank>> tanks; // Active tanks list
-    Pathfinding pathFinder; // Pathfinding utility
+    UnitManager& units; // Owns the spawned tanks
     std::vector<TileCoordinates> presetTiles; // Predefined spawn locations
 
-    // Coordinates of the town hall (destination for tanks)
-    TileCoordinates townHall = {14, 14};
-
     // Spawns a tank on a randomly selected preset tile
     void spawnTankOnPresetTile(Map& map);
 
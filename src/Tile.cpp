@@ -2,53 +2,59 @@
 #include "Building.hpp"
 #include "TextureManager.hpp"
 #include "IsometricUtils.hpp"
+#include "GridConnectivity.hpp"
 #include <iostream>
 #include <random>
 
-// Constructor
-Tile::Tile(int row, int col, TileType type)
-    : type(type), row(row), col(col), blockStatus(false), building(nullptr), tower(nullptr) {
-    updateTexture();
+void TileStore::resize(int rows, int cols) {
+    grid.resize(rows, cols);
+    positions.assign(grid.size(), sf::Vector2f(0.0f, 0.0f));
+    render.clear();
+    render.resize(grid.size());
+    occupants.clear();
+    occupants.resize(grid.size());
 }
 
-// Copy Constructor: Remove if deep copying isn't needed
-Tile::Tile(const Tile& other)
-    : type(other.type), row(other.row), col(other.col), blockStatus(other.blockStatus),
-      texturePath(other.texturePath), building(other.building), tower(other.tower), // Use references
-      health(other.health), grassTileIndex(other.grassTileIndex) {
-    if (type == TileType::Grass) {
-        loadTexture();
-    } else {
-        TextureManager& tm = TextureManager::getInstance();
-        auto texturePtr = tm.getTexture(texturePath);
-        if (texturePtr) {
-            sprite.setTexture(*texturePtr);
-            sprite.setScale(
-                static_cast<float>(TILE_WIDTH) / static_cast<float>(texturePtr->getSize().x),
-                static_cast<float>(TILE_HEIGHT) / static_cast<float>(texturePtr->getSize().y)
-            );
-        }
-    }
-    sprite.setOrigin(other.sprite.getOrigin());
-    sprite.setPosition(other.sprite.getPosition());
-    sprite.setScale(other.sprite.getScale());
+// Constructors
+Tile::Tile() : store(nullptr), index(-1) {}
+
+Tile::Tile(TileStore* store, int index) : store(store), index(index) {}
+
+Tile::operator bool() const {
+    return store != nullptr;
+}
+
+bool Tile::operator==(const Tile& other) const {
+    return store == other.store && index == other.index;
+}
+
+bool Tile::operator!=(const Tile& other) const {
+    return !(*this == other);
+}
+
+int Tile::getIndex() const {
+    return index;
 }
 
 // Setter for texturePath (only for non-grass tiles)
 void Tile::setTexturePath(const std::string& path) {
-    texturePath = path;
+    store->render[index].texturePath = path;
     loadTexture();
 }
 
 // Getter for texturePath
 std::string Tile::getTexturePath() const {
-    return texturePath;
+    return store->render[index].texturePath;
 }
 
 // Helper method to load texture based on type and texturePath
 void Tile::loadTexture() {
     TextureManager& tm = TextureManager::getInstance();
     std::shared_ptr<sf::Texture> texturePtr;
+    TileGrid& grid = store->grid;
+    sf::Sprite& sprite = store->render[index].sprite;
+    std::string& texturePath = store->render[index].texturePath;
+    TileType type = grid.getType(index);
 
     switch (type) {
         case TileType::Grass: {
@@ -65,12 +71,13 @@ void Tile::loadTexture() {
             const int tileHeight = 32; // Adjust to your sprite sheet tile height
 
             // If grassTileIndex is not set, randomly assign one
-            if (grassTileIndex == -1) {
+            if (grid.getGrassTileIndex(index) == -1) {
                 std::random_device rd;
                 std::mt19937 gen(rd());
                 std::uniform_int_distribution<> dis(0, totalTiles - 1);
-                grassTileIndex = dis(gen);
+                grid.setGrassTileIndex(index, dis(gen));
             }
+            int grassTileIndex = grid.getGrassTileIndex(index);
 
             // Calculate tile position in sprite sheet
             int tileX = (grassTileIndex % columns) * tileWidth;
@@ -104,15 +111,15 @@ void Tile::loadTexture() {
         case TileType::Wall:
             texturePath = "../assets/walls/brick_wall.png";
             texturePtr = tm.getTexture(texturePath);
-            health = 100; // Initialize health for walls
+            grid.setHealth(index, 100); // Initialize health for walls
             break;
         
         case TileType::Trap:
-            texturePtr = tm.getTexture(trap->getTexturePath());
+            texturePtr = tm.getTexture(store->occupants[index].trap->getTexturePath());
             break;
 
         case TileType::Tower:
-            texturePtr = tm.getTexture(tower->getTexturePath());
+            texturePtr = tm.getTexture(store->occupants[index].tower->getTexturePath());
             break;
 
     }
@@ -125,73 +132,75 @@ void Tile::loadTexture() {
             static_cast<float>(TILE_HEIGHT) / static_cast<float>(texturePtr->getSize().y)
         );
     } else if (type != TileType::Grass && !texturePtr) {
-        std::cerr << "Failed to load texture for tile at (" << row << ", " << col << ")\n";
+        std::cerr << "Failed to load texture for tile at (" << getRow() << ", " << getCol() << ")\n";
     }
 }
 
 // Set Type without altering building presence
 void Tile::setType(TileType newType) {
-    type = newType;
+    TileGrid& grid = store->grid;
+    grid.setType(index, newType);
     // Reset grassTileIndex if changing to Grass
-    if (type == TileType::Grass) {
-        grassTileIndex = -1;
+    if (newType == TileType::Grass) {
+        grid.setGrassTileIndex(index, -1);
     }
     loadTexture();
     // Update blockStatus based on type and building presence
-    if (building != nullptr) {
-        blockStatus = true;
+    if (store->occupants[index].building != nullptr) {
+        grid.setBlocked(index, true);
     } else {
         // Define which tile types are blocked
-        switch (type) {
+        switch (newType) {
             case TileType::Water:
             case TileType::Trap:
             case TileType::Tower:
             case TileType::Wall:
-                blockStatus = true;
-                if (type == TileType::Wall) {
-                    health = 100; // Reset health for walls
+                grid.setBlocked(index, true);
+                if (newType == TileType::Wall) {
+                    grid.setHealth(index, 100); // Reset health for walls
                 }
                 break;
             default:
-                blockStatus = false;
+                grid.setBlocked(index, false);
                 break;
         }
     }
 }
 
 TileType Tile::getType() const {
-    return type;
+    return store->grid.getType(index);
 }
 
 void Tile::setBuilding(std::shared_ptr<Building> buildingPtr) {
-    building = buildingPtr;
+    store->occupants[index].building = buildingPtr;
     if (buildingPtr) {
         // When a building is present, block the tile
-        blockStatus = true;
+        store->grid.setBlocked(index, true);
     } else {
         // Re-evaluate blockStatus based on tile type
-        switch (type) {
+        switch (getType()) {
             case TileType::Water:
             case TileType::Wall:
-                blockStatus = true;
+                store->grid.setBlocked(index, true);
                 break;
             default:
-                blockStatus = false;
+                store->grid.setBlocked(index, false);
                 break;
         }
     }
 }
 
 std::shared_ptr<Building> Tile::getBuilding() const {
-    return building;
+    return store->occupants[index].building;
 }
 
 void Tile::setPosition(float x, float y) {
-    sprite.setPosition(x, y);
+    store->positions[index] = sf::Vector2f(x, y);
+    store->render[index].sprite.setPosition(x, y);
 }
 
 sf::Vector2f Tile::getPosition() const {
-    return sprite.getPosition();
+    return store->positions[index];
 }
 
 void Tile::updateTexture() {
@@ -199,105 +208,100 @@ void Tile::updateTexture() {
 }
 
 int Tile::getRow() const {
-    return row;
+    return store->grid.rowOf(index);
 }
 
 int Tile::getCol() const {
-    return col;
-}
-
-void Tile::addEdge(std::shared_ptr<Tile> neighbor) {
-    neighbors.push_back(neighbor);
-}
-
-const std::vector<std::shared_ptr<Tile>>& Tile::getNeighbors() const {
-    return neighbors;
+    return store->grid.colOf(index);
 }
 
-std::shared_ptr<Tile> Tile::getNeighbor(int dx, int dy) const {
-    for (const auto& neighbor : neighbors) {
-        if (neighbor->getRow() == row + dx && neighbor->getCol() == col + dy) {
-            return neighbor;
-        }
+Tile Tile::getNeighbor(int dx, int dy) const {
+    int neighbor = neighborIndex<MapConnectivity>(store->grid, index, dx, dy);
+    if (neighbor < 0) {
+        return Tile();
     }
-    return nullptr;
+    return Tile(store, neighbor);
 }
 
 bool Tile::isBlocked() const {
-    return blockStatus;
+    return store->grid.isBlocked(index);
 }
 
 bool Tile::isWall() const {
-    return type == TileType::Wall;
+    return getType() == TileType::Wall;
 }
 
 void Tile::draw(sf::RenderWindow& window) const {
+    const sf::Sprite& sprite = store->render[index].sprite;
+    const TileOccupants& occupant = store->occupants[index];
     window.draw(sprite);
-    if (building) {
-        building->draw(window, sprite.getPosition().x, sprite.getPosition().y);
+    if (occupant.building) {
+        occupant.building->draw(window, sprite.getPosition().x, sprite.getPosition().y);
     }
-    if (tower) {
-        tower->render(window);
+    if (occupant.tower) {
+        occupant.tower->render(window);
     }
-    if (trap) {
-        trap->draw(window, sprite.getPosition().x, sprite.getPosition().y);
+    if (occupant.trap) {
+        occupant.trap->draw(window, sprite.getPosition().x, sprite.getPosition().y);
     }
-    if (tower) {
-        tower->render(window);
+    if (occupant.tower) {
+        occupant.tower->render(window);
     }
 }
 
 void Tile::takeDamage(float damage) {
     if (isWall()) {
-        health -= damage;
+        TileGrid& grid = store->grid;
+        int health = static_cast<int>(grid.getHealth(index) - damage);
+        grid.setHealth(index, health);
         // std::cout << "Wall at (" << row << ", " << col << ") takes " 
         //           << damage << " damage, remaining health: " << health << ".\n";
 
         if (health <= 0) {
-            health = 0;
-            blockStatus = false;
-            type = TileType::Grass;
-            building = nullptr;
+            grid.setHealth(index, 0);
+            grid.setBlocked(index, false);
+            grid.setType(index, TileType::Grass);
+            store->occupants[index].building = nullptr;
             updateTexture();  // Update visual representation
-            std::cout << "Wall at (" << row << ", " << col << ") destroyed.\n";
+            std::cout << "Wall at (" << getRow() << ", " << getCol() << ") destroyed.\n";
         }
     }
 }
 
 bool Tile::isDestroyed() const {
-    return health == 0;
+    return getHealth() == 0;
 }
 
 int Tile::getHealth() const {
-    return health;
+    return store->grid.getHealth(index);
 }
 
 void Tile::setHealth(int healthValue) {
-    health = healthValue;
+    store->grid.setHealth(index, healthValue);
 }
 
 void Tile::setBlockStatus(bool status) {
-    blockStatus = status;
+    store->grid.setBlocked(index, status);
 }
 
 void Tile::setTower(std::shared_ptr<Tower> towerPtr) {
     // std::cout << "Tower placed at tile: (" << row << ", " << col << "). ptr: " << towerPtr << "\n";
-    tower = towerPtr;
-    blockStatus = (tower != nullptr);
+    store->occupants[index].tower = towerPtr;
+    store->grid.setBlocked(index, towerPtr != nullptr);
 }
 
 std::shared_ptr<Tower> Tile::getTower() const {
-    return tower;
+    return store->occupants[index].tower;
 }
 
-void Tile::setGrassTileIndex(int index) {
-    grassTileIndex = index;
+void Tile::setGrassTileIndex(int grassIndex) {
+    store->grid.setGrassTileIndex(index, grassIndex);
     updateTexture(); // Trigger texture update with correct grass index
 }
 
 
 int Tile::getGrassTileIndex() const {
-    return grassTileIndex;
+    return store->grid.getGrassTileIndex(index);
 }
 
 // Traps
@@ -306,11 +310,11 @@ void Tile::setTrap(std::shared_ptr<Trap> trapPtr) {
     if (trapPtr) {
         // std::cout << "Trap placed at tile: (" << row << ", " << col << ").\n";
     }
-    trap = trapPtr;
+    store->occupants[index].trap = trapPtr;
 }
 
 std::shared_ptr<Trap> Tile::getTrap() const {
-    return trap;
+    return store->occupants[index].trap;
 }
 
 // void Tile::setTrap(const std::string& trapTexture) {
@@ -321,7 +325,7 @@ std::shared_ptr<Trap> Tile::getTrap() const {
 // }
 
 bool Tile::hasTrap() const {
-    return trap != nullptr;
+    return store->occupants[index].trap != nullptr;
 }
 
 // void Tile::triggerTrap() {
@@ -331,4 +335,4 @@ bool Tile::hasTrap() const {
 //         type = TileType::Grass; // Reset to grass after triggering
 //         updateTexture();
 //     }
-// }
\ No newline at end of file
+// }
@@ -8,24 +8,46 @@
 #include "Building.hpp"
 #include "Tower.hpp"
 #include "Trap.hpp"
+#include "TileGrid.hpp"
 
+// Render-only per-tile data, kept out of the hot TileGrid arrays
+struct TileRenderData {
+    sf::Sprite sprite;
+    std::string texturePath;
+};
+
+// Objects attached to a tile
+struct TileOccupants {
+    std::shared_ptr<Building> building;
+    std::shared_ptr<Tower> tower;
+    std::shared_ptr<Trap> trap;
+};
+
+// Backing storage for all tiles of a map. Every array is indexed by
+// TileGrid::index(row, col).
+struct TileStore {
+    TileGrid grid;
+    std::vector<sf::Vector2f> positions; // Screen position of each tile, read by units every frame
+    std::vector<TileRenderData> render;
+    std::vector<TileOccupants> occupants;
 
-enum class TileType {
-    Grass,
-    Water,
-    Road,
-    Wall,
-    Trap,
-    Tower
+    void resize(int rows, int cols);
 };
 
+// Lightweight handle to one tile in a TileStore. Copying a Tile copies the
+// handle, not the tile; a default-constructed Tile is a null handle.
 class Tile {
 public:
     static const int TILE_WIDTH = 64;
     static const int TILE_HEIGHT = 32;
 
-    Tile(int row, int col, TileType type = TileType::Grass);
-    Tile(const Tile& other); // Copy constructor
+    Tile();
+    Tile(TileStore* store, int index);
+
+    explicit operator bool() const;
+    bool operator==(const Tile& other) const;
+    bool operator!=(const Tile& other) const;
+    int getIndex() const;
 
     void setType(TileType type);
     TileType getType() const;
@@ -57,9 +79,9 @@ public:
     bool isBlocked() const;
     bool isWall() const;
 
-    void addEdge(std::shared_ptr<Tile> neighbor);
-    const std::vector<std::shared_ptr<Tile>>& getNeighbors() const;
-    std::shared_ptr<Tile> getNeighbor(int dx, int dy) const;
+    // Adjacent tile at (row + dx, col + dy) under MapConnectivity, or a null
+    // handle if the offset is not a single step or leaves the map
+    Tile getNeighbor(int dx, int dy) const;
 
     void takeDamage(float damage);
     int getHealth() const;
@@ -74,23 +96,9 @@ public:
     // void triggerTrap();
 
 private:
-    TileType type;
-    int row;
-    int col;
-    bool blockStatus;
-    sf::Sprite sprite;
-    std::string texturePath;
-    std::shared_ptr<Building> building;
-    std::shared_ptr<Tower> tower; // Add Tower management
-    std::vector<std::shared_ptr<Tile>> neighbors;
+    TileStore* store;
+    int index;
     void loadTexture();
-    int health;
-    int grassTileIndex;
-    // // traps
-    std::shared_ptr<Trap> trap;
-
-    // std::string trapTexture;
-    // bool trapActive;
 };
 
-#endif // TILE_HPP
\ No newline at end of file
+#endif // TILE_HPP
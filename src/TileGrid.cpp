@@ -0,0 +1,20 @@
+// TileGrid.cpp
+#include "TileGrid.hpp"
+#include <cstddef>
+
+TileGrid::TileGrid(int rows, int cols) : rows(0), cols(0), version(0) {
+    resize(rows, cols);
+}
+
+void TileGrid::resize(int newRows, int newCols) {
+    rows = newRows;
+    cols = newCols;
+    std::size_t count = static_cast<std::size_t>(rows) * static_cast<std::size_t>(cols);
+    types.assign(count, TileType::Grass);
+    blockStatus.assign(count, 0);
+    health.assign(count, 0);
+    grassTileIndex.assign(count, -1);
+    changes.clear();
+    healthChanges.clear();
+    ++version;
+}
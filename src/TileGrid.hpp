@@ -0,0 +1,91 @@
+#ifndef TILEGRID_HPP
+#define TILEGRID_HPP
+
+#include <cstdint>
+#include <vector>
+
+enum class TileType : std::uint8_t {
+    Grass,
+    Water,
+    Road,
+    Wall,
+    Trap,
+    Tower
+};
+
+// Row-major structure-of-arrays store for the per-tile state that gameplay and
+// pathfinding read every frame. It has no SFML dependency so it can be used by
+// headless tools; sprites and attached buildings live in TileStore (Tile.hpp).
+class TileGrid {
+public:
+    TileGrid(int rows = 0, int cols = 0);
+    void resize(int rows, int cols);
+
+    int getRows() const { return rows; }
+    int getCols() const { return cols; }
+    int size() const { return rows * cols; }
+
+    bool inBounds(int row, int col) const {
+        return row >= 0 && row < rows && col >= 0 && col < cols;
+    }
+    int index(int row, int col) const { return row * cols + col; }
+    int rowOf(int index) const { return index / cols; }
+    int colOf(int index) const { return index % cols; }
+
+    TileType getType(int index) const { return types[index]; }
+    void setType(int index, TileType type) {
+        if (types[index] != type) {
+            types[index] = type;
+            recordChange(index);
+        }
+    }
+
+    bool isBlocked(int index) const { return blockStatus[index] != 0; }
+    void setBlocked(int index, bool blocked) {
+        if (isBlocked(index) != blocked) {
+            blockStatus[index] = blocked ? 1 : 0;
+            recordChange(index);
+        }
+    }
+
+    int getHealth(int index) const { return health[index]; }
+    void setHealth(int index, int value) {
+        if (health[index] != value) {
+            health[index] = static_cast<std::int16_t>(value);
+            healthChanges.push_back(index);
+        }
+    }
+
+    int getGrassTileIndex(int index) const { return grassTileIndex[index]; }
+    void setGrassTileIndex(int index, int value) { grassTileIndex[index] = static_cast<std::int8_t>(value); }
+
+    // Tiles whose type or block status changed since the last clearChanges().
+    // Navigation data derived from the grid repairs itself from this list.
+    const std::vector<int>& getChanges() const { return changes; }
+    void clearChanges() { changes.clear(); }
+    // Tiles whose health changed since the last clearHealthChanges(). Kept apart
+    // from getChanges() because wall damage leaves routes for blocked-tile
+    // searches intact; only health-weighted planners (DStarLite) read it.
+    const std::vector<int>& getHealthChanges() const { return healthChanges; }
+    void clearHealthChanges() { healthChanges.clear(); }
+    // Bumped on every recorded change and on resize
+    std::uint32_t getVersion() const { return version; }
+
+private:
+    int rows;
+    int cols;
+    std::vector<TileType> types;
+    std::vector<std::uint8_t> blockStatus;
+    std::vector<std::int16_t> health;
+    std::vector<std::int8_t> grassTileIndex; // -1 means "pick a random grass tile"
+    std::vector<int> changes;
+    std::vector<int> healthChanges;
+    std::uint32_t version;
+
+    void recordChange(int index) {
+        changes.push_back(index);
+        ++version;
+    }
+};
+
+#endif // TILEGRID_HPP
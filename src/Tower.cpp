@@ -1,6 +1,7 @@
 #include "Tower.hpp"
 #include "TextureManager.hpp"
 #include "BulletManager.hpp"
+#include <algorithm>
 #include <cmath>
 #include <iostream>
 
@@ -42,6 +43,10 @@ bool Tower::isWithinRange(sf::Vector2f troopPosition) const {
     return (dx * dx + dy * dy) <= (range * range);
 }
 
+float Tower::getTimeToNextShot() const {
+    return std::max(0.0f, 1.0f / fireRate - timeSinceLastShot);
+}
+
 void Tower::render(sf::RenderWindow& window) const {
     window.draw(towerSprite);
     // Bullets are managed centrally, so no need to render them here
@@ -52,6 +57,14 @@ int Tower::getId() const {
     return id;
 }
 
+sf::Vector2f Tower::getPosition() const {
+    return position;
+}
+
+float Tower::getRange() const {
+    return range;
+}
+
 std::string Tower::getTexturePath() const {
     return texturePath;
 }
\ No newline at end of file
@@ -12,8 +12,12 @@ public:
     void update(float deltaTime, const std::vector<sf::Vector2f>& troopPositions);
     void render(sf::RenderWindow& window) const;
     bool isWithinRange(sf::Vector2f troopPosition) const;
+    // Seconds until the tower may fire again (0 once it is ready)
+    float getTimeToNextShot() const;
 
     int getId() const;
+    sf::Vector2f getPosition() const;
+    float getRange() const;
     std::string getTexturePath() const;
 
 private:
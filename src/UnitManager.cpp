@@ -0,0 +1,671 @@
+// UnitManager.cpp
+#include "UnitManager.hpp"
+#include "GameState.hpp"
+#include "IsometricUtils.hpp"
+#include "MovementKernel.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <utility>
+
+constexpr float UnitManager::SKELETON_SPEED;
+constexpr float UnitManager::TANK_SPEED;
+
+UnitManager::UnitManager(const Map& map, EffectSystem& effects, int capacity)
+    : map(map),
+      effects(effects),
+      pathFinder(map),
+      units(capacity),
+      skeletonAnimation(AnimationLibrary::getInstance().get(Archetype::Skeleton)),
+      tankAnimation(AnimationLibrary::getInstance().get(Archetype::Tank)),
+      parallel(true),
+      workerEvents(pool.getThreadCount()),
+      coarseCount(0),
+      workerHorizon(pool.getThreadCount()) {
+    skeletonAnimation.setUp(skeletonSprite);
+    tankAnimation.setUp(tankSprite);
+}
+
+UnitHandle UnitManager::spawnSkeleton(float x, float y, const SharedPath& path) {
+    const UnitHandle handle = units.add(UnitType::Skeleton, x, y, SKELETON_SPEED, SKELETON_HEALTH);
+    if (!handle) {
+        std::cerr << "Unit store full (" << units.getCapacity() << "), skeleton not spawned.\n";
+        return handle;
+    }
+    const int index = units.indexOf(handle);
+    units.path[index] = path;
+    if (path.empty()) {
+        recalculateSkeletonPath(index);
+    }
+    return handle;
+}
+
+UnitHandle UnitManager::spawnTank(float x, float y) {
+    const UnitHandle handle = units.add(UnitType::Tank, x, y, TANK_SPEED, TANK_HEALTH);
+    if (!handle) {
+        std::cerr << "Unit store full (" << units.getCapacity() << "), tank not spawned.\n";
+        return handle;
+    }
+    const int index = units.indexOf(handle);
+    const Tile start = tileUnder(index);
+    const Tile townHall = map.getGoalTile();
+    std::cout << "Finding path from (" << start.getRow() << ", " << start.getCol() << ") to town hall at ("
+              << townHall.getRow() << ", " << townHall.getCol() << ").\n";
+    // Tanks breach: when walls close the town hall in, head for the weakest
+    // wall of the fortification, otherwise take the route whose walls are
+    // cheapest to knock down
+    Tile wall;
+    units.path[index] = map.followSiegePath(start, 2, wall);
+    if (units.path[index].empty()) {
+        units.path[index] = map.followBreachPath(start, 2, wall);
+    }
+    units.wallTile[index] = wall ? wall.getIndex() : -1;
+    if (units.path[index].empty()) {
+        units.pendingPath[index] = pathFinder.requestPath(start, townHall, 2);
+        units.state[index] = UnitState::WaitingForPath;
+    }
+    return handle;
+}
+
+UnitHandle UnitManager::spawnTank(float x, float y, const SharedPath& path, int wallTile) {
+    const UnitHandle handle = units.add(UnitType::Tank, x, y, TANK_SPEED, TANK_HEALTH);
+    if (!handle) {
+        std::cerr << "Unit store full (" << units.getCapacity() << "), tank not spawned.\n";
+        return handle;
+    }
+    const int index = units.indexOf(handle);
+    units.path[index] = path;
+    units.wallTile[index] = wallTile;
+    if (path.empty()) {
+        units.pendingPath[index] = pathFinder.requestPath(tileUnder(index), map.getGoalTile(), 2);
+        units.state[index] = UnitState::WaitingForPath;
+    }
+    return handle;
+}
+
+void UnitManager::setParallel(bool enabled) {
+    parallel = enabled;
+}
+
+bool UnitManager::isParallel() const {
+    return parallel;
+}
+
+void UnitManager::setLevelOfDetail(bool enabled) {
+    lod.setEnabled(enabled);
+}
+
+bool UnitManager::isLevelOfDetail() const {
+    return lod.isEnabled();
+}
+
+void UnitManager::setView(const sf::FloatRect& view) {
+    lod.setView(view);
+}
+
+int UnitManager::getCoarseCount() const {
+    return coarseCount;
+}
+
+bool UnitManager::isCoarse(int index) const {
+    return units.coarse[index] != 0;
+}
+
+void UnitManager::update(float deltaTime) {
+    const int count = units.size();
+    lod.update(map, deltaTime);
+    auto classify = [this, deltaTime](int begin, int end, unsigned) {
+        classifyRange(begin, end, deltaTime);
+    };
+    if (parallel) {
+        pool.parallelFor(count, UPDATE_GRAIN, classify);
+    } else {
+        classify(0, count, 0);
+    }
+
+    coarseCount = 0;
+    // Decisions read the map state that other units' decisions change (a
+    // wall one skeleton knocks down is grass for the next), so they run in
+    // unit order on this thread
+    for (int index = 0; index < count; ++index) {
+        units.stepping[index] = 0;
+        if (units.coarse[index]) {
+            coarseCount++; // Nothing to decide until it reaches a hot tile or a wall
+        } else if (units.type[index] == UnitType::Skeleton) {
+            decideSkeleton(index);
+        } else {
+            decideTank(index, deltaTime);
+        }
+    }
+
+    for (std::vector<UnitEvent>& events : workerEvents) {
+        events.clear();
+    }
+    auto advance = [this, deltaTime](int begin, int end, unsigned worker) {
+        advanceRange(begin, end, deltaTime, workerEvents[worker]);
+    };
+    if (parallel) {
+        pool.parallelFor(count, UPDATE_GRAIN, advance);
+    } else {
+        advance(0, count, 0);
+    }
+    applyEvents();
+}
+
+// Per-unit work only: everything else is recorded in events
+void UnitManager::advanceRange(int begin, int end, float deltaTime, std::vector<UnitEvent>& events) {
+    for (int index = begin; index < end; ++index) {
+        if (units.coarse[index] && units.coarseTime[index] >= SimulationLod::COARSE_STEP) {
+            advanceCoarse(index, units.coarseTime[index], events);
+            units.coarseTime[index] = 0.0f;
+        }
+    }
+    step(begin, end, deltaTime);
+    FacingQuantizer::update(units.velX.data() + begin, units.velY.data() + begin, units.facing.data() + begin, end - begin);
+    const size_t skeletonFrames = skeletonAnimation.frameCount();
+    for (int index = begin; index < end; ++index) {
+        if (units.type[index] == UnitType::Skeleton && units.state[index] != UnitState::Destroyed && !units.coarse[index] &&
+            skeletonFrames > 0) {
+            units.animationTime[index] += deltaTime;
+            if (units.animationTime[index] >= skeletonAnimation.frameDuration) {
+                units.animationTime[index] = 0.0f;
+                units.animationFrame[index] = (units.animationFrame[index] + 1) % skeletonFrames;
+            }
+        }
+        if (!units.stepping[index]) {
+            continue;
+        }
+        std::uint32_t order = 0;
+        finishWaypoint(index, events, order);
+        if (units.type[index] == UnitType::Tank && units.pathIndex[index] >= units.path[index].size()) {
+            events.push_back(UnitEvent{index, order++, UnitEvent::PathEnd, units.path[index][units.pathIndex[index] - 1]});
+        }
+    }
+}
+
+// Coarse time only builds up while the unit stays coarse; what is left when
+// it comes back to full detail is dropped (at most one COARSE_STEP)
+void UnitManager::classifyRange(int begin, int end, float deltaTime) {
+    for (int index = begin; index < end; ++index) {
+        const bool coarse = canRunCoarse(index);
+        units.coarse[index] = coarse ? 1 : 0;
+        units.coarseTime[index] = coarse ? units.coarseTime[index] + deltaTime : 0.0f;
+    }
+}
+
+bool UnitManager::canRunCoarse(int index) const {
+    if (!lod.isEnabled() || units.state[index] != UnitState::Moving) {
+        return false;
+    }
+    const SharedPath& path = units.path[index];
+    const std::uint32_t waypoint = units.pathIndex[index];
+    if (waypoint >= path.size() || lod.isInView(units.posX[index], units.posY[index])) {
+        return false;
+    }
+    const int next = path[waypoint];
+    return map.getGrid().getType(next) != TileType::Wall && !lod.isHot(tileUnder(index).getIndex())
+        && lod.getHotMask().isSegmentCold(map.getGrid(), segmentStart(index), next);
+}
+
+int UnitManager::segmentStart(int index) const {
+    const std::uint32_t waypoint = units.pathIndex[index];
+    return waypoint > 0 ? units.path[index][waypoint - 1] : tileUnder(index).getIndex();
+}
+
+void UnitManager::advanceCoarse(int index, float duration, std::vector<UnitEvent>& events) {
+    const SharedPath& path = units.path[index];
+    const float speed = units.speed[index];
+    float budget = speed * duration;
+    std::uint32_t order = 0;
+    bool passed = false;
+    int from = segmentStart(index);
+    while (budget > 0.0f && units.pathIndex[index] < path.size()) {
+        const int waypoint = path[units.pathIndex[index]];
+        if (map.getGrid().getType(waypoint) == TileType::Wall || !lod.getHotMask().isSegmentCold(map.getGrid(), from, waypoint)) {
+            break; // Left to the full simulation
+        }
+        const sf::Vector2f target = map.getTilePosition(waypoint);
+        const float dx = target.x - units.posX[index];
+        const float dy = target.y - units.posY[index];
+        const float distance = std::sqrt(dx * dx + dy * dy);
+        units.targetX[index] = target.x;
+        units.targetY[index] = target.y;
+        if (distance > budget) {
+            units.velX[index] = dx / distance * speed;
+            units.velY[index] = dy / distance * speed;
+            units.posX[index] += dx / distance * budget;
+            units.posY[index] += dy / distance * budget;
+            units.remaining[index] = distance - budget;
+            checkTrapsAlongSegment(index, units.remaining[index], events, order);
+            return;
+        }
+        units.posX[index] = target.x;
+        units.posY[index] = target.y;
+        units.remaining[index] = 0.0f;
+        budget -= distance;
+        passWaypoint(index, events, order);
+        passed = true;
+        from = waypoint;
+    }
+    if (passed && units.type[index] == UnitType::Tank && units.pathIndex[index] >= path.size()) {
+        events.push_back(UnitEvent{index, order++, UnitEvent::PathEnd, path[units.pathIndex[index] - 1]});
+    }
+}
+
+float UnitManager::nextInteraction(float limit) {
+    lod.rebuild(map);
+    std::fill(workerHorizon.begin(), workerHorizon.end(), std::numeric_limits<float>::infinity());
+    auto scan = [this, limit](int begin, int end, unsigned worker) {
+        float& horizon = workerHorizon[worker];
+        for (int index = begin; index < end && horizon > 0.0f; ++index) {
+            horizon = std::min(horizon, interactionTime(index, std::min(horizon, limit)));
+        }
+    };
+    if (parallel) {
+        pool.parallelFor(units.size(), UPDATE_GRAIN, scan);
+    } else {
+        scan(0, units.size(), 0);
+    }
+    return *std::min_element(workerHorizon.begin(), workerHorizon.end());
+}
+
+void UnitManager::fastForward(float duration) {
+    if (duration <= 0.0f) {
+        return;
+    }
+    for (std::vector<UnitEvent>& events : workerEvents) {
+        events.clear();
+    }
+    auto jump = [this, duration](int begin, int end, unsigned worker) {
+        for (int index = begin; index < end; ++index) {
+            if (units.state[index] == UnitState::Moving) {
+                advanceCoarse(index, duration, workerEvents[worker]);
+            }
+        }
+        FacingQuantizer::update(units.velX.data() + begin, units.velY.data() + begin, units.facing.data() + begin, end - begin);
+    };
+    if (parallel) {
+        pool.parallelFor(units.size(), UPDATE_GRAIN, jump);
+    } else {
+        jump(0, units.size(), 0);
+    }
+    applyEvents();
+}
+
+// Same walk as advanceCoarse, without moving: arrival at the last waypoint
+// before the first segment that needs the full simulation. Gives up at limit;
+// infinity for a unit that will never need the simulation again.
+float UnitManager::interactionTime(int index, float limit) const {
+    const UnitState state = units.state[index];
+    if (state == UnitState::Resting || state == UnitState::Destroyed) {
+        return std::numeric_limits<float>::infinity(); // Nothing left to happen
+    }
+    const SharedPath& path = units.path[index];
+    const std::uint32_t waypoint = units.pathIndex[index];
+    if (state == UnitState::Moving && units.type[index] == UnitType::Skeleton && waypoint >= path.size()) {
+        return std::numeric_limits<float>::infinity(); // Stranded; decideSkeleton has nothing more for it either
+    }
+    if (state != UnitState::Moving || waypoint >= path.size() || lod.isHot(tileUnder(index).getIndex())) {
+        return 0.0f;
+    }
+    return lod.getHotMask().coldWalkTime(map.getGrid(), map.getTilePositions(), path, waypoint, segmentStart(index),
+                                         sf::Vector2f(units.posX[index], units.posY[index]), units.speed[index], limit);
+}
+
+// Replays the recorded events in unit order, so the result is the same
+// however the units were split between threads
+void UnitManager::applyEvents() {
+    mergedEvents.clear();
+    for (const std::vector<UnitEvent>& events : workerEvents) {
+        mergedEvents.insert(mergedEvents.end(), events.begin(), events.end());
+    }
+    std::sort(mergedEvents.begin(), mergedEvents.end(), [](const UnitEvent& a, const UnitEvent& b) {
+        return a.unit != b.unit ? a.unit < b.unit : a.order < b.order;
+    });
+    for (const UnitEvent& event : mergedEvents) {
+        if (event.kind == UnitEvent::Trap) {
+            checkForTrap(event.unit, map.getTileAt(event.tile));
+        } else {
+            reachPathEnd(event.unit, map.getTileAt(event.tile));
+        }
+    }
+}
+
+void UnitManager::step(int begin, int end, float deltaTime) {
+    const MovementColumns columns{
+        units.stepping.data(), units.targetX.data(), units.targetY.data(), units.speed.data(),
+        units.posX.data(), units.posY.data(), units.velX.data(), units.velY.data(),
+        units.remaining.data(), units.arrived.data()
+    };
+    MovementKernel::step(columns, begin, end, deltaTime);
+}
+
+void UnitManager::decideSkeleton(int index) {
+    if (units.state[index] == UnitState::Destroyed) {
+        return;
+    }
+    if (units.state[index] == UnitState::WaitingForPath) {
+        // Hold position until the requested path arrives
+        if (!pathFinder.collectPath(units.pendingPath[index], units.path[index])) {
+            return;
+        }
+        units.pathIndex[index] = 0;
+        units.state[index] = UnitState::Moving;
+    }
+    const SharedPath& path = units.path[index];
+    if (units.state[index] != UnitState::Moving || units.pathIndex[index] >= path.size()) {
+        return;
+    }
+    const Tile currentTile = map.getTileAt(path[units.pathIndex[index]]);
+    if (currentTile.getType() == TileType::Wall) {
+        std::cout << "Skeleton encountered wall at (" << currentTile.getRow() << ", " << currentTile.getCol() << ")\n";
+        damageWall(index, currentTile);
+        recalculateSkeletonPath(index);
+        return;
+    }
+    if (map.isGoalTile(currentTile)) {
+        units.path[index].clear();
+        units.state[index] = UnitState::Resting;
+        skeletonsAtTownHall++;
+        return;
+    }
+    setWaypointTarget(index);
+    units.stepping[index] = 1;
+}
+
+void UnitManager::damageWall(int index, Tile wall) {
+    (void)index;
+    const int damage = 35;
+    wall.takeDamage(damage);
+    if (wall.getHealth() <= 0) {
+        // Leave a passable tile behind
+        wall.setType(TileType::Grass);
+        wall.setBlockStatus(false);
+        wall.setHealth(0);
+        wall.setBuilding(nullptr);
+        wall.updateTexture();
+        std::cout << "Wall destroyed by skeleton at (" << wall.getRow() << ", " << wall.getCol() << ")\n";
+    } else {
+        std::cout << "Wall at (" << wall.getRow() << ", " << wall.getCol() << ") took " << damage
+                  << " damage, remaining health: " << wall.getHealth() << ".\n";
+    }
+}
+
+void UnitManager::recalculateSkeletonPath(int index) {
+    const Tile currentTile = tileUnder(index);
+    const Tile townHallTile = map.getGoalTile();
+    if (!townHallTile) {
+        std::cerr << "Town hall tile not found.\n";
+        return;
+    }
+    // Walled in: march on the weakest wall of the fortification. Otherwise
+    // follow the shared flow field with stopBeforeWallTiles = 0 for skeletons,
+    // searching (off the update thread) only if the town hall is cut off
+    Tile breachWall;
+    SharedPath& path = units.path[index];
+    path = map.followSiegePath(currentTile, 0, breachWall);
+    if (path.empty()) {
+        path = map.followFlowField(currentTile, 0); // Skeletons stop on wall tiles
+    }
+    if (path.empty()) {
+        units.pendingPath[index] = pathFinder.requestPath(currentTile, townHallTile, 0);
+        if (units.pendingPath[index].isPending()) {
+            units.state[index] = UnitState::WaitingForPath;
+        }
+    }
+    units.pathIndex[index] = 0;
+}
+
+void UnitManager::decideTank(int index, float deltaTime) {
+    switch (units.state[index]) {
+        case UnitState::Moving:
+            break;
+        case UnitState::AttackingWall:
+            attackWall(index, deltaTime);
+            return;
+        case UnitState::RecalculatingPath:
+            recalculateTankPath(index);
+            return;
+        case UnitState::WaitingForPath:
+            waitForPath(index);
+            return;
+        case UnitState::Resting:
+        case UnitState::Destroyed:
+            return;
+    }
+
+    const SharedPath& path = units.path[index];
+    const std::uint32_t waypoint = units.pathIndex[index];
+    const Tile townHall = map.getGoalTile();
+    const TileGrid& grid = map.getGrid();
+    if (waypoint < path.size() &&
+        std::abs(grid.rowOf(path[waypoint]) - townHall.getRow()) <= 1 &&
+        std::abs(grid.colOf(path[waypoint]) - townHall.getCol()) <= 1) {
+        std::cout << "Tank reached town hall. Mission accomplished!\n";
+        units.path[index].clear();
+        units.state[index] = UnitState::Resting;
+        tanksAtTownHall++;
+        return;
+    }
+    if (waypoint >= path.size()) {
+        units.state[index] = UnitState::RecalculatingPath;
+        return;
+    }
+    setWaypointTarget(index);
+    units.stepping[index] = 1;
+}
+
+void UnitManager::reachPathEnd(int index, Tile currentTile) {
+    if (units.state[index] != UnitState::Moving) {
+        return; // Killed by a trap on the last stretch
+    }
+    // End of the path: the breach wall it was planned through, the weakest
+    // wall of a fortification, or failing both the nearest wall
+    Tile wall = units.wallTile[index] >= 0 ? map.getTileAt(units.wallTile[index]) : Tile();
+    if (!wall) {
+        wall = map.getBreachTarget(currentTile);
+    }
+    if (!wall) {
+        wall = map.findNearestWall(currentTile.getRow(), currentTile.getCol());
+    }
+    if (!wall) {
+        // Nothing left to breach: out of routes
+        units.wallTile[index] = -1;
+        units.path[index].clear();
+        units.state[index] = UnitState::Resting;
+        return;
+    }
+    units.wallTile[index] = wall.getIndex();
+    units.state[index] = UnitState::AttackingWall;
+    const Tile townHall = map.getGoalTile();
+    if (wall.getRow() == townHall.getRow() && wall.getCol() == townHall.getCol()) {
+        units.path[index].clear();
+        units.state[index] = UnitState::Resting;
+        tanksAtTownHall++;
+    }
+}
+
+void UnitManager::attackWall(int index, float deltaTime) {
+    Tile wall = units.wallTile[index] >= 0 ? map.getTileAt(units.wallTile[index]) : Tile();
+    if (wall && wall.getHealth() > 0) {
+        wall.takeDamage(0.001f * deltaTime);
+        return;
+    }
+    if (wall) {
+        wall.setBlockStatus(false); // Unblock the wall after destroying it
+    }
+    units.wallTile[index] = -1;
+    std::cout << "Wall destroyed. Recalculating path to town hall...\n";
+    units.state[index] = UnitState::RecalculatingPath;
+}
+
+void UnitManager::recalculateTankPath(int index) {
+    const SharedPath& current = units.path[index];
+    const std::uint32_t waypoint = units.pathIndex[index];
+    const Tile lastTile = waypoint > 0 && waypoint <= current.size() ? map.getTileAt(current[waypoint - 1]) : tileUnder(index);
+    Tile wall;
+    SharedPath path = map.followSiegePath(lastTile, 2, wall);
+    if (path.empty()) {
+        path = map.followBreachPath(lastTile, 2, wall);
+    }
+    units.path[index] = std::move(path);
+    units.wallTile[index] = wall ? wall.getIndex() : -1;
+    units.pathIndex[index] = 0;
+    if (units.path[index].empty()) {
+        // No route even through walls: search off the update thread
+        units.pendingPath[index] = pathFinder.requestPath(lastTile, map.getGoalTile(), 2);
+        units.state[index] = UnitState::WaitingForPath;
+        return;
+    }
+    units.state[index] = UnitState::Moving;
+}
+
+void UnitManager::waitForPath(int index) {
+    if (!units.pendingPath[index].isPending()) {
+        units.state[index] = UnitState::Resting; // Nothing was requested (invalid tile)
+        return;
+    }
+    if (pathFinder.collectPath(units.pendingPath[index], units.path[index])) {
+        units.pathIndex[index] = 0;
+        units.state[index] = units.path[index].empty() ? UnitState::Resting : UnitState::Moving;
+    }
+}
+
+void UnitManager::setWaypointTarget(int index) {
+    const sf::Vector2f target = map.getTilePosition(units.path[index][units.pathIndex[index]]);
+    units.targetX[index] = target.x;
+    units.targetY[index] = target.y;
+}
+
+Tile UnitManager::tileUnder(int index) const {
+    TileCoordinates coords = IsometricUtils::screenToTile(units.posX[index], units.posY[index], map.getRows(), map.getCols());
+    if (coords.row >= map.getRows()) {
+        coords.row--;
+    }
+    if (coords.col >= map.getCols()) {
+        coords.col--;
+    }
+    return map.getTile(coords.row, coords.col);
+}
+
+void UnitManager::checkForTrap(int index, Tile tile) {
+    if (tile.getTrap() && tile.getTrap()->isActive()) {
+        std::cout << (units.type[index] == UnitType::Tank ? "Tank" : "Skeleton") << " triggered a trap at ("
+                  << tile.getRow() << ", " << tile.getCol() << ").\n";
+        takeDamage(index, tile.getTrap()->getDamage());
+        tile.getTrap()->trigger();
+    }
+}
+
+void UnitManager::checkTrapsAlongSegment(int index, float remainingDistance, std::vector<UnitEvent>& events, std::uint32_t& order) {
+    const SharedPath& path = units.path[index];
+    const std::uint32_t waypoint = units.pathIndex[index];
+    UnitSegment& segment = units.segment[index];
+    const int to = path[waypoint];
+    const int from = waypoint > 0 ? path[waypoint - 1] : to;
+    if (from != segment.from || to != segment.to) {
+        segment.walker.reset(map.getGrid(), from, to);
+        segment.from = from;
+        segment.to = to;
+        sf::Vector2f span = map.getTilePosition(to) - map.getTilePosition(from);
+        segment.length = std::sqrt(span.x * span.x + span.y * span.y);
+    }
+    const float progress = segment.length > 0.0f ? 1.0f - remainingDistance / segment.length : 1.0f;
+    for (int tile = segment.walker.advance(progress); tile >= 0; tile = segment.walker.advance(progress)) {
+        if (map.getTileAt(tile).hasTrap()) {
+            events.push_back(UnitEvent{index, order++, UnitEvent::Trap, tile});
+        }
+    }
+}
+
+// After the step: traps crossed on the way, and on arrival the next waypoint
+void UnitManager::finishWaypoint(int index, std::vector<UnitEvent>& events, std::uint32_t& order) {
+    if (!units.arrived[index]) {
+        checkTrapsAlongSegment(index, units.remaining[index], events, order);
+        return;
+    }
+    passWaypoint(index, events, order);
+}
+
+void UnitManager::passWaypoint(int index, std::vector<UnitEvent>& events, std::uint32_t& order) {
+    checkTrapsAlongSegment(index, 0.0f, events, order);
+    const int start = units.path[index][0];
+    if (units.pathIndex[index] == 0 && map.getTileAt(start).hasTrap()) {
+        // The starting tile is not entered along a segment
+        events.push_back(UnitEvent{index, order++, UnitEvent::Trap, start});
+    }
+    units.pathIndex[index]++;
+}
+
+void UnitManager::takeDamage(int index, int damage) {
+    if (units.state[index] == UnitState::Destroyed) {
+        return;
+    }
+    const bool tank = units.type[index] == UnitType::Tank;
+    units.health[index] -= damage;
+    if (units.health[index] <= 0) {
+        units.health[index] = 0;
+        if (tank) {
+            std::cout << "Tank destroyed.\n";
+            effects.spawnExplosion(units.posX[index], units.posY[index]);
+        } else {
+            std::cout << "Skeleton destroyed at position (" << units.posX[index] << ", " << units.posY[index] << ").\n";
+        }
+        units.state[index] = UnitState::Destroyed;
+        units.stepping[index] = 0;
+    } else if (tank) {
+        std::cout << "Tank took " << damage << " damage. Health is now " << units.health[index] << ".\n";
+    } else {
+        std::cout << "Skeleton took " << damage << " damage, remaining health: " << units.health[index] << ".\n";
+    }
+}
+
+bool UnitManager::isAlive(int index) const {
+    return units.health[index] > 0;
+}
+
+sf::FloatRect UnitManager::getBounds(int index) const {
+    const float x = units.posX[index];
+    const float y = units.posY[index];
+    if (units.type[index] == UnitType::Tank) {
+        // Anchored at the bottom centre
+        return sf::FloatRect(x - TANK_WIDTH / 2.0f, y - TANK_HEIGHT, static_cast<float>(TANK_WIDTH), static_cast<float>(TANK_HEIGHT));
+    }
+    return sf::FloatRect(x - 32.0f, y - 32.0f, 64.0f, 64.0f);
+}
+
+void UnitManager::removeDead() {
+    units.compact();
+}
+
+const UnitStore& UnitManager::getUnits() const {
+    return units;
+}
+
+void UnitManager::draw(sf::RenderWindow& window) {
+    const sf::View& view = window.getView();
+    const sf::FloatRect visible(view.getCenter() - view.getSize() / 2.0f, view.getSize());
+    const int count = units.size();
+    for (int index = 0; index < count; ++index) {
+        const sf::Vector2f position(units.posX[index], units.posY[index]);
+        if (units.state[index] == UnitState::Destroyed || !visible.intersects(getBounds(index))) {
+            continue;
+        }
+        const Facing facing = units.facing[index];
+        const sf::Texture* texture = nullptr;
+        sf::Sprite* sprite = &tankSprite;
+        if (units.type[index] == UnitType::Skeleton) {
+            texture = skeletonAnimation.frame(facing, units.animationFrame[index]);
+            sprite = &skeletonSprite;
+        } else {
+            texture = tankAnimation.frame(facing, 0);
+        }
+        if (texture) {
+            sprite->setTexture(*texture); // Keeps the archetype's texture rect
+        }
+        sprite->setPosition(position);
+        window.draw(*sprite);
+    }
+}
@@ -0,0 +1,159 @@
+#ifndef UNITMANAGER_HPP
+#define UNITMANAGER_HPP
+
+#include <SFML/Graphics.hpp>
+#include "AnimationLibrary.hpp"
+#include "EffectSystem.hpp"
+#include "Map.hpp"
+#include "Pathfinding.hpp"
+#include "SimulationLod.hpp"
+#include "UnitStore.hpp"
+#include "WorkStealingPool.hpp"
+
+// Shared-state consequence of a unit's step, recorded by the parallel pass
+// and applied afterwards in (unit, order) order
+struct UnitEvent {
+    enum Kind : std::uint8_t {
+        Trap,   // Entered a tile with a trap
+        PathEnd // Tank walked off the end of its path
+    };
+
+    int unit;
+    std::uint32_t order; // Position among the unit's events this tick
+    Kind kind;
+    int tile;
+};
+
+// Runs every skeleton and tank over one UnitStore. update() works in passes:
+// per-unit decisions that read the map (walls, the town hall, new paths), one
+// movement step over the contiguous columns for every walking unit, then the
+// consequences of the step (traps, reaching a waypoint). draw() is a separate
+// pass that turns the columns into sprites; units hold no textures of their
+// own, one sprite per archetype is retextured and drawn for each of them.
+//
+// Movement, facing, animation and the trap sweep touch only the unit's own
+// columns and run in chunks on a WorkStealingPool. What they would change
+// outside the unit (triggering a trap, a tank picking a wall to attack) is
+// put in a per-thread event buffer instead; the buffers are merged and
+// applied in unit order on the update thread, so a parallel update gives
+// bit-for-bit the result of the serial one.
+//
+// With level of detail on, units off screen and away from towers, traps and
+// the town hall skip all of that: they are walked along their path in
+// SimulationLod::COARSE_STEP steps, without animation, until the next
+// waypoint is a wall or the segment to it crosses a hot tile. Coarse units are not bit-identical to a
+// full simulation, only equivalent in the route they take.
+class UnitManager {
+public:
+    // Dying tanks leave their explosion with effects
+    UnitManager(const Map& map, EffectSystem& effects, int capacity = UnitStore::DEFAULT_CAPACITY);
+
+    // All return an empty handle when the store is full. An empty path makes
+    // the skeleton request one itself.
+    UnitHandle spawnSkeleton(float x, float y, const SharedPath& path);
+    UnitHandle spawnTank(float x, float y);
+    // With a path planned by the caller, e.g. shared across a batch; wallTile
+    // is the tile index of the wall it leads to, or -1
+    UnitHandle spawnTank(float x, float y, const SharedPath& path, int wallTile);
+
+    void update(float deltaTime);
+    void draw(sf::RenderWindow& window);
+
+    // Serial runs the per-unit pass on the calling thread; results are identical
+    void setParallel(bool enabled);
+    bool isParallel() const;
+
+    void setLevelOfDetail(bool enabled);
+    bool isLevelOfDetail() const;
+    // World rectangle the camera shows; units inside always run at full detail
+    void setView(const sf::FloatRect& view);
+    // Units advanced coarsely in the last update
+    int getCoarseCount() const;
+    bool isCoarse(int index) const;
+
+    // Event-driven fast-forward. Time until the first unit reaches something
+    // that needs the frame-by-frame simulation: a wall, the end of its path,
+    // or a hot tile (near a tower, a trap or the town hall). Waypoints on
+    // cold tiles are walked analytically and do not count. Units that are
+    // waiting, attacking or otherwise busy make it 0; at most limit, or
+    // infinity if no unit has anything left to do (resting, dead, stranded).
+    float nextInteraction(float limit);
+    // Walks every walking unit duration ahead along its path in one go,
+    // triggering traps crossed on the way. duration must not exceed
+    // nextInteraction; MapScreen advances the other systems alongside.
+    void fastForward(float duration);
+
+    void takeDamage(int index, int damage);
+    bool isAlive(int index) const;
+    // Area a bullet has to touch to hit the unit
+    sf::FloatRect getBounds(int index) const;
+    // End of tick: frees the slots of every unit that died during it. Until
+    // then dead units keep their dense index (and are skipped).
+    void removeDead();
+
+    const UnitStore& getUnits() const;
+
+private:
+    static constexpr float SKELETON_SPEED = 70.0f;
+    static constexpr float TANK_SPEED = 100.0f;
+    static const int SKELETON_HEALTH = 10;
+    static const int TANK_HEALTH = 100;
+    static const int TANK_WIDTH = 64;
+    static const int TANK_HEIGHT = 64;
+    static const int UPDATE_GRAIN = 512; // Units per chunk of the parallel pass
+
+    const Map& map;
+    EffectSystem& effects;
+    Pathfinding pathFinder; // Shared by every unit; requests carry their own state
+    UnitStore units;
+    const AnimationSet& skeletonAnimation;
+    const AnimationSet& tankAnimation;
+    sf::Sprite skeletonSprite;
+    sf::Sprite tankSprite;
+
+    bool parallel;
+    WorkStealingPool pool;
+    std::vector<std::vector<UnitEvent>> workerEvents; // Indexed by pool worker
+    std::vector<UnitEvent> mergedEvents;
+    SimulationLod lod;
+    int coarseCount;
+    std::vector<float> workerHorizon; // Per-worker minimum of nextInteraction
+
+    // Movement step for the units in [begin, end) with stepping set, on the
+    // widest MovementKernel the CPU has
+    void step(int begin, int end, float deltaTime);
+    void advanceRange(int begin, int end, float deltaTime, std::vector<UnitEvent>& events);
+    void classifyRange(int begin, int end, float deltaTime);
+    float interactionTime(int index, float limit) const;
+    bool canRunCoarse(int index) const;
+    // Tile the segment the unit is on starts from: its last waypoint, or the
+    // tile under it before the first
+    int segmentStart(int index) const;
+    // Walks the unit up to speed * duration along its path, stopping at the
+    // last waypoint before a segment that needs the full simulation
+    void advanceCoarse(int index, float duration, std::vector<UnitEvent>& events);
+    void applyEvents();
+
+    void decideSkeleton(int index);
+    void damageWall(int index, Tile wall);
+    void recalculateSkeletonPath(int index);
+
+    void decideTank(int index, float deltaTime);
+    // Picks the wall to attack, or rests at the town hall
+    void reachPathEnd(int index, Tile currentTile);
+    void attackWall(int index, float deltaTime);
+    void recalculateTankPath(int index);
+    void waitForPath(int index);
+
+    void setWaypointTarget(int index);
+    Tile tileUnder(int index) const;
+    void checkForTrap(int index, Tile tile);
+    // Records the trap tiles entered so far on the way to the current
+    // waypoint; with smoothed paths a segment can cross several tiles
+    void checkTrapsAlongSegment(int index, float remainingDistance, std::vector<UnitEvent>& events, std::uint32_t& order);
+    void finishWaypoint(int index, std::vector<UnitEvent>& events, std::uint32_t& order);
+    void passWaypoint(int index, std::vector<UnitEvent>& events, std::uint32_t& order);
+
+};
+
+#endif // UNITMANAGER_HPP
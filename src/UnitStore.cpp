@@ -0,0 +1,180 @@
+// UnitStore.cpp
+#include "UnitStore.hpp"
+#include <utility>
+
+UnitStore::UnitStore(int capacity) : capacity(capacity) {
+    type.reserve(capacity);
+    state.reserve(capacity);
+    posX.reserve(capacity);
+    posY.reserve(capacity);
+    velX.reserve(capacity);
+    velY.reserve(capacity);
+    facing.reserve(capacity);
+    speed.reserve(capacity);
+    targetX.reserve(capacity);
+    targetY.reserve(capacity);
+    stepping.reserve(capacity);
+    arrived.reserve(capacity);
+    remaining.reserve(capacity);
+    health.reserve(capacity);
+    path.reserve(capacity);
+    pathIndex.reserve(capacity);
+    coarse.reserve(capacity);
+    coarseTime.reserve(capacity);
+    wallTile.reserve(capacity);
+    pendingPath.reserve(capacity);
+    segment.reserve(capacity);
+    animationTime.reserve(capacity);
+    animationFrame.reserve(capacity);
+
+    slotIndex.assign(capacity, -1);
+    slotGeneration.assign(capacity, 0);
+    denseSlot.reserve(capacity);
+    freeSlots.reserve(capacity);
+    for (int slot = capacity - 1; slot >= 0; --slot) {
+        freeSlots.push_back(static_cast<std::uint32_t>(slot)); // Lowest slot handed out first
+    }
+}
+
+UnitHandle UnitStore::add(UnitType unitType, float x, float y, float unitSpeed, int unitHealth) {
+    if (freeSlots.empty()) {
+        return UnitHandle();
+    }
+    const int index = size();
+    type.push_back(unitType);
+    state.push_back(UnitState::Moving);
+    posX.push_back(x);
+    posY.push_back(y);
+    velX.push_back(0.0f);
+    velY.push_back(0.0f);
+    facing.push_back(Facing::Left);
+    speed.push_back(unitSpeed);
+    targetX.push_back(x);
+    targetY.push_back(y);
+    stepping.push_back(0);
+    arrived.push_back(0);
+    remaining.push_back(0.0f);
+    health.push_back(unitHealth);
+    path.emplace_back();
+    pathIndex.push_back(0);
+    coarse.push_back(0);
+    coarseTime.push_back(0.0f);
+    wallTile.push_back(-1);
+    pendingPath.emplace_back();
+    segment.emplace_back();
+    animationTime.push_back(0.0f);
+    animationFrame.push_back(0);
+
+    UnitHandle handle;
+    handle.slot = freeSlots.back();
+    handle.generation = slotGeneration[handle.slot];
+    freeSlots.pop_back();
+    slotIndex[handle.slot] = index;
+    denseSlot.push_back(handle.slot);
+    return handle;
+}
+
+void UnitStore::remove(UnitHandle handle) {
+    const int index = indexOf(handle);
+    if (index >= 0) {
+        removeAt(index);
+    }
+}
+
+void UnitStore::compact() {
+    int index = 0;
+    while (index < size()) {
+        if (state[index] == UnitState::Destroyed) {
+            removeAt(index); // The last unit moves in here; look at it next
+        } else {
+            ++index;
+        }
+    }
+}
+
+void UnitStore::clear() {
+    while (size() > 0) {
+        removeAt(size() - 1);
+    }
+}
+
+int UnitStore::indexOf(UnitHandle handle) const {
+    if (handle.slot >= slotIndex.size() || slotGeneration[handle.slot] != handle.generation) {
+        return -1;
+    }
+    return slotIndex[handle.slot];
+}
+
+UnitHandle UnitStore::handleAt(int index) const {
+    UnitHandle handle;
+    handle.slot = denseSlot[index];
+    handle.generation = slotGeneration[handle.slot];
+    return handle;
+}
+
+void UnitStore::removeAt(int index) {
+    const std::uint32_t slot = denseSlot[index];
+    const int last = size() - 1;
+    if (index != last) {
+        moveUnit(last, index);
+        slotIndex[denseSlot[last]] = index;
+        denseSlot[index] = denseSlot[last];
+    }
+    slotIndex[slot] = -1;
+    slotGeneration[slot]++;
+    freeSlots.push_back(slot);
+    popUnit();
+    denseSlot.pop_back();
+}
+
+void UnitStore::moveUnit(int from, int to) {
+    type[to] = type[from];
+    state[to] = state[from];
+    posX[to] = posX[from];
+    posY[to] = posY[from];
+    velX[to] = velX[from];
+    velY[to] = velY[from];
+    facing[to] = facing[from];
+    speed[to] = speed[from];
+    targetX[to] = targetX[from];
+    targetY[to] = targetY[from];
+    stepping[to] = stepping[from];
+    arrived[to] = arrived[from];
+    remaining[to] = remaining[from];
+    health[to] = health[from];
+    path[to] = std::move(path[from]);
+    pathIndex[to] = pathIndex[from];
+    coarse[to] = coarse[from];
+    coarseTime[to] = coarseTime[from];
+    wallTile[to] = wallTile[from];
+    pendingPath[to] = std::move(pendingPath[from]);
+    segment[to] = segment[from];
+    animationTime[to] = animationTime[from];
+    animationFrame[to] = animationFrame[from];
+}
+
+void UnitStore::popUnit() {
+    type.pop_back();
+    state.pop_back();
+    posX.pop_back();
+    posY.pop_back();
+    velX.pop_back();
+    velY.pop_back();
+    facing.pop_back();
+    speed.pop_back();
+    targetX.pop_back();
+    targetY.pop_back();
+    stepping.pop_back();
+    arrived.pop_back();
+    remaining.pop_back();
+    health.pop_back();
+    path.pop_back();
+    pathIndex.pop_back();
+    coarse.pop_back();
+    coarseTime.pop_back();
+    wallTile.pop_back();
+    pendingPath.pop_back();
+    segment.pop_back();
+    animationTime.pop_back();
+    animationFrame.pop_back();
+}
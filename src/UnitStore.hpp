@@ -0,0 +1,117 @@
+#ifndef UNITSTORE_HPP
+#define UNITSTORE_HPP
+
+#include <cstdint>
+#include <vector>
+#include "Facing.hpp"
+#include "PathArena.hpp"
+#include "PathRequestService.hpp"
+#include "PathSmoothing.hpp"
+
+enum class UnitType : std::uint8_t {
+    Skeleton,
+    Tank
+};
+
+enum class UnitState : std::uint8_t {
+    Moving,
+    AttackingWall,
+    RecalculatingPath,
+    WaitingForPath, // Holding position until a requested path arrives
+    Resting,        // At the town hall, or out of routes
+    Destroyed       // Dead, removed by the next compact()
+};
+
+// Reference to a unit that stays valid while other units are added and
+// removed. Slots are reused; the generation tells a handle to a removed unit
+// apart from one to the slot's next occupant, so stale handles resolve to
+// nothing instead of to a stranger.
+struct UnitHandle {
+    static const std::uint32_t NONE = 0xFFFFFFFFu;
+
+    std::uint32_t slot = NONE;
+    std::uint32_t generation = 0;
+
+    explicit operator bool() const { return slot != NONE; }
+    bool operator==(const UnitHandle& other) const { return slot == other.slot && generation == other.generation; }
+    bool operator!=(const UnitHandle& other) const { return !(*this == other); }
+};
+
+// Trap checks along the segment a unit is walking (see SegmentWalker)
+struct UnitSegment {
+    SegmentWalker walker;
+    int from = -1;
+    int to = -1;
+    float length = 0.0f;
+};
+
+// Dense structure-of-arrays store for every enemy unit, skeletons and tanks
+// alike. Each column is indexed by the unit's dense index, 0 to size() - 1;
+// removing a unit moves the last one into its place, so the columns stay
+// contiguous and the update loops run over them without gaps. Handles map to
+// dense indices through a slot table. Like TileGrid it has no SFML
+// dependency; sprites live with the render pass in UnitManager.
+//
+// Capacity is fixed at construction and every column and the slot free list
+// are allocated up front, so adding and removing units never touches the
+// heap. Dying only marks a unit Destroyed; compact() removes the dead at the
+// end of a tick, so dense indices hold still while a tick runs.
+class UnitStore {
+public:
+    static const int DEFAULT_CAPACITY = 4096;
+
+    explicit UnitStore(int capacity = DEFAULT_CAPACITY);
+
+    // Empty handle if the store is full
+    UnitHandle add(UnitType type, float x, float y, float speed, int health);
+    void remove(UnitHandle handle);
+    // Removes every Destroyed unit
+    void compact();
+    void clear();
+
+    int size() const { return static_cast<int>(type.size()); }
+    int getCapacity() const { return capacity; }
+    // Dense index of the unit, or -1 if it has been removed
+    int indexOf(UnitHandle handle) const;
+    UnitHandle handleAt(int index) const;
+
+    // Read by the movement loop every frame
+    std::vector<UnitType> type;
+    std::vector<UnitState> state;
+    std::vector<float> posX;
+    std::vector<float> posY;
+    std::vector<float> velX; // Velocity of the last step, in pixels per second
+    std::vector<float> velY;
+    std::vector<Facing> facing; // Sprite direction, kept while standing still
+    std::vector<float> speed;
+    std::vector<float> targetX; // Screen position of the current waypoint
+    std::vector<float> targetY;
+    std::vector<std::uint8_t> stepping; // Set for units that walk this frame
+    std::vector<std::uint8_t> arrived;  // Written by the step: within 1px of the waypoint
+    std::vector<float> remaining;       // Written by the step: distance left to the waypoint
+    std::vector<int> health;
+    std::vector<SharedPath> path;
+    std::vector<std::uint32_t> pathIndex; // Current waypoint
+    std::vector<std::uint8_t> coarse;      // Simulated at low detail this tick (see SimulationLod)
+    std::vector<float> coarseTime;         // Time gathered for the next coarse advance
+
+    // Touched only on events
+    std::vector<int> wallTile; // Tile index of the wall being attacked, or -1
+    std::vector<PathTicket> pendingPath;
+    std::vector<UnitSegment> segment;
+    std::vector<float> animationTime;
+    std::vector<std::uint8_t> animationFrame;
+
+private:
+    int capacity;
+    std::vector<int> slotIndex;                 // Per slot: dense index, or -1 when free
+    std::vector<std::uint32_t> slotGeneration;  // Per slot: bumped on every removal
+    std::vector<std::uint32_t> denseSlot;       // Per dense index: its slot
+    std::vector<std::uint32_t> freeSlots;
+
+    void removeAt(int index);
+    void moveUnit(int from, int to);
+    void popUnit();
+};
+
+#endif // UNITSTORE_HPP
@@ -0,0 +1,158 @@
+// UnitStoreTests.cpp
+// Headless checks for UnitStore handles and capacity, and for the PathArena
+// their paths live in. Waves of units are added, partly killed and
+// compacted, then removed, and every handle is resolved along the way.
+// Global operator new is replaced to count heap allocations, which the waves
+// must not make. Built and run by `make test`; exits non-zero if any check
+// fails.
+//   --waves N     waves to run (default 50)
+#include "PathArena.hpp"
+#include "UnitStore.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+
+static long allocations = 0;
+
+void* operator new(std::size_t size) {
+    ++allocations;
+    if (void* block = std::malloc(size == 0 ? 1 : size)) {
+        return block;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* block) noexcept {
+    std::free(block);
+}
+
+void operator delete(void* block, std::size_t) noexcept {
+    std::free(block);
+}
+
+static int failures = 0;
+
+// Takes plain strings, so that passing checks allocate nothing
+static void check(bool condition, const char* test, int round, const char* detail) {
+    if (!condition) {
+        ++failures;
+        std::printf("FAIL %s: round %d: %s\n", test, round, detail);
+    }
+}
+
+// Each wave adds units up to most of the capacity, kills every third one
+// and compacts, then removes the rest by handle. Handles to the dead and
+// to the removed must resolve to nothing, even once their slots are reused;
+// the others must still find their own unit.
+static void testWaves(int waves) {
+    const int capacity = 1000;
+    const int perWave = 900;
+    UnitStore store(capacity);
+    std::vector<UnitHandle> handles;
+    std::vector<UnitHandle> previous;
+    handles.reserve(perWave);
+    previous.reserve(perWave);
+    const long before = allocations;
+    for (int wave = 0; wave < waves; ++wave) {
+        handles.clear();
+        for (int unit = 0; unit < perWave; ++unit) {
+            const UnitType type = unit % 2 ? UnitType::Tank : UnitType::Skeleton;
+            handles.push_back(store.add(type, static_cast<float>(unit), 0.0f, 1.0f, 10));
+        }
+        for (const UnitHandle& stale : previous) {
+            check(store.indexOf(stale) < 0, "unitstore", wave, "a handle from the last wave resolves");
+        }
+        for (int unit = 0; unit < perWave; unit += 3) {
+            store.state[store.indexOf(handles[unit])] = UnitState::Destroyed;
+        }
+        store.compact();
+        check(store.size() == perWave - (perWave + 2) / 3, "unitstore", wave, "compact left the wrong count");
+        for (int unit = 0; unit < perWave; ++unit) {
+            const int index = store.indexOf(handles[unit]);
+            if (unit % 3 == 0) {
+                check(index < 0, "unitstore", wave, "a dead unit still resolves");
+            } else {
+                check(index >= 0 && store.posX[index] == static_cast<float>(unit) && store.handleAt(index) == handles[unit],
+                      "unitstore", wave, "a live unit was lost by compact");
+            }
+        }
+        for (const UnitHandle& handle : handles) {
+            store.remove(handle);
+        }
+        check(store.size() == 0, "unitstore", wave, "units left after removing all");
+        previous.swap(handles);
+    }
+    if (allocations != before) {
+        ++failures;
+        std::printf("FAIL unitstore: %ld heap allocation(s) during the waves\n", allocations - before);
+    }
+
+    for (int unit = 0; unit < capacity; ++unit) {
+        check(static_cast<bool>(store.add(UnitType::Tank, 0.0f, 0.0f, 1.0f, 1)), "unitstore", waves, "add failed below capacity");
+    }
+    check(!store.add(UnitType::Tank, 0.0f, 0.0f, 1.0f, 1), "unitstore", waves, "a full store accepted another unit");
+}
+
+// Every round all paths are replaced, as when the map changes and units get
+// new routes, while copies of half of the old ones are kept, as by units
+// still walking them. A kept copy must read its own path even after the
+// arena has compacted around it, identical paths must share storage, and
+// released space must be reused rather than the pool growing every round.
+static void testPathArena(int rounds) {
+    const int paths = 100;
+    const int length = 100; // 10000 tiles in all, enough to compact
+    PathArena arena;
+    std::vector<SharedPath> current(paths);
+    std::vector<SharedPath> kept;
+    std::vector<int> tiles(length);
+    auto fill = [&tiles, paths, length](int round, int path) {
+        for (int i = 0; i < length; ++i) {
+            tiles[i] = (round * paths + path) * length + i;
+        }
+    };
+    for (int round = 0; round < rounds; ++round) {
+        kept.assign(current.begin(), current.begin() + paths / 2);
+        for (int path = 0; path < paths; ++path) {
+            fill(round, path);
+            current[path] = arena.intern(tiles);
+        }
+        for (int path = 0; path < paths / 2 && round > 0; ++path) {
+            fill(round - 1, path);
+            bool same = kept[path].size() == tiles.size();
+            for (int i = 0; same && i < length; ++i) {
+                same = kept[path][i] == tiles[i];
+            }
+            check(same, "patharena", round, "a kept path changed after it was replaced");
+        }
+        const size_t distinct = arena.getPathCount();
+        fill(round, 0);
+        const SharedPath again = arena.intern(tiles);
+        check(arena.getPathCount() == distinct && again.size() == tiles.size() && again[0] == current[0][0],
+              "patharena", round, "an identical path was stored twice");
+
+        kept.clear();
+        check(arena.getPathCount() == static_cast<size_t>(paths), "patharena", round, "released paths are still held");
+        check(arena.getStoredTiles() <= static_cast<size_t>(2 * paths * length), "patharena", round,
+              "released space was not reused");
+    }
+}
+
+int main(int argc, char** argv) {
+    int waves = 50;
+    for (int i = 1; i < argc; ++i) {
+        const std::string option = argv[i];
+        if (option == "--waves" && i + 1 < argc) {
+            waves = std::atoi(argv[++i]);
+        } else {
+            std::fprintf(stderr, "usage: storetests [--waves N]\n");
+            return 1;
+        }
+    }
+    testWaves(waves);
+    testPathArena(waves);
+
+    std::printf("%s: %d failure(s)\n", failures == 0 ? "PASS" : "FAIL", failures);
+    return failures == 0 ? 0 : 1;
+}
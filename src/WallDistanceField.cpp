@@ -0,0 +1,108 @@
+// WallDistanceField.cpp
+#include "WallDistanceField.hpp"
+#include "GridConnectivity.hpp"
+#include <algorithm>
+#include <functional>
+
+WallDistanceField::WallDistanceField() {}
+
+// Closer wins; at equal distance the lower tile index does
+bool WallDistanceField::improves(int index, int newDistance, int newNearest) const {
+    return nearest[index] < 0 || newDistance < distance[index] ||
+           (newDistance == distance[index] && newNearest < nearest[index]);
+}
+
+void WallDistanceField::pushOpen(int dist, int wall, int index) {
+    open.emplace_back(dist, wall, index);
+    std::push_heap(open.begin(), open.end(), std::greater<QueueEntry>());
+}
+
+void WallDistanceField::propagate(const TileGrid& grid) {
+    while (!open.empty()) {
+        std::pop_heap(open.begin(), open.end(), std::greater<QueueEntry>());
+        const int dist = std::get<0>(open.back());
+        const int wall = std::get<1>(open.back());
+        const int current = std::get<2>(open.back());
+        open.pop_back();
+        if (dist != distance[current] || wall != nearest[current]) {
+            continue; // Stale entry
+        }
+        forEachNeighbor<FourWayConnectivity>(grid, current, [&](int neighbor, int) {
+            if (improves(neighbor, dist + 1, wall)) {
+                distance[neighbor] = dist + 1;
+                nearest[neighbor] = wall;
+                pushOpen(dist + 1, wall, neighbor);
+            }
+        });
+    }
+}
+
+void WallDistanceField::build(const TileGrid& grid) {
+    distance.assign(grid.size(), -1);
+    nearest.assign(grid.size(), -1);
+    source.assign(grid.size(), 0);
+    open.clear();
+    for (int index = 0; index < grid.size(); ++index) {
+        if (grid.isBlocked(index)) {
+            source[index] = 1;
+            distance[index] = 0;
+            nearest[index] = index;
+            pushOpen(0, index, index);
+        }
+    }
+    propagate(grid);
+}
+
+void WallDistanceField::applyChanges(const TileGrid& grid, const std::vector<int>& changedTiles) {
+    if (distance.size() != static_cast<size_t>(grid.size())) {
+        build(grid);
+        return;
+    }
+
+    cleared.clear();
+    for (int tile : changedTiles) {
+        const unsigned char blocked = grid.isBlocked(tile) ? 1 : 0;
+        if (blocked == source[tile]) {
+            continue; // Type-only change
+        }
+        source[tile] = blocked;
+        if (blocked) {
+            distance[tile] = 0;
+            nearest[tile] = tile;
+            pushOpen(0, tile, tile);
+            continue;
+        }
+        // Forget every tile that took its answer from this one; they form a
+        // connected patch around it
+        const size_t first = cleared.size();
+        cleared.push_back(tile);
+        distance[tile] = -1;
+        nearest[tile] = -1;
+        for (size_t i = first; i < cleared.size(); ++i) {
+            forEachNeighbor<FourWayConnectivity>(grid, cleared[i], [&](int neighbor, int) {
+                if (nearest[neighbor] == tile) {
+                    distance[neighbor] = -1;
+                    nearest[neighbor] = -1;
+                    cleared.push_back(neighbor);
+                }
+            });
+        }
+    }
+
+    // Refill the cleared patches from the valid tiles around them
+    for (int tile : cleared) {
+        if (nearest[tile] == tile) {
+            continue; // Blocked again later in the same batch
+        }
+        forEachNeighbor<FourWayConnectivity>(grid, tile, [&](int neighbor, int) {
+            if (nearest[neighbor] >= 0 && improves(tile, distance[neighbor] + 1, nearest[neighbor])) {
+                distance[tile] = distance[neighbor] + 1;
+                nearest[tile] = nearest[neighbor];
+            }
+        });
+        if (nearest[tile] >= 0) {
+            pushOpen(distance[tile], nearest[tile], tile);
+        }
+    }
+    propagate(grid);
+}
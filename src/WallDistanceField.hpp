@@ -0,0 +1,42 @@
+#ifndef WALLDISTANCEFIELD_HPP
+#define WALLDISTANCEFIELD_HPP
+
+#include <tuple>
+#include <vector>
+#include "TileGrid.hpp"
+
+// Distance from every tile to its nearest blocked tile (walls, towers, the
+// town hall), counted in four-way steps that may pass over anything, as the
+// BFS in Map::findNearestWall did. Each tile also stores which blocked tile
+// that is; ties go to the lowest tile index, so the field depends only on the
+// grid and an incremental repair gives the same answer as a rebuild.
+class WallDistanceField {
+public:
+    WallDistanceField();
+
+    void build(const TileGrid& grid);
+    // Repairs the tiles whose nearest blocked tile is affected by the given
+    // changes: new blocked tiles spread outward until they stop winning, and
+    // the area owned by a cleared one is refilled from its borders
+    void applyChanges(const TileGrid& grid, const std::vector<int>& changedTiles);
+
+    // Nearest blocked tile to index, or -1 if nothing on the grid is blocked
+    int getNearestWall(int index) const { return nearest[index]; }
+    // Steps to that tile (0 on a blocked tile), or -1 if there is none
+    int getDistance(int index) const { return distance[index]; }
+
+private:
+    using QueueEntry = std::tuple<int, int, int>; // (distance, nearest, tile)
+
+    std::vector<int> distance;
+    std::vector<int> nearest;
+    std::vector<unsigned char> source; // Block status the field was built with
+    std::vector<int> cleared;          // Scratch for applyChanges
+    std::vector<QueueEntry> open;      // Min-heap
+
+    bool improves(int index, int newDistance, int newNearest) const;
+    void pushOpen(int dist, int wall, int index);
+    void propagate(const TileGrid& grid);
+};
+
+#endif // WALLDISTANCEFIELD_HPP
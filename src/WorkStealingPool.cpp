@@ -0,0 +1,115 @@
+// WorkStealingPool.cpp
+#include "WorkStealingPool.hpp"
+#include <algorithm>
+
+WorkStealingPool::WorkStealingPool(unsigned threadCount)
+    : threadCount(threadCount), job(0), busy(0), stopping(false),
+      function(nullptr), context(nullptr), count(0), grain(1) {
+    if (this->threadCount == 0) {
+        unsigned hardware = std::thread::hardware_concurrency();
+        this->threadCount = std::min(8u, std::max(1u, hardware > 1 ? hardware - 1 : 1u));
+    }
+    runs.reset(new Run[this->threadCount]);
+    for (unsigned worker = 1; worker < this->threadCount; ++worker) {
+        threads.emplace_back(&WorkStealingPool::threadLoop, this, worker);
+    }
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+unsigned WorkStealingPool::getThreadCount() const {
+    return threadCount;
+}
+
+void WorkStealingPool::run(int count, int grain, ChunkFunction function, void* context) {
+    if (count <= 0) {
+        return;
+    }
+    grain = std::max(1, grain);
+    if (threadCount == 1 || count <= grain) {
+        for (int begin = 0; begin < count; begin += grain) {
+            function(context, begin, std::min(count, begin + grain), 0);
+        }
+        return;
+    }
+
+    // Deal each worker a contiguous share of the chunks
+    const int chunks = (count + grain - 1) / grain;
+    for (unsigned worker = 0; worker < threadCount; ++worker) {
+        std::lock_guard<std::mutex> lock(runs[worker].mutex);
+        runs[worker].front = static_cast<int>(static_cast<std::int64_t>(chunks) * worker / threadCount);
+        runs[worker].back = static_cast<int>(static_cast<std::int64_t>(chunks) * (worker + 1) / threadCount);
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        this->function = function;
+        this->context = context;
+        this->count = count;
+        this->grain = grain;
+        busy = threadCount - 1;
+        job++;
+    }
+    wake.notify_all();
+
+    work(0);
+
+    std::unique_lock<std::mutex> lock(mutex);
+    done.wait(lock, [this] { return busy == 0; });
+}
+
+void WorkStealingPool::work(unsigned worker) {
+    int chunk;
+    while (takeChunk(worker, chunk)) {
+        const int begin = chunk * grain;
+        function(context, begin, std::min(count, begin + grain), worker);
+    }
+}
+
+bool WorkStealingPool::takeChunk(unsigned worker, int& chunk) {
+    {
+        Run& own = runs[worker];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (own.front < own.back) {
+            chunk = own.front++;
+            return true;
+        }
+    }
+    for (unsigned offset = 1; offset < threadCount; ++offset) {
+        Run& victim = runs[(worker + offset) % threadCount];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (victim.front < victim.back) {
+            chunk = --victim.back;
+            return true;
+        }
+    }
+    return false;
+}
+
+void WorkStealingPool::threadLoop(unsigned worker) {
+    std::uint64_t seen = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [this, seen] { return stopping || job != seen; });
+            if (stopping) {
+                return;
+            }
+            seen = job;
+        }
+        work(worker);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            busy--;
+        }
+        done.notify_one();
+    }
+}
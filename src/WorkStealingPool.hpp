@@ -0,0 +1,76 @@
+#ifndef WORKSTEALINGPOOL_HPP
+#define WORKSTEALINGPOOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fork-join pool for data-parallel loops over the update thread's data.
+// parallelFor splits [0, count) into chunks and deals each worker a
+// contiguous run of them; a worker takes chunks from the front of its own
+// run and, once that is empty, steals from the back of another's. The
+// calling thread works as worker 0 and the call returns when every chunk is
+// done. Which worker runs a chunk varies from run to run, so bodies that
+// need a deterministic result must not depend on it (see UnitManager).
+class WorkStealingPool {
+public:
+    // 0 threads picks one less than the hardware threads (at most seven);
+    // with 1 every loop runs inline on the caller
+    explicit WorkStealingPool(unsigned threadCount = 0);
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    // Workers including the caller; bodies get a worker id below this
+    unsigned getThreadCount() const;
+
+    // Calls body(begin, end, worker) for chunks of at most grain indices
+    template <typename Body>
+    void parallelFor(int count, int grain, Body& body) {
+        run(count, grain, &invoke<Body>, &body);
+    }
+
+private:
+    typedef void (*ChunkFunction)(void* context, int begin, int end, unsigned worker);
+
+    // Chunks [front, back) still to run from one worker's share
+    struct Run {
+        std::mutex mutex;
+        int front = 0;
+        int back = 0;
+    };
+
+    std::vector<std::thread> threads;
+    std::unique_ptr<Run[]> runs;
+    unsigned threadCount;
+
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable done;
+    std::uint64_t job; // Bumped for every parallelFor
+    unsigned busy;     // Threads still inside the current job
+    bool stopping;
+
+    // The current job, written before job is bumped
+    ChunkFunction function;
+    void* context;
+    int count;
+    int grain;
+
+    template <typename Body>
+    static void invoke(void* context, int begin, int end, unsigned worker) {
+        (*static_cast<Body*>(context))(begin, end, worker);
+    }
+
+    void run(int count, int grain, ChunkFunction function, void* context);
+    void work(unsigned worker);
+    bool takeChunk(unsigned worker, int& chunk);
+    void threadLoop(unsigned worker);
+};
+
+#endif // WORKSTEALINGPOOL_HPP
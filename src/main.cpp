@@ -4,20 +4,83 @@
 #include "IsometricUtils.hpp"
 #include "TextureManager.hpp" // **(1) Include the TextureManager header**
 #include "GameState.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
 #include <iostream>
+#include <string>
+
+bool townHallFell(int tanksAtTownHall, int skeletonsAtTownHall) {
+    return tanksAtTownHall >= 1 || skeletonsAtTownHall >= 10;
+}
 
 void checkGameEndCondition(sf::RenderWindow& window, int tanksAtTownHall, int skeletonsAtTownHall) {
-    if (tanksAtTownHall >= 1 || skeletonsAtTownHall >= 10) {
+    if (townHallFell(tanksAtTownHall, skeletonsAtTownHall)) {
         window.close();
         std::cout << "Game Over! " << (tanksAtTownHall >= 3 ? "3 Tanks" : "10 Skeletons") << " reached the town hall." << std::endl;
     }
 }
 
-int main() {
+// Headless batch evaluation of a saved layout: runs waves against it with
+// no window, fast-forwarding between events, and reports how each went.
+// Each wave starts from the saved map and ends once the town hall falls,
+// nothing is left to happen, or maxSeconds of game time have passed.
+int runBatch(const std::string& mapFile, int waves, float maxSeconds, const sf::Vector2u& windowSize) {
+    const float FRAME = 1.0f / 60.0f;
+    int held = 0;
+    float totalSimulated = 0.0f;
+    const auto batchStart = std::chrono::steady_clock::now();
+    for (int wave = 1; wave <= waves; ++wave) {
+        tanksAtTownHall = 0;
+        skeletonsAtTownHall = 0;
+        MapScreen mapScreen(30, 30, windowSize);
+        mapScreen.loadMap(mapFile);
+        mapScreen.setFastForward(true);
+        mapScreen.startWave();
+        const auto waveStart = std::chrono::steady_clock::now();
+        int frames = 0;
+        float simulated = 0.0f;
+        while (simulated < maxSeconds && !townHallFell(tanksAtTownHall, skeletonsAtTownHall) && !mapScreen.isSettled()) {
+            mapScreen.update(FRAME);
+            ++frames;
+            simulated = static_cast<float>(frames) * FRAME + mapScreen.getFastForwardSkipped();
+        }
+        const std::chrono::duration<float, std::milli> elapsed = std::chrono::steady_clock::now() - waveStart;
+        const bool fell = townHallFell(tanksAtTownHall, skeletonsAtTownHall);
+        held += fell ? 0 : 1;
+        totalSimulated += simulated;
+        std::cout << "Wave " << wave << ": " << (fell ? "fell" : "held") << ", " << tanksAtTownHall << " tanks and "
+                  << skeletonsAtTownHall << " skeletons reached the town hall, " << simulated << " s simulated ("
+                  << mapScreen.getFastForwardSkipped() << " s skipped) in " << elapsed.count() << " ms\n";
+    }
+    const std::chrono::duration<float> elapsed = std::chrono::steady_clock::now() - batchStart;
+    std::cout << "Held " << held << " of " << waves << " waves; " << totalSimulated << " s simulated in "
+              << elapsed.count() << " s (" << totalSimulated / std::max(elapsed.count(), 1e-6f) << "x real time)\n";
+    return 0;
+}
+
+int main(int argc, char** argv) {
     const int WINDOW_WIDTH = 1280;
     const int WINDOW_HEIGHT = 720;
-    sf::RenderWindow window(sf::VideoMode(WINDOW_WIDTH, WINDOW_HEIGHT), "Stronghold Reckoning");
-    window.setFramerateLimit(60);
+
+    // --batch MAP [--waves N] [--max-seconds S] evaluates a saved layout headless
+    std::string batchMap;
+    int batchWaves = 10;
+    float batchMaxSeconds = 600.0f;
+    for (int i = 1; i < argc; ++i) {
+        const std::string option = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (option == "--batch" && hasValue) {
+            batchMap = argv[++i];
+        } else if (option == "--waves" && hasValue) {
+            batchWaves = std::atoi(argv[++i]);
+        } else if (option == "--max-seconds" && hasValue) {
+            batchMaxSeconds = static_cast<float>(std::atof(argv[++i]));
+        } else {
+            std::cerr << "usage: prog [--batch MAP [--waves N] [--max-seconds S]]" << std::endl;
+            return 1;
+        }
+    }
 
     // **(2) Load the sprite sheet before initializing MapScreen**
     TextureManager& tm = TextureManager::getInstance();
@@ -27,6 +90,13 @@ int main() {
         return -1; // **Exit if loading fails to prevent further errors**
     }
     std::cout << "Sprite sheet loaded successfully from: " << spriteSheetPath << std::endl;
+
+    if (!batchMap.empty()) {
+        return runBatch(batchMap, batchWaves, batchMaxSeconds, sf::Vector2u(WINDOW_WIDTH, WINDOW_HEIGHT));
+    }
+
+    sf::RenderWindow window(sf::VideoMode(WINDOW_WIDTH, WINDOW_HEIGHT), "Stronghold Reckoning");
+    window.setFramerateLimit(60);
     
     // Initialize MapScreen with desired dimensions
     // For example, a 30x30 map